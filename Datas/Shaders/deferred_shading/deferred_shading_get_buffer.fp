@@ -6,10 +6,16 @@ in VertexData {
 	vec2 inter_texCoord;
 } VertexIn;
 
-uniform vec4 diffuse_color;
+// one block per material, bound by range for each draw (MaterialBuffer::Block)
+layout (std140) uniform material_block
+{
+	vec4 diffuse_color;
+	vec4 specular_color;
+	float shininess_ratio;
+	float scaleUvs;
+};
+
 uniform sampler2D diffuse_map;
-uniform vec4 specular_color;
-uniform float shininess_ratio;
 uniform sampler2D normal_map;
 
 layout (location = 0) out vec4 diffuse_frag;
@@ -15,7 +15,7 @@ namespace AGE
 			assert(collisionShape != nullptr && "Invalid collision shape");
 			if (getData()->data == nullptr)
 			{
-				getData()->data = new btRigidBody(static_cast<btScalar>(1.0f), new btDefaultMotionState(), nullptr);
+				getData()->data = new btRigidBody(static_cast<btScalar>(1.0f), new BulletMotionState(static_cast<BulletWorld *>(world), getData()), nullptr);
 				assert(getData()->data != nullptr && "Impossible to create actor");
 				btRigidBody *body = getDataAs<btRigidBody>();
 				body->setCollisionShape(&BulletRigidBody::EmptyShape);
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "BulletRaycaster.hpp"
 #include "BulletWorld.hpp"
 
@@ -5,6 +7,152 @@ namespace AGE
 {
 	namespace Physics
 	{
+		namespace
+		{
+			// Objects found by an overlap, the contact points of an object already found are skipped
+			const std::size_t MaxOverlaps = 32;
+
+			bool WriteHit(const btCollisionObject *object, const btVector3 &point, const btVector3 &normal, float distance, RaycastHit &result)
+			{
+				// the user pointer is the collider of the bodies that have a shape
+				BulletCollider *collider = static_cast<BulletCollider *>(object->getUserPointer());
+				if (collider == nullptr)
+				{
+					return false;
+				}
+				result.hitEntity = static_cast<ColliderInterface *>(collider)->getData()->entity;
+				result.distanceFromRayOrigin = distance;
+				result.impactNormal = glm::vec3(normal.x(), normal.y(), normal.z());
+				result.impactPoint = glm::vec3(point.x(), point.y(), point.z());
+				return true;
+			}
+
+			// The hits are written in the caller buffer, nothing is allocated
+			struct BufferRayResultCallback final : public btCollisionWorld::RayResultCallback
+			{
+				// Constructors
+				BufferRayResultCallback(const btVector3 &rayFrom, const btVector3 &rayTo, RaycastHit *hits, std::size_t maxHits)
+					: rayFrom(rayFrom), rayTo(rayTo), hits(hits), maxHits(maxHits)
+				{
+					return;
+				}
+
+				// Inherited Methods
+				btScalar addSingleResult(btCollisionWorld::LocalRayResult &rayResult, bool normalInWorldSpace) override final
+				{
+					m_collisionObject = rayResult.m_collisionObject;
+					if (numberOfHits < maxHits)
+					{
+						const btVector3 normal = normalInWorldSpace ? rayResult.m_hitNormalLocal : m_collisionObject->getWorldTransform().getBasis() * rayResult.m_hitNormalLocal;
+						btVector3 point;
+						point.setInterpolate3(rayFrom, rayTo, rayResult.m_hitFraction);
+						if (WriteHit(m_collisionObject, point, normal, static_cast<float>(rayFrom.distance(point)), hits[numberOfHits]))
+						{
+							++numberOfHits;
+						}
+					}
+					// keeps m_closestHitFraction to get all the hits
+					return m_closestHitFraction;
+				}
+
+				// Attributes
+				btVector3 rayFrom;
+
+				btVector3 rayTo;
+
+				RaycastHit *hits;
+
+				std::size_t maxHits;
+
+				std::size_t numberOfHits = 0;
+			};
+
+			struct BufferConvexResultCallback final : public btCollisionWorld::ConvexResultCallback
+			{
+				// Constructors
+				BufferConvexResultCallback(const btVector3 &sweepFrom, const btVector3 &sweepTo, RaycastHit *hits, std::size_t maxHits)
+					: sweepFrom(sweepFrom), sweepTo(sweepTo), hits(hits), maxHits(maxHits)
+				{
+					return;
+				}
+
+				// Inherited Methods
+				btScalar addSingleResult(btCollisionWorld::LocalConvexResult &convexResult, bool normalInWorldSpace) override final
+				{
+					if (numberOfHits < maxHits)
+					{
+						const btCollisionObject *object = convexResult.m_hitCollisionObject;
+						const btVector3 normal = normalInWorldSpace ? convexResult.m_hitNormalLocal : object->getWorldTransform().getBasis() * convexResult.m_hitNormalLocal;
+						const float distance = static_cast<float>(sweepFrom.distance(sweepTo) * convexResult.m_hitFraction);
+						if (WriteHit(object, convexResult.m_hitPointLocal, normal, distance, hits[numberOfHits]))
+						{
+							++numberOfHits;
+						}
+					}
+					return m_closestHitFraction;
+				}
+
+				// Attributes
+				btVector3 sweepFrom;
+
+				btVector3 sweepTo;
+
+				RaycastHit *hits;
+
+				std::size_t maxHits;
+
+				std::size_t numberOfHits = 0;
+			};
+
+			struct BufferContactResultCallback final : public btCollisionWorld::ContactResultCallback
+			{
+				// Constructors
+				BufferContactResultCallback(const btCollisionObject *testedObject, const glm::vec3 &origin, RaycastHit *hits, std::size_t maxHits)
+					: testedObject(testedObject), origin(origin), hits(hits), maxHits(maxHits)
+				{
+					return;
+				}
+
+				// Inherited Methods
+				btScalar addSingleResult(btManifoldPoint &contactPoint, const btCollisionObjectWrapper *firstObject, int firstPartId, int firstIndex,
+										 const btCollisionObjectWrapper *secondObject, int secondPartId, int secondIndex) override final
+				{
+					const btCollisionObject *object = firstObject->getCollisionObject() == testedObject ? secondObject->getCollisionObject() : firstObject->getCollisionObject();
+					if (numberOfHits == maxHits || std::find(objects, objects + numberOfHits, object) != objects + numberOfHits)
+					{
+						return 0.0f;
+					}
+					if (WriteHit(object, btVector3(origin.x, origin.y, origin.z), btVector3(0.0f, 0.0f, 0.0f), 0.0f, hits[numberOfHits]))
+					{
+						objects[numberOfHits] = object;
+						++numberOfHits;
+					}
+					return 0.0f;
+				}
+
+				// Attributes
+				const btCollisionObject *testedObject;
+
+				glm::vec3 origin;
+
+				RaycastHit *hits;
+
+				std::size_t maxHits;
+
+				std::size_t numberOfHits = 0;
+
+				const btCollisionObject *objects[MaxOverlaps];
+			};
+
+			void SortHits(RaycastHit *hits, std::size_t numberOfHits)
+			{
+				std::sort(hits, hits + numberOfHits, [](const RaycastHit &lhs, const RaycastHit &rhs)
+				{
+					return lhs.distanceFromRayOrigin < rhs.distanceFromRayOrigin;
+				});
+			}
+		}
+
 		// Constructors
 		BulletRaycaster::BulletRaycaster(WorldInterface *world)
 			: RaycasterInterface(world)
@@ -52,5 +200,95 @@ namespace AGE
 			}
 			return std::move(results);
 		}
+	
+		std::size_t BulletRaycaster::query(const PhysicsQuery &query, RaycastHit *hits)
+		{
+			if (query.maxHits == 0)
+			{
+				return 0;
+			}
+			assert((query.type == QueryType::Raycast || query.radius > 0.0f) && "Invalid radius");
+			const btCollisionWorld *world = static_cast<BulletWorld *>(getWorld())->getWorld();
+			const btVector3 origin(query.origin.x, query.origin.y, query.origin.z);
+			const glm::vec3 normalizedDirection = query.type == QueryType::Overlap ? query.direction : glm::normalize(query.direction);
+			const btVector3 end(origin + query.distance * btVector3(normalizedDirection.x, normalizedDirection.y, normalizedDirection.z));
+			const short filterGroup = static_cast<short>(query.layers);
+			switch (query.type)
+			{
+				case QueryType::Raycast:
+				{
+					if (query.maxHits == 1)
+					{
+						btCollisionWorld::ClosestRayResultCallback rayCallback(origin, end);
+						rayCallback.m_collisionFilterGroup = filterGroup;
+						rayCallback.m_collisionFilterMask = static_cast<short>(-1);
+						world->rayTest(origin, end, rayCallback);
+						if (!rayCallback.hasHit())
+						{
+							return 0;
+						}
+						return WriteHit(rayCallback.m_collisionObject, rayCallback.m_hitPointWorld, rayCallback.m_hitNormalWorld, static_cast<float>(origin.distance(rayCallback.m_hitPointWorld)), *hits) ? 1 : 0;
+					}
+					BufferRayResultCallback rayCallback(origin, end, hits, query.maxHits);
+					rayCallback.m_collisionFilterGroup = filterGroup;
+					rayCallback.m_collisionFilterMask = static_cast<short>(-1);
+					world->rayTest(origin, end, rayCallback);
+					SortHits(hits, rayCallback.numberOfHits);
+					return rayCallback.numberOfHits;
+				}
+				case QueryType::Sweep:
+				{
+					btSphereShape sphere(query.radius);
+					btTransform from;
+					from.setIdentity();
+					from.setOrigin(origin);
+					btTransform to;
+					to.setIdentity();
+					to.setOrigin(end);
+					if (query.maxHits == 1)
+					{
+						btCollisionWorld::ClosestConvexResultCallback sweepCallback(origin, end);
+						sweepCallback.m_collisionFilterGroup = filterGroup;
+						sweepCallback.m_collisionFilterMask = static_cast<short>(-1);
+						world->convexSweepTest(&sphere, from, to, sweepCallback);
+						if (!sweepCallback.hasHit())
+						{
+							return 0;
+						}
+						const float distance = static_cast<float>(origin.distance(end) * sweepCallback.m_closestHitFraction);
+						return WriteHit(sweepCallback.m_hitCollisionObject, sweepCallback.m_hitPointWorld, sweepCallback.m_hitNormalWorld, distance, *hits) ? 1 : 0;
+					}
+					BufferConvexResultCallback sweepCallback(origin, end, hits, query.maxHits);
+					sweepCallback.m_collisionFilterGroup = filterGroup;
+					sweepCallback.m_collisionFilterMask = static_cast<short>(-1);
+					world->convexSweepTest(&sphere, from, to, sweepCallback);
+					SortHits(hits, sweepCallback.numberOfHits);
+					return sweepCallback.numberOfHits;
+				}
+				case QueryType::Overlap:
+				{
+					btSphereShape sphere(query.radius);
+					btCollisionObject testedObject;
+					testedObject.setCollisionShape(&sphere);
+					testedObject.getWorldTransform().setOrigin(origin);
+					BufferContactResultCallback contactCallback(&testedObject, query.origin, hits, std::min(query.maxHits, MaxOverlaps));
+					contactCallback.m_collisionFilterGroup = filterGroup;
+					contactCallback.m_collisionFilterMask = static_cast<short>(-1);
+					// contactTest is not const, queries of this backend never run concurrently
+					const_cast<btCollisionWorld *>(world)->contactTest(&testedObject, contactCallback);
+					return contactCallback.numberOfHits;
+				}
+				default:
+					assert(!"Invalid query type");
+					return 0;
+			}
+		}
+
+		bool BulletRaycaster::supportsParallelQueries(void) const
+		{
+			// rayTest, convexSweepTest and contactTest use the broadphase ray test stack
+			// and the dispatcher pool allocator of the world, they are not reentrant
+			return false;
+		}
 	}
 }
\ No newline at end of file
@@ -15,7 +15,7 @@ namespace AGE
 		{
 			if (getData()->data == nullptr)
 			{
-				getData()->data = new btRigidBody(static_cast<btScalar>(0.0f), new btDefaultMotionState(), nullptr);
+				getData()->data = new btRigidBody(static_cast<btScalar>(0.0f), new BulletMotionState(world, getData()), nullptr);
 				assert(getData()->data != nullptr && "Impossible to create actor");
 				btRigidBody *body = getDataAs<btRigidBody>();
 				body->setCollisionShape(&BulletRigidBody::EmptyShape);
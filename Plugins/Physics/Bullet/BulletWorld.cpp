@@ -19,6 +19,20 @@ namespace AGE
 {
 	namespace Physics
 	{
+		// Constructors
+		BulletMotionState::BulletMotionState(BulletWorld *world, Private::GenericData *data)
+			: world(world), data(data)
+		{
+			return;
+		}
+
+		// Inherited Methods
+		void BulletMotionState::setWorldTransform(const btTransform &centerOfMassWorldTrans)
+		{
+			btDefaultMotionState::setWorldTransform(centerOfMassWorldTrans);
+			world->addActiveBody(data);
+		}
+
 		// Constructors
 		BulletWorld::BulletWorld(BulletPhysics *physics)
 			: WorldInterface(physics)
@@ -240,6 +254,11 @@ namespace AGE
 			updateTriggers();
 		}
 
+		bool BulletWorld::reportsActiveBodies(void) const
+		{
+			return true;
+		}
+
 		RaycasterInterface *BulletWorld::createRaycaster(void)
 		{
 			return new BulletRaycaster(this);
@@ -18,8 +18,37 @@ namespace AGE
 {
 	namespace Physics
 	{
+		class BulletWorld;
+
+		// Bullet only synchronizes the motion states of the active bodies, they are reported to the world
+		class BulletMotionState final : public btDefaultMotionState
+		{
+		public:
+			// Constructors
+			BulletMotionState(void) = delete;
+
+			BulletMotionState(BulletWorld *world, Private::GenericData *data);
+
+			BulletMotionState(const BulletMotionState &) = delete;
+
+			// Assignment Operators
+			BulletMotionState &operator=(const BulletMotionState &) = delete;
+
+			// Inherited Methods
+			void setWorldTransform(const btTransform &centerOfMassWorldTrans) override final;
+
+		private:
+			// Attributes
+			BulletWorld *world = nullptr;
+
+			Private::GenericData *data = nullptr;
+		};
+
 		class BulletWorld final : public WorldInterface, public btOverlapFilterCallback, public MemoryPoolHelper<BulletRigidBody, BulletMaterial, BulletBoxCollider, BulletCapsuleCollider, BulletMeshCollider, BulletSphereCollider>
 		{
+			// Friendships
+			friend BulletMotionState;
+
 		public:
 			// Constructors
 			BulletWorld(void) = delete;
@@ -87,6 +116,8 @@ namespace AGE
 
 			void simulate(float stepSize) override final;
 
+			bool reportsActiveBodies(void) const override final;
+
 			RaycasterInterface *createRaycaster(void) override final;
 
 			RigidBodyInterface *createRigidBody(Private::GenericData *data) override final;
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "PhysXWorld.hpp"
 #include "PhysXRaycaster.hpp"
 
@@ -5,6 +7,45 @@ namespace AGE
 {
 	namespace Physics
 	{
+		namespace
+		{
+			// Touches read by a query returning several hits, kept on the stack
+			const std::size_t MaxTouches = 32;
+
+			bool WriteHit(const physx::PxActor *actor, RaycastHit &result)
+			{
+				PhysXCollider *collider = static_cast<PhysXCollider *>(actor->userData);
+				if (collider == nullptr)
+				{
+					return false;
+				}
+				result.hitEntity = static_cast<ColliderInterface *>(collider)->getData()->entity;
+				return true;
+			}
+
+			std::size_t WriteLocationHits(const physx::PxLocationHit *touches, std::size_t numberOfTouches, RaycastHit *hits)
+			{
+				std::size_t numberOfHits = 0;
+				for (std::size_t index = 0; index < numberOfTouches; ++index)
+				{
+					const physx::PxLocationHit &touch = touches[index];
+					RaycastHit &result = hits[numberOfHits];
+					if (WriteHit(touch.actor, result))
+					{
+						result.distanceFromRayOrigin = touch.distance;
+						result.impactNormal = glm::vec3(touch.normal.x, touch.normal.y, touch.normal.z);
+						result.impactPoint = glm::vec3(touch.position.x, touch.position.y, touch.position.z);
+						++numberOfHits;
+					}
+				}
+				std::sort(hits, hits + numberOfHits, [](const RaycastHit &lhs, const RaycastHit &rhs)
+				{
+					return lhs.distanceFromRayOrigin < rhs.distanceFromRayOrigin;
+				});
+				return numberOfHits;
+			}
+		}
+
 		// Constructors
 		PhysXRaycaster::PhysXRaycaster(WorldInterface *world)
 			: RaycasterInterface(world)
@@ -53,5 +94,85 @@ namespace AGE
 			}
 			return std::move(results);
 		}
+	
+		std::size_t PhysXRaycaster::query(const PhysicsQuery &query, RaycastHit *hits)
+		{
+			if (query.maxHits == 0)
+			{
+				return 0;
+			}
+			assert((query.type == QueryType::Raycast || query.radius > 0.0f) && "Invalid radius");
+			const physx::PxScene *scene = static_cast<PhysXWorld *>(getWorld())->getScene();
+			const physx::PxVec3 origin(query.origin.x, query.origin.y, query.origin.z);
+			const glm::vec3 normalizedDirection = query.type == QueryType::Overlap ? query.direction : glm::normalize(query.direction);
+			const physx::PxVec3 direction(normalizedDirection.x, normalizedDirection.y, normalizedDirection.z);
+			const physx::PxHitFlags outputFlags = physx::PxHitFlag::eDEFAULT | physx::PxHitFlag::eMESH_BOTH_SIDES;
+			const physx::PxU32 numberOfTouches = static_cast<physx::PxU32>(std::min(query.maxHits, MaxTouches));
+			const bool closestHit = query.maxHits == 1 && query.type != QueryType::Overlap;
+			physx::PxQueryFilterData filterData;
+			filterData.flags = physx::PxQueryFlag::eSTATIC | physx::PxQueryFlag::eDYNAMIC;
+			if (!closestHit)
+			{
+				// all the hits are touches, there is no blocking hit
+				filterData.flags |= physx::PxQueryFlag::eNO_BLOCK;
+			}
+			filterData.data.word0 = static_cast<physx::PxU32>(query.layers);
+			const physx::PxSphereGeometry sphere(query.radius);
+			const physx::PxTransform pose(origin);
+			switch (query.type)
+			{
+				case QueryType::Raycast:
+				{
+					physx::PxRaycastHit touches[MaxTouches];
+					physx::PxRaycastBuffer buffer(closestHit ? nullptr : touches, closestHit ? 0 : numberOfTouches);
+					if (!scene->raycast(origin, direction, query.distance, buffer, outputFlags, filterData))
+					{
+						return 0;
+					}
+					return closestHit ? WriteLocationHits(&buffer.block, 1, hits) : WriteLocationHits(buffer.touches, buffer.nbTouches, hits);
+				}
+				case QueryType::Sweep:
+				{
+					physx::PxSweepHit touches[MaxTouches];
+					physx::PxSweepBuffer buffer(closestHit ? nullptr : touches, closestHit ? 0 : numberOfTouches);
+					if (!scene->sweep(sphere, pose, direction, query.distance, buffer, outputFlags, filterData))
+					{
+						return 0;
+					}
+					return closestHit ? WriteLocationHits(&buffer.block, 1, hits) : WriteLocationHits(buffer.touches, buffer.nbTouches, hits);
+				}
+				case QueryType::Overlap:
+				{
+					physx::PxOverlapHit touches[MaxTouches];
+					physx::PxOverlapBuffer buffer(touches, numberOfTouches);
+					if (!scene->overlap(sphere, pose, buffer, filterData))
+					{
+						return 0;
+					}
+					std::size_t numberOfHits = 0;
+					for (physx::PxU32 index = 0; index < buffer.nbTouches; ++index)
+					{
+						RaycastHit &result = hits[numberOfHits];
+						if (WriteHit(buffer.touches[index].actor, result))
+						{
+							result.distanceFromRayOrigin = 0.0f;
+							result.impactNormal = glm::vec3(0.0f);
+							result.impactPoint = query.origin;
+							++numberOfHits;
+						}
+					}
+					return numberOfHits;
+				}
+				default:
+					assert(!"Invalid query type");
+					return 0;
+			}
+		}
+
+		bool PhysXRaycaster::supportsParallelQueries(void) const
+		{
+			// scene queries only read the scene, PhysX allows them from several threads
+			return true;
+		}
 	}
 }
\ No newline at end of file
@@ -58,12 +58,27 @@ namespace AGE
 			return index;
 		}
 
+		Private::GenericData *PhysXWorld::GetActorData(const physx::PxActor *actor, void *userData)
+		{
+			const physx::PxRigidDynamic *body = actor->isRigidDynamic();
+			if (body == nullptr || userData == nullptr)
+			{
+				return nullptr;
+			}
+			// The user data is the collider if the actor has one, the rigid body otherwise (colliders always attach shapes)
+			if (body->getNbShapes() == 0)
+			{
+				return static_cast<RigidBodyInterface *>(static_cast<PhysXRigidBody *>(userData))->getData();
+			}
+			return static_cast<ColliderInterface *>(static_cast<PhysXCollider *>(userData))->getData();
+		}
+
 		// Constructors
 		PhysXWorld::PhysXWorld(PhysXPhysics *physics)
 			: WorldInterface(physics)
 		{
 			physx::PxSceneDesc sceneDescription(physics->getPhysics()->getTolerancesScale());
-			sceneDescription.flags |= physx::PxSceneFlag::eENABLE_CCD | physx::PxSceneFlag::eENABLE_KINEMATIC_PAIRS | physx::PxSceneFlag::eENABLE_KINEMATIC_STATIC_PAIRS;
+			sceneDescription.flags |= physx::PxSceneFlag::eENABLE_CCD | physx::PxSceneFlag::eENABLE_KINEMATIC_PAIRS | physx::PxSceneFlag::eENABLE_KINEMATIC_STATIC_PAIRS | physx::PxSceneFlag::eENABLE_ACTIVETRANSFORMS;
 			sceneDescription.broadPhaseType = physx::PxBroadPhaseType::eSAP;
 			sceneDescription.frictionType = physx::PxFrictionType::eTWO_DIRECTIONAL;
 			sceneDescription.gravity = physx::PxVec3(GetDefaultGravity().x, GetDefaultGravity().y, GetDefaultGravity().z);
@@ -185,6 +200,21 @@ namespace AGE
 			return getCollisionShapes(mesh, isConvex);
 		}
 
+		void PhysXWorld::collectActiveBodies(void)
+		{
+			// Only valid until the next simulate, the sleeping actors are not in it
+			physx::PxU32 numberOfActiveTransforms = 0;
+			const physx::PxActiveTransform *activeTransforms = scene->getActiveTransforms(numberOfActiveTransforms);
+			for (physx::PxU32 index = 0; index < numberOfActiveTransforms; ++index)
+			{
+				Private::GenericData *data = PhysXWorld::GetActorData(activeTransforms[index].actor, activeTransforms[index].userData);
+				if (data != nullptr)
+				{
+					addActiveBody(data);
+				}
+			}
+		}
+
 		void PhysXWorld::notifyTriggers(void)
 		{
 			TriggerListener *listener = getTriggerListener();
@@ -237,10 +267,31 @@ namespace AGE
 			{
 				scene->simulate(stepSize, nullptr, scratchMemoryBlock, sizeof(scratchMemoryBlock));
 				scene->fetchResults(true);
+				collectActiveBodies();
 				notifyTriggers();
 			}
 		}
 
+		void PhysXWorld::simulateAsync(float stepSize)
+		{
+			assert(scene != nullptr && "Invalid scene");
+			// the scene runs on the cpu dispatcher threads until fetchResults
+			scene->simulate(stepSize, nullptr, scratchMemoryBlock, sizeof(scratchMemoryBlock));
+		}
+
+		void PhysXWorld::fetchResults(void)
+		{
+			assert(scene != nullptr && "Invalid scene");
+			scene->fetchResults(true);
+			collectActiveBodies();
+			notifyTriggers();
+		}
+
+		bool PhysXWorld::reportsActiveBodies(void) const
+		{
+			return true;
+		}
+
 		void PhysXWorld::fillDebugInformation(DebugDrawManager *debugDrawManager)
 		{
 			if (isDebugEnabled())
@@ -66,12 +66,16 @@ namespace AGE
 
 			static physx::PxU32 GetIndexForFilterGroup(FilterGroup group);
 
+			static Private::GenericData *GetActorData(const physx::PxActor *actor, void *userData);
+
 			// Destructor
 			~PhysXWorld(void);
 
 			// Methods
 			void notifyTriggers(void);
 
+			void collectActiveBodies(void);
+
 			virtual void fillDebugInformation(DebugDrawManager *debugDrawManager);
 
 			// Inherited Methods
@@ -85,6 +89,12 @@ namespace AGE
 
 			void simulate(float stepSize) override final;
 
+			void simulateAsync(float stepSize) override final;
+
+			void fetchResults(void) override final;
+
+			bool reportsActiveBodies(void) const override final;
+
 			RaycasterInterface *createRaycaster(void) override final;
 
 			RigidBodyInterface *createRigidBody(Private::GenericData *data) override final;
@@ -5,6 +5,7 @@
 #include <AssetManagement/Data/AnimationData.hpp>
 #include <AssetManagement/Data/MaterialData.hh>
 #include <AssetManagement/Data/MeshData.hh>
+#include <AssetManagement/Data/MeshLod.hpp>
 #include <AssetManagement/Data/TextureData.hh>
 #include <AssetManagement/Instance/MaterialInstance.hh>
 #include <AssetManagement/Instance/MeshInstance.hh>
@@ -176,12 +177,12 @@ namespace AGE
 
 				materialSubset.specular = material_data.specular;
 
-				materialSubset.normalTex = std::static_pointer_cast<Texture2D>(loadTexture(material_data.normalTexPath, loadingChannel));
+				materialSubset.normalTex = std::static_pointer_cast<Texture2D>(loadTexture(material_data.normalTexPath, loadingChannel, true));
 
-				auto diffuseTexPtr = std::static_pointer_cast<Texture2D>(loadTexture(material_data.diffuseTexPath, loadingChannel));
+				auto diffuseTexPtr = std::static_pointer_cast<Texture2D>(loadTexture(material_data.diffuseTexPath, loadingChannel, true));
 				if (diffuseTexPtr == nullptr)
 				{
-					diffuseTexPtr = std::static_pointer_cast<Texture2D>(loadTexture("ambiant_default.dds", loadingChannel));
+					diffuseTexPtr = std::static_pointer_cast<Texture2D>(loadTexture("ambiant_default.dds", loadingChannel, true));
 				}
 				materialSubset.diffuseTex = diffuseTexPtr;
 
@@ -208,7 +209,8 @@ namespace AGE
 
 	std::shared_ptr<ITexture> AssetsManager::loadTexture(
 		const OldFile &_filePath
-		, const StringID &loadingChannel)
+		, const StringID &loadingChannel
+		, bool residency)
 	{
 		OldFile filePath(_assetsDirectory + _filePath.getFullName());
 
@@ -233,16 +235,17 @@ namespace AGE
 			_textures.insert(std::make_pair(filePath.getFullName(), textureInterface));
 		}
 
-		auto future = TMQ::TaskManager::emplaceRenderFutureTask<LoadAssetMessage, AssetsLoadingResult>([=]()
+		// the file is read and parsed by a worker, the render thread only uploads it
+		auto future = TMQ::TaskManager::emplaceSharedFutureTask<LoadAssetMessage, AssetsLoadingResult>([=]()
 		{
 			SCOPE_profile_cpu_i("AssetsLoad", "LoadTexture");
 
-			std::shared_ptr<ATexture> loaded = OpenGLDDSLoader::loadDDSFile(filePath);
-			if (loaded == nullptr)
+			std::shared_ptr<DDSImage> image = OpenGLDDSLoader::parseDDSFile(filePath);
+			if (image == nullptr)
 				return AssetsLoadingResult(true, "Could not load the texture.\n");
-			if (loaded->type() != GL_TEXTURE_2D)
+			if (image->isCubeMap)
 				return AssetsLoadingResult(true, "Texture is not of the right type.\n");
-			*texture = *std::static_pointer_cast<Texture2D>(loaded);
+			TMQ::TaskManager::emplaceRenderTask<Tasks::StreamTexture>(texture, image, residency ? filePath.getFullName() : std::string());
 			return AssetsLoadingResult(true);
 		});
 		pushNewAsset(loadingChannel, _filePath.getFullName(), future);
@@ -267,14 +270,16 @@ namespace AGE
 			_cubeMaps.insert(std::make_pair(name, texture));
 		}
 
-		auto future = TMQ::TaskManager::emplaceRenderFutureTask<LoadAssetMessage, AssetsLoadingResult>([=]()
+		auto future = TMQ::TaskManager::emplaceSharedFutureTask<LoadAssetMessage, AssetsLoadingResult>([=]()
 		{
-			std::shared_ptr<ATexture> loaded = OpenGLDDSLoader::loadDDSFile(filePath);
-			if (loaded == nullptr)
+			SCOPE_profile_cpu_i("AssetsLoad", "LoadCubeMap");
+
+			std::shared_ptr<DDSImage> image = OpenGLDDSLoader::parseDDSFile(filePath);
+			if (image == nullptr)
 				return AssetsLoadingResult(true, "Could not load the texture.\n");
-			if (loaded->type() != GL_TEXTURE_CUBE_MAP)
+			if (image->isCubeMap == false)
 				return AssetsLoadingResult(true, "Texture is not of the right type.\n");
-			*texture = *std::static_pointer_cast<TextureCubeMap>(loaded);
+			TMQ::TaskManager::emplaceRenderTask<Tasks::StreamTexture>(texture, image);
 			return AssetsLoadingResult(true);
 		});
 		pushNewAsset(loadingChannel, filePath.getFullName(), future);
@@ -308,6 +313,16 @@ namespace AGE
 			std::ifstream ifs(filePath.getFullName(), std::ios::binary);
 			cereal::PortableBinaryInputArchive ar(ifs);
 			ar(*animation.get());
+			if (AnimationConfig::g_compression_is_enabled)
+			{
+				SCOPE_profile_cpu_i("AssetsLoad", "CompressAnimation");
+				animation->compress(AnimationConfig::g_compression_settings);
+			}
+			if (AnimationConfig::g_bake_sample_rate > 0.0f)
+			{
+				SCOPE_profile_cpu_i("AssetsLoad", "BakeAnimation");
+				animation->bake(AnimationConfig::g_bake_sample_rate);
+			}
 			callback.increment();
 			return AssetsLoadingResult(false);
 		});
@@ -354,6 +369,7 @@ namespace AGE
 			std::ifstream ifs(filePath.getFullName(), std::ios::binary);
 			cereal::PortableBinaryInputArchive ar(ifs);
 			ar(*skeleton.get());
+			skeleton->bake();
 			callback.increment();
 			return true;
 		});
@@ -436,6 +452,12 @@ namespace AGE
 		auto maxSize = data.positions.size();
 		mesh->boundingBox = data.boundingBox;
 		mesh->defaultMaterialIndex = data.defaultMaterialIndex;
+		// lods vertices are compacted here, the render thread only upload them
+		auto lods = std::make_shared<std::vector<SubMeshData>>(data.lods.size());
+		for (std::size_t i = 0; i < data.lods.size(); ++i)
+		{
+			ExtractMeshLod(data, i, (*lods)[i]);
+		}
 		auto future = TMQ::TaskManager::emplaceRenderFutureTask<LoadAssetMessage, AssetsLoadingResult>([=]() mutable {
 			SCOPE_profile_cpu_i("AssetsLoad", "LoadSubMesh");
 
@@ -457,17 +479,27 @@ namespace AGE
 				mesh->painter = paintingManager->get_painter(types);
 			}
 			auto &painter = paintingManager->get_painter(mesh->painter);
-			mesh->vertices = painter->add_vertices(data.positions.size(), data.indices.size());
-			auto vertices = painter->get_vertices(mesh->vertices);
-			mesh->isSkinned = data.infos.test(MeshInfos::BoneIndices);
-			for (auto i = 0ull; i < data.infos.size(); ++i)
+			auto addVertices = [&](const SubMeshData &source) -> Key<Vertices>
 			{
-				if (data.infos.test(i))
+				auto key = painter->add_vertices(source.positions.size(), source.indices.size());
+				auto vertices = painter->get_vertices(key);
+				for (auto i = 0ull; i < source.infos.size(); ++i)
 				{
-					g_InfosTypes[i].second(*vertices, i, data);
+					if (source.infos.test(i))
+					{
+						g_InfosTypes[i].second(*vertices, i, source);
+					}
 				}
+				vertices->set_indices(source.indices);
+				return key;
+			};
+			mesh->vertices = addVertices(data);
+			mesh->isSkinned = data.infos.test(MeshInfos::BoneIndices);
+			mesh->lods.clear();
+			for (auto &lod : *lods)
+			{
+				mesh->lods.push_back(addVertices(lod));
 			}
-			vertices->set_indices(data.indices);
 			callback.increment();
 			return AssetsLoadingResult(false);
 		});
@@ -127,7 +127,8 @@ namespace AGE
 		bool loadMaterial(const OldFile &filePath, const StringID &loadingChannel = StringID("Default", 0x11326fd2590f4e5e));
 		std::shared_ptr<MaterialSetInstance> getMaterial(const OldFile &filePath);
 		std::shared_ptr<MeshInstance> getMesh(const OldFile &filePath);
-		std::shared_ptr<ITexture> loadTexture(const OldFile &filepath, const StringID &loadingChannel);
+		// residency: the levels loaded follow the screen size the culling reports for it (material diffuse and normal maps)
+		std::shared_ptr<ITexture> loadTexture(const OldFile &filepath, const StringID &loadingChannel, bool residency = false);
 		std::shared_ptr<TextureCubeMap> loadCubeMap(std::string const &name, OldFile &_filePath, const StringID &loadingChannel);
 		bool loadMesh(const OldFile &filePath, const StringID &loadingChannel = StringID("Default", 0x11326fd2590f4e5e));
 		void setAssetsDirectory(const std::string &path) { _assetsDirectory = path; }
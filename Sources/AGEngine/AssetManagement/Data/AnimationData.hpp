@@ -14,6 +14,22 @@ namespace AGE
 		AGE::Vector<AnimationChannel> channels;
 		float duration;
 		std::uint32_t id;
+
+		void compress(const AnimationCompressionSettings &settings)
+		{
+			for (auto &channel : channels)
+			{
+				channel.compress(settings);
+			}
+		}
+
+		void bake(float sampleRate)
+		{
+			for (auto &channel : channels)
+			{
+				channel.bake(duration, sampleRate);
+			}
+		}
 	};
 
 	template <class Archive>
@@ -42,6 +42,9 @@ namespace AGE
 		std::vector<glm::vec4> colors;
 		AGE::AABoundingBox boundingBox;
 		uint16_t defaultMaterialIndex;
+		// simplified index buffers, from the most to the least detailed
+		// they index the full detail vertices, see MeshLod.hpp
+		std::vector<std::vector<std::uint32_t>> lods;
 
 	public:
 		template <class Archive> void serialize(Archive &ar, const std::uint32_t version);
@@ -62,6 +65,10 @@ namespace AGE
 	void SubMeshData::serialize(Archive &ar, const std::uint32_t version)
 	{
 		ar(name, infos, positions, normals, tangents, biTangents, uvs, indices, weights, boneIndices, colors, boundingBox, defaultMaterialIndex);
+		if (version > 0)
+		{
+			ar(lods);
+		}
 	}
 
 	template <class Archive>
@@ -76,4 +83,4 @@ namespace AGE
 }
 
 CEREAL_CLASS_VERSION(AGE::MeshData, 1)
-CEREAL_CLASS_VERSION(AGE::SubMeshData, 0)
\ No newline at end of file
+CEREAL_CLASS_VERSION(AGE::SubMeshData, 1)
\ No newline at end of file
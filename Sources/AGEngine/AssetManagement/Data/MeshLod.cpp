@@ -0,0 +1,162 @@
+#include "MeshLod.hpp"
+#include "MeshData.hh"
+
+#include <Utils/Debug.hpp>
+
+#include <unordered_map>
+#include <limits>
+
+namespace AGE
+{
+	namespace
+	{
+		struct LodCell
+		{
+			glm::vec3 sum = glm::vec3(0);
+			std::uint32_t count = 0;
+			std::uint32_t representative = 0;
+			float distance = std::numeric_limits<float>::max();
+		};
+
+		inline std::uint64_t LodCellKey(const glm::vec3 &position, const glm::vec3 &origin, float cellSize)
+		{
+			glm::uvec3 cell = glm::uvec3(glm::max((position - origin) / cellSize, glm::vec3(0)));
+			return (std::uint64_t(cell.x & 0x1FFFFF) << 42) | (std::uint64_t(cell.y & 0x1FFFFF) << 21) | std::uint64_t(cell.z & 0x1FFFFF);
+		}
+
+		template <typename T>
+		void CompactAttribute(const std::vector<T> &from, const std::vector<std::uint32_t> &used, std::vector<T> &to)
+		{
+			if (from.empty())
+			{
+				return;
+			}
+			to.resize(used.size());
+			for (std::size_t i = 0; i < used.size(); ++i)
+			{
+				to[i] = from[used[i]];
+			}
+		}
+
+		void ClusterVertices(const SubMeshData &data, float cellSize, const std::vector<std::uint32_t> &indices, std::vector<std::uint32_t> &result)
+		{
+			const glm::vec3 &origin = data.boundingBox.minPoint;
+			std::unordered_map<std::uint64_t, LodCell> cells;
+			std::vector<std::uint64_t> keys(data.positions.size());
+
+			for (std::size_t i = 0; i < data.positions.size(); ++i)
+			{
+				keys[i] = LodCellKey(data.positions[i], origin, cellSize);
+				auto &cell = cells[keys[i]];
+				cell.sum += data.positions[i];
+				++cell.count;
+			}
+
+			// the representative is the vertex the closest to the cell average
+			for (std::size_t i = 0; i < data.positions.size(); ++i)
+			{
+				auto &cell = cells[keys[i]];
+				glm::vec3 delta = data.positions[i] - cell.sum / float(cell.count);
+				float distance = glm::dot(delta, delta);
+				if (distance < cell.distance)
+				{
+					cell.distance = distance;
+					cell.representative = std::uint32_t(i);
+				}
+			}
+
+			result.clear();
+			result.reserve(indices.size());
+			for (std::size_t i = 0; i + 2 < indices.size(); i += 3)
+			{
+				std::uint32_t a = cells[keys[indices[i]]].representative;
+				std::uint32_t b = cells[keys[indices[i + 1]]].representative;
+				std::uint32_t c = cells[keys[indices[i + 2]]].representative;
+				// collapsed triangle
+				if (a == b || b == c || a == c)
+				{
+					continue;
+				}
+				result.push_back(a);
+				result.push_back(b);
+				result.push_back(c);
+			}
+		}
+	}
+
+	void GenerateMeshLods(SubMeshData &data, const MeshLodSettings &settings)
+	{
+		data.lods.clear();
+		if (data.positions.empty() || data.indices.size() < 3)
+		{
+			return;
+		}
+
+		glm::vec3 size = data.boundingBox.maxPoint - data.boundingBox.minPoint;
+		float side = glm::max(size.x, glm::max(size.y, size.z));
+		if (side <= 0.0f)
+		{
+			return;
+		}
+
+		float cellSize = side * settings.cellRatio;
+		std::size_t previousSize = data.indices.size();
+		std::vector<std::uint32_t> lod;
+
+		for (std::size_t i = 0; i < settings.lodNumber; ++i, cellSize *= settings.cellRatioFactor)
+		{
+			// always clustered from the full detail mesh to not accumulate errors
+			ClusterVertices(data, cellSize, data.indices, lod);
+			if (lod.empty())
+			{
+				// everything collapsed
+				break;
+			}
+			if (float(lod.size()) > float(previousSize) * settings.minReduction)
+			{
+				// not simplified enough to be worth it, try a bigger cell
+				continue;
+			}
+			previousSize = lod.size();
+			data.lods.push_back(lod);
+		}
+	}
+
+	void ExtractMeshLod(const SubMeshData &data, std::size_t lod, SubMeshData &result)
+	{
+		AGE_ASSERT(lod < data.lods.size());
+
+		auto &indices = data.lods[lod];
+		std::vector<std::uint32_t> remap(data.positions.size(), std::uint32_t(-1));
+		std::vector<std::uint32_t> used;
+
+		result.indices.resize(indices.size());
+		for (std::size_t i = 0; i < indices.size(); ++i)
+		{
+			auto &r = remap[indices[i]];
+			if (r == std::uint32_t(-1))
+			{
+				r = std::uint32_t(used.size());
+				used.push_back(indices[i]);
+			}
+			result.indices[i] = r;
+		}
+
+		result.name = data.name;
+		result.infos = data.infos;
+		result.boundingBox = data.boundingBox;
+		result.defaultMaterialIndex = data.defaultMaterialIndex;
+		CompactAttribute(data.positions, used, result.positions);
+		CompactAttribute(data.normals, used, result.normals);
+		CompactAttribute(data.tangents, used, result.tangents);
+		CompactAttribute(data.biTangents, used, result.biTangents);
+		CompactAttribute(data.weights, used, result.weights);
+		CompactAttribute(data.boneIndices, used, result.boneIndices);
+		CompactAttribute(data.colors, used, result.colors);
+		result.uvs.resize(data.uvs.size());
+		for (std::size_t i = 0; i < data.uvs.size(); ++i)
+		{
+			CompactAttribute(data.uvs[i], used, result.uvs[i]);
+		}
+	}
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace AGE
+{
+	struct SubMeshData;
+
+	// Simplified levels of detail of a submesh
+	// Lods are generated by vertex clustering : vertices are snapped on a grid
+	// and each cell is replaced by its most central vertex, so lods only index
+	// a subset of the full detail vertices (attributes and skinning stay valid)
+	struct MeshLodSettings
+	{
+		// number of lods generated after the full detail one
+		std::size_t lodNumber = 3;
+		// grid cell size of the first lod, relative to the bounding box biggest side
+		float cellRatio = 0.02f;
+		// cell size is multiplied by this factor for each next lod
+		float cellRatioFactor = 2.5f;
+		// generation stop if a lod keep more triangles than this ratio of the previous one
+		float minReduction = 0.85f;
+	};
+
+	// fill data.lods, called by the cooker
+	void GenerateMeshLods(SubMeshData &data, const MeshLodSettings &settings = MeshLodSettings());
+
+	// copy the vertices used by a lod in result, indices are remapped
+	void ExtractMeshLod(const SubMeshData &data, std::size_t lod, SubMeshData &result);
+}
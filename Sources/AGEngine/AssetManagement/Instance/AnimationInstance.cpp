@@ -32,8 +32,13 @@ void AnimationInstance::update(float t)
 		return;
 	auto localTime = std::fmodf(t, animationData->duration);
 
+	if (keyCursors.size() != animationData->channels.size())
+	{
+		keyCursors.assign(animationData->channels.size(), glm::uvec3(0));
+	}
 	for (std::size_t i = 0; i < animationData->channels.size(); ++i)
 	{
-		animationData->channels[i].getInterpolatedTransform(localTime, bindPoses[animationData->channels[i].boneIndex]);
+		auto &channel = animationData->channels[i];
+		channel.getInterpolatedTransform(localTime, bindPoses[channel.boneIndex], keyCursors[i]);
 	}
 }
\ No newline at end of file
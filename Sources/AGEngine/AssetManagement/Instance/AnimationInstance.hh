@@ -3,6 +3,7 @@
 #include <Utils/Containers/Vector.hpp>
 #include <memory>
 #include <glm/glm.hpp>
+#include <Skinning/BoneMatrix.hpp>
 
 namespace AGE
 {
@@ -18,8 +19,8 @@ namespace AGE
 		AnimationInstance &operator=(const AnimationInstance &) = default;
 
 		inline std::size_t getTransformationsIndex() const { return _transformationIndex; }
-		inline const glm::mat4 *getTransformations() const { return _tranformationBuffer; }
-		inline glm::mat4 *getTransformations() { return _tranformationBuffer; }
+		inline const BoneMatrix *getTransformations() const { return _tranformationBuffer; }
+		inline BoneMatrix *getTransformations() { return _tranformationBuffer; }
 		inline std::shared_ptr<Skeleton> getSkeleton() const { return skeleton; }
 		inline std::shared_ptr<AnimationData> getAnimation() const { return animationData; }
 		void update(float t);
@@ -29,18 +30,33 @@ namespace AGE
 		inline bool isShared() const { return _isShared; }
 		inline bool shareSameAnimation(const std::shared_ptr<AnimationData> &anim) const { return anim == animationData; }
 		inline std::size_t getTransformationBufferSize() const { return _tranformationBufferSize; }
+		// called for each mesh using the instance, with the size it was drawn at in the last culling
+		inline void reportScreenSize(float size) { _screenSize = size > _screenSize ? size : _screenSize; }
 
 //todo private:
 		std::shared_ptr<AnimationData> animationData;
 		float time;
 		std::shared_ptr<Skeleton> skeleton;
 		AGE::Vector<glm::mat4> bindPoses;
+		// global matrices of the bones in the skeleton topological order, filled by Skeleton::updateSkinning
+		AGE::Vector<glm::mat4> globalPoses;
+		// last keys used by each channel, start point of the next search
+		AGE::Vector<glm::uvec3> keyCursors;
 		float _timeMultiplier = 10.0f;
 		std::size_t _instanceCounter = 0;
 		bool _isShared = false;
 		std::size_t _transformationIndex = -1;
-		glm::mat4 *_tranformationBuffer = nullptr;
+		BoneMatrix *_tranformationBuffer = nullptr;
 		const std::size_t _tranformationBufferSize;
+
+		// animation lod, see AnimationManager::update
+		float _screenSize = 0.0f;
+		// two last evaluated poses and the frames they are for, the oldest first
+		AGE::Vector<BoneMatrix> _lodPoses[2];
+		std::size_t _lodFrames[2];
+		std::uint8_t _lodPoseNumber = 0;
+		// the skinning changed since the last update, only the changed ones are uploaded
+		bool _dirty = true;
 	};
 
 }
\ No newline at end of file
@@ -28,6 +28,9 @@ namespace AGE
 		std::shared_ptr<Texture2D> specularTex   = nullptr;
 
 		bool scaleUVs = false;
+
+		// block of the material in the MaterialBuffer of the render thread, render thread only
+		mutable std::size_t uniformSlot          = std::size_t(-1);
 	};
 
 	struct MaterialSetInstance
@@ -17,6 +17,8 @@ namespace AGE
 	{
 		Key<Painter> painter;
 		Key<Vertices> vertices;
+		// simplified vertices, from the most to the least detailed
+		std::vector<Key<Vertices>> lods;
 		AGE::AABoundingBox boundingBox;
 		uint16_t defaultMaterialIndex;
 		bool isSkinned = false;
@@ -1,6 +1,7 @@
 #include <AssetManagement/OpenGLDDSLoader.hh>
 #include <glm/gtx/extented_min_max.hpp>
 #include <fstream>
+#include <algorithm>
 
 namespace AGE
 {
@@ -14,13 +15,47 @@ namespace AGE
 		GL_TEXTURE_CUBE_MAP_NEGATIVE_Z
 	};
 
+	std::size_t DDSImage::getLevelSize(std::size_t level) const
+	{
+		std::size_t size = 0;
+		for (std::size_t face = 0; face < faces; ++face)
+		{
+			size += getMipmap(face, level).size;
+		}
+		return size;
+	}
+
 	std::shared_ptr<ATexture> OpenGLDDSLoader::loadDDSFile(OldFile const &file)
+	{
+		std::shared_ptr<DDSImage> image = parseDDSFile(file);
+		if (image == nullptr)
+		{
+			return (nullptr);
+		}
+		std::shared_ptr<ATexture> texture = nullptr;
+		if (image->isCubeMap)
+		{
+			texture = std::make_shared<TextureCubeMap>();
+		}
+		else
+		{
+			texture = std::make_shared<Texture2D>();
+		}
+		initTexture(*texture, *image);
+		for (auto &mipmap : image->mipmaps)
+		{
+			uploadMipmap(*texture, *image, mipmap, image->data.data() + mipmap.offset);
+		}
+		// If the texture has no mipmaps, we generate them
+		if (image->hasMipmaps == false)
+			texture->generateMipmaps();
+		texture->unbind();
+		return (texture);
+	}
+
+	std::shared_ptr<DDSImage> OpenGLDDSLoader::parseDDSFile(OldFile const &file)
 	{
 		std::ifstream ifs(file.getFullName(), std::ios::binary);
-		char *fileBuffer;
-		char *currentPtr;
-		uint32_t magic;
-		DirectX::DDS_HEADER *header;
 
 		if (!ifs)
 		{
@@ -32,120 +67,127 @@ namespace AGE
 		std::streamsize fileSize = ifs.tellg();
 		ifs.seekg(0, std::ios::beg);
 
-		fileBuffer = new char[fileSize];
-		ifs.read(fileBuffer, fileSize);
-		// currentPtr is the current reading pointer
-		currentPtr = fileBuffer;
-
+		if (fileSize < std::streamsize(sizeof(uint32_t) + sizeof(DirectX::DDS_HEADER)))
+		{
+			assert(!"Texture is not a DDS");
+			return (nullptr);
+		}
+		std::shared_ptr<DDSImage> image = std::make_shared<DDSImage>();
+		image->data.resize(std::size_t(fileSize));
+		ifs.read(image->data.data(), fileSize);
 		if (!ifs)
 		{
 			// The read failed
 			assert(!"The file has not been found");
 			return (nullptr);
 		}
+		// currentPtr is the current reading pointer
+		char const *currentPtr = image->data.data();
+
 		// We check the magic number
-		magic = *(uint32_t*)currentPtr;
+		uint32_t magic = *(uint32_t const*)currentPtr;
 		currentPtr += sizeof(uint32_t);
 		if (magic != DirectX::DDS_MAGIC)
 		{
 			// Wrong magic number
-			delete fileBuffer;
 			assert(!"Texture is not a DDS");
 			return (nullptr);
 		}
 		// We get the header
-		header = (DirectX::DDS_HEADER*)currentPtr;
+		DirectX::DDS_HEADER const *header = (DirectX::DDS_HEADER const*)currentPtr;
 		currentPtr += sizeof(DirectX::DDS_HEADER);
-		size_t totalSize = 0;
-
-		// We get the texture infos
-		bool compressed;
-		size_t blockOrPixelSize;
-		GLenum format;
-		GLenum sizedFormat;
-		GLenum uncompressedType;
 
 		// We get the texture infos (is it compressed, what kind of compression, color components...)
-		if (getTexturePixelInfos(header, compressed, blockOrPixelSize, format, sizedFormat, uncompressedType) == false)
+		size_t blockOrPixelSize;
+		if (getTexturePixelInfos(header, image->compressed, blockOrPixelSize, image->format, image->sizedFormat, image->uncompressedType) == false)
 			return (nullptr);
 
 		// We check the texture type
-		bool isCubeMap = (header->dwCaps2 & DDS_CUBEMAP_ALLFACES) == DDS_CUBEMAP_ALLFACES;
+		image->isCubeMap = (header->dwCaps2 & DDS_CUBEMAP_ALLFACES) == DDS_CUBEMAP_ALLFACES;
 		// TODO: We can add a volume texture type here
-		bool hasMipmaps = (header->dwFlags & DDS_HEADER_FLAGS_MIPMAP) == DDS_HEADER_FLAGS_MIPMAP;
-		size_t textureMipmaps = hasMipmaps ? header->dwMipMapCount : 1;
-		size_t textureDepth;
-		std::shared_ptr<ATexture> texture = nullptr;
-		
-		if (isCubeMap)
-		{
-			std::shared_ptr<TextureCubeMap> tmp = std::make_shared<TextureCubeMap>();
-
-			tmp->init(header->dwWidth, header->dwHeight, sizedFormat, true);
-			texture = tmp;
-			textureDepth = 6;
-		}
-		else
-		{
-			std::shared_ptr<Texture2D> tmp = std::make_shared<Texture2D>();
-
-			tmp->init(header->dwWidth, header->dwHeight, sizedFormat, true);
-			texture = tmp;
-			textureDepth = 1;
-		}
-
-		// Here we read the texture content
-		size_t mipmapSize;
-
+		image->hasMipmaps = (header->dwFlags & DDS_HEADER_FLAGS_MIPMAP) == DDS_HEADER_FLAGS_MIPMAP;
+		image->levels = image->hasMipmaps ? std::max(std::size_t(header->dwMipMapCount), std::size_t(1)) : 1;
+		image->faces = image->isCubeMap ? 6 : 1;
+		image->width = GLsizei(header->dwWidth);
+		image->height = GLsizei(header->dwHeight);
+
+		// Here we locate the texture content
+		std::size_t offset = std::size_t(currentPtr - image->data.data());
+		image->mipmaps.reserve(image->faces * image->levels);
 		// for each depth
-		for (size_t curDepth = 0; curDepth < textureDepth; ++curDepth)
+		for (size_t curDepth = 0; curDepth < image->faces; ++curDepth)
 		{
 			size_t width = header->dwWidth;
 			size_t height = header->dwHeight;
 			// for each mipmap
-			for (size_t curMipmap = 0; curMipmap < textureMipmaps; ++curMipmap)
+			for (size_t curMipmap = 0; curMipmap < image->levels; ++curMipmap)
 			{
-				if (compressed)
-					mipmapSize = ((width + 3) / 4) * ((height + 3) / 4) * blockOrPixelSize;
+				DDSImage::Mipmap mipmap;
+				mipmap.face = curDepth;
+				mipmap.level = curMipmap;
+				mipmap.width = GLsizei(width);
+				mipmap.height = GLsizei(height);
+				mipmap.offset = offset;
+				if (image->compressed)
+					mipmap.size = ((width + 3) / 4) * ((height + 3) / 4) * blockOrPixelSize;
 				else
-					mipmapSize = width * height * blockOrPixelSize;
-
-				if (isCubeMap)
+					mipmap.size = width * height * blockOrPixelSize;
+				if (offset + mipmap.size > image->data.size())
 				{
-					std::shared_ptr<TextureCubeMap> tmp = std::static_pointer_cast<TextureCubeMap>(texture);
-
-					if (compressed)
-						tmp->setCompressed(textureFaces[curDepth], currentPtr, curMipmap, width, height, format, mipmapSize);
-					else
-						tmp->set(textureFaces[curDepth], currentPtr, curMipmap, width, height, format, uncompressedType);
+					assert(!"Truncated DDS file");
+					return (nullptr);
 				}
-				else
-				{
-					std::shared_ptr<Texture2D> tmp = std::static_pointer_cast<Texture2D>(texture);
-
-					if (compressed)
-						tmp->setCompressed(currentPtr, curMipmap, width, height, format, mipmapSize);
-					else
-						tmp->set(currentPtr, curMipmap, width, height, format, uncompressedType);
-				}
-				currentPtr += mipmapSize;
-				width = glm::max(1ULL, width >> 1);
-				height = glm::max(1ULL, height >> 1);
+				image->mipmaps.push_back(mipmap);
+				offset += mipmap.size;
+				width = std::max(std::size_t(1), width >> 1);
+				height = std::max(std::size_t(1), height >> 1);
 			}
 		}
+		return (image);
+	}
 
-		// If the texture has no mipmaps, we generate them
-		if (hasMipmaps == false)
-			texture->generateMipmaps();
+	void OpenGLDDSLoader::initTexture(ATexture &texture, DDSImage const &image)
+	{
+		if (image.isCubeMap)
+			static_cast<TextureCubeMap &>(texture).init(image.width, image.height, image.sizedFormat, true);
+		else
+			static_cast<Texture2D &>(texture).init(image.width, image.height, image.sizedFormat, true);
+		setParameters(texture, image);
+	}
+
+	void OpenGLDDSLoader::setParameters(ATexture &texture, DDSImage const &image, std::size_t firstLevel)
+	{
 		// We set the basic texture parameters
-		texture->parameter(GL_TEXTURE_WRAP_S, GL_REPEAT);
-		texture->parameter(GL_TEXTURE_WRAP_T, GL_REPEAT);
-		texture->parameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-		texture->parameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-		// We delete the buffer and return, texture loaded successfuly
-		delete fileBuffer;
-		texture->unbind();
-		return (texture);
+		texture.parameter(GL_TEXTURE_WRAP_S, GL_REPEAT);
+		texture.parameter(GL_TEXTURE_WRAP_T, GL_REPEAT);
+		texture.parameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		texture.parameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		// the levels missing from the file are never sampled
+		if (image.hasMipmaps)
+			texture.parameter(GL_TEXTURE_MAX_LEVEL, GLint(image.levels - 1 - firstLevel));
+	}
+
+	void OpenGLDDSLoader::uploadMipmap(ATexture &texture, DDSImage const &image, DDSImage::Mipmap const &mipmap, GLvoid const *data, std::size_t firstLevel)
+	{
+		const GLint level = GLint(mipmap.level - firstLevel);
+		if (image.isCubeMap)
+		{
+			TextureCubeMap &cubeMap = static_cast<TextureCubeMap &>(texture);
+
+			if (image.compressed)
+				cubeMap.setCompressed(textureFaces[mipmap.face], data, level, mipmap.width, mipmap.height, image.format, GLsizei(mipmap.size));
+			else
+				cubeMap.set(textureFaces[mipmap.face], data, level, mipmap.width, mipmap.height, image.format, image.uncompressedType);
+		}
+		else
+		{
+			Texture2D &texture2D = static_cast<Texture2D &>(texture);
+
+			if (image.compressed)
+				texture2D.setCompressed(data, level, mipmap.width, mipmap.height, image.format, GLsizei(mipmap.size));
+			else
+				texture2D.set(data, level, mipmap.width, mipmap.height, image.format, image.uncompressedType);
+		}
 	}
 
 	bool OpenGLDDSLoader::getTexturePixelInfos(DirectX::DDS_HEADER const *header, bool &compressed,
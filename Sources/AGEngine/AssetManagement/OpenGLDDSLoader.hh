@@ -5,16 +5,60 @@
 #include <Render/Textures/TextureCubeMap.hh>
 #include <DirectXTex/DirectXTex/DDS.h>
 #include <memory>
+#include <vector>
 
 namespace AGE
 {
+	// DDS file read and parsed without OpenGL, can be done by any thread
+	// The mipmaps are stored face by face, like in the file
+	struct DDSImage
+	{
+		struct Mipmap
+		{
+			std::size_t face;
+			std::size_t level;
+			GLsizei width;
+			GLsizei height;
+			// in data
+			std::size_t offset;
+			std::size_t size;
+		};
+
+		std::vector<char> data;
+		std::vector<Mipmap> mipmaps;
+		GLsizei width = 0;
+		GLsizei height = 0;
+		bool compressed = false;
+		GLenum format = 0;
+		GLenum sizedFormat = 0;
+		GLenum uncompressedType = 0;
+		bool isCubeMap = false;
+		// the mipmaps are generated once the level 0 is uploaded otherwise
+		bool hasMipmaps = false;
+		std::size_t levels = 0;
+		std::size_t faces = 0;
+
+		inline const Mipmap &getMipmap(std::size_t face, std::size_t level) const { return mipmaps[face * levels + level]; }
+		// size of the level for all the faces
+		std::size_t getLevelSize(std::size_t level) const;
+	};
+
 	class OpenGLDDSLoader
 	{
 	public:
+		// read, parse and upload in one go, render thread only
 		static std::shared_ptr<ATexture> loadDDSFile(OldFile const &file);
+		// no OpenGL call, safe on the worker threads
+		static std::shared_ptr<DDSImage> parseDDSFile(OldFile const &file);
+		// render thread only
+		// allocates the storage of all the levels and sets the default parameters
+		static void initTexture(ATexture &texture, DDSImage const &image);
+		// the level 0 of the texture storage is the level firstLevel of the image
+		static void setParameters(ATexture &texture, DDSImage const &image, std::size_t firstLevel = 0);
+		// data is a client pointer or an offset in the bound GL_PIXEL_UNPACK_BUFFER
+		static void uploadMipmap(ATexture &texture, DDSImage const &image, DDSImage::Mipmap const &mipmap, GLvoid const *data, std::size_t firstLevel = 0);
 	private:
 		static bool getTexturePixelInfos(DirectX::DDS_HEADER const *header, bool &compressed,
 			size_t &blockOrPixelSize, GLenum &format, GLenum &sizedFormat, GLenum &uncompressedType);
 	};
 }
-
@@ -1,22 +1,70 @@
 #include "BFCBlock.hpp"
+#include "BFCBlockManager.hpp"
 #include <Utils/Debug.hpp>
 
+#include <limits>
+
 namespace AGE
 {
+	void BFCBlockSpheres::set(ItemID id, const glm::vec4 &sphere)
+	{
+		x[id] = sphere.x;
+		y[id] = sphere.y;
+		z[id] = sphere.z;
+		radius[id] = sphere.w;
+	}
+
+	void BFCBlockSpheres::invalidate(ItemID id)
+	{
+		x[id] = 0.0f;
+		y[id] = 0.0f;
+		z[id] = 0.0f;
+		radius[id] = -std::numeric_limits<float>::infinity();
+	}
+
+	BFCBlockBounds::BFCBlockBounds()
+	{
+		clear();
+	}
+
+	void BFCBlockBounds::clear()
+	{
+		min = glm::vec3(std::numeric_limits<float>::max());
+		max = glm::vec3(-std::numeric_limits<float>::max());
+	}
+
+	void BFCBlockBounds::expand(const glm::vec4 &sphere)
+	{
+		glm::vec3 center(sphere.x, sphere.y, sphere.z);
+		min = glm::min(min, center - sphere.w);
+		max = glm::max(max, center + sphere.w);
+	}
+
 	BFCBlock::BFCBlock()
 	{
 		for (auto i = 0; i < MaxItemID; ++i)
 		{
 			_free.push(i);
+			_spheres.invalidate(i);
+			_itemCells[i] = 0;
+			_moved[i] = 0;
+			_stillFrames[i] = 0;
 		}
+		_dirty = false;
 	}
 
-	ItemID BFCBlock::createItem(BFCCullableObject *object)
+	ItemID BFCBlock::createItem(BFCCullableObject *object, std::uint64_t cell)
 	{
 		ItemID index;
 		index = _free.front();
 		_free.pop();
 		_items[index].setDrawable(object);
+		_spheres.set(index, _items[index].getPosition());
+		_itemCells[index] = cell;
+		_moved[index] = 0;
+		_stillFrames[index] = 0;
+		_bounds.expand(_items[index].getPosition());
+		++_version;
 		return index;
 	}
 
@@ -25,6 +73,64 @@ namespace AGE
 		AGE_ASSERT(itemId < MaxItemID);
 
 		_items[itemId].setDrawable(nullptr);
+		_spheres.invalidate(itemId);
 		_free.push(itemId);
+		++_version;
+		_dirty.store(true, std::memory_order_relaxed);
+	}
+
+	void BFCBlock::setItemPosition(ItemID itemId, const glm::vec4 &position)
+	{
+		AGE_ASSERT(itemId < MaxItemID);
+
+		_items[itemId].setPosition(position);
+		if (_items[itemId].getDrawable() != nullptr)
+		{
+			_spheres.set(itemId, position);
+			_moved[itemId] = 1;
+			// called by link update tasks, several items of the block can be set at the same time
+			_dirty.store(true, std::memory_order_relaxed);
+		}
+	}
+
+	void BFCBlock::update(float cellSize, std::uint32_t staticFrames, std::vector<BFCItemMove> &moved)
+	{
+		if (_dirty.exchange(false, std::memory_order_relaxed))
+		{
+			++_version;
+		}
+		_bounds.clear();
+		for (ItemID i = 0; i < MaxItemID; ++i)
+		{
+			// free slots have a negative radius
+			if (_spheres.radius[i] < 0.0f)
+			{
+				continue;
+			}
+			if (_moved[i] != 0)
+			{
+				_moved[i] = 0;
+				_stillFrames[i] = 0;
+			}
+			else if (_stillFrames[i] < 0xFFFF)
+			{
+				++_stillFrames[i];
+			}
+
+			const glm::vec4 &sphere = _items[i].getPosition();
+			_bounds.expand(sphere);
+
+			BFCItemMove move;
+			move.item = i;
+			move.cell = BFCMortonCell(sphere, cellSize);
+			if (_stillFrames[i] < staticFrames)
+			{
+				move.cell |= BFCDynamicCell;
+			}
+			if (move.cell != _itemCells[i])
+			{
+				moved.push_back(move);
+			}
+		}
 	}
-}
\ No newline at end of file
+}
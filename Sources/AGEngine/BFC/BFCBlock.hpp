@@ -1,27 +1,96 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <queue>
+#include <vector>
+#include <atomic>
 
 #include "BFCItem.hpp"
 #include "BFCItemID.hpp"
+#include "BFCBlockManager.hpp"
 
 namespace AGE
 {
+	class BFCBlockManager;
 	class BFCBlockManagerFactory;
 
+	// SoA copy of the items bounding spheres
+	// Kept in sync with BFCItem positions, used by SIMD cullers
+	// to test multiple spheres at once.
+	// Free slots have a negative infinite radius, so they are always rejected.
+	struct BFCBlockSpheres
+	{
+		float x[MaxItemID];
+		float y[MaxItemID];
+		float z[MaxItemID];
+		float radius[MaxItemID];
+
+		void set(ItemID id, const glm::vec4 &sphere);
+		void invalidate(ItemID id);
+	};
+
+	// Conservative AABB of the block items spheres
+	// Recomputed when items moved, cullers use it to reject
+	// or accept the whole block without testing items
+	struct BFCBlockBounds
+	{
+		glm::vec3 min;
+		glm::vec3 max;
+
+		BFCBlockBounds();
+		void clear();
+		void expand(const glm::vec4 &sphere);
+		inline bool empty() const { return min.x > max.x; }
+	};
+
+	struct BFCItemMove
+	{
+		ItemID item;
+		std::uint64_t cell;
+	};
+
 	class BFCBlock
 	{
 	public:
 		BFCBlock();
-		ItemID createItem(BFCCullableObject *object);
+		ItemID createItem(BFCCullableObject *object, std::uint64_t cell = 0);
 		void deleteItem(ItemID itemId);
+		void setItemPosition(ItemID itemId, const glm::vec4 &position);
 
 		inline bool isFull() const { return _free.empty(); }
+		inline bool isEmpty() const { return _free.size() == MaxItemID; }
+		inline const BFCItem *getItems() const { return _items; }
+		inline const BFCBlockSpheres &getSpheres() const { return _spheres; }
+		inline const BFCBlockBounds &getBounds() const { return _bounds; }
+		inline std::uint64_t getCell() const { return _cell; }
+		inline bool isDirty() const { return _dirty.load(std::memory_order_relaxed); }
+		inline bool isDynamic() const { return (_cell & BFCDynamicCell) != 0; }
+		// changed each time items are added, removed or moved
+		// culling results of a block with the same version are the same
+		inline std::uint32_t getVersion() const { return _version; }
+
+		// recompute bounds and push the items which are not in the cell they
+		// were placed for. Items which moved in the last staticFrames
+		// frames belong to the dynamic cells (0 disable the partition)
+		void update(float cellSize, std::uint32_t staticFrames, std::vector<BFCItemMove> &moved);
 	private:
+		BFCBlockSpheres _spheres;
 		BFCItem _items[MaxItemID];
+		// cell of each item when it was placed in the block
+		std::uint64_t _itemCells[MaxItemID];
+		// set by setItemPosition, one byte per item so tasks don't share them
+		std::uint8_t _moved[MaxItemID];
+		// number of updates since the item moved
+		std::uint16_t _stillFrames[MaxItemID];
+		std::uint32_t _version = 0;
 		std::queue<ItemID> _free;
+		BFCBlockBounds _bounds;
+		std::uint64_t _cell = 0;
+		// items moved, added or removed since the last update
+		std::atomic<bool> _dirty;
 
+		friend class BFCBlockManager;
 		friend class BFCBlockManagerFactory;
 	};
-}
\ No newline at end of file
+}
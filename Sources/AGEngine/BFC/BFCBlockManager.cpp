@@ -4,34 +4,130 @@
 
 #include "Utils/Debug.hpp"
 
+#include <cmath>
 
 namespace AGE
 {
-	void BFCBlockManager::createItem(BFCCullableObject *object, BlockID &blockID, ItemID &itemId)
+	namespace
 	{
-		
-		if (_blocksNotFull.empty() == false)
+		// spread the 21 low bits to every third bit
+		inline std::uint64_t MortonSpread(std::uint64_t v)
 		{
-			auto b = *(_blocksNotFull.begin());
-			auto &block = _blocks[b];
-			itemId = block->createItem(object);
-			blockID = std::uint8_t(b);
-			if (block->isFull())
+			v &= 0x1FFFFF;
+			v = (v | v << 32) & 0x1F00000000FFFF;
+			v = (v | v << 16) & 0x1F0000FF0000FF;
+			v = (v | v << 8) & 0x100F00F00F00F00F;
+			v = (v | v << 4) & 0x10C30C30C30C30C3;
+			v = (v | v << 2) & 0x1249249249249249;
+			return v;
+		}
+
+		inline std::uint64_t MortonCoordinate(float position, float cellSize)
+		{
+			static const std::int64_t bias = 1 << 20;
+			std::int64_t c = std::int64_t(std::floor(position / cellSize)) + bias;
+			if (c < 0)
+			{
+				c = 0;
+			}
+			else if (c > 0x1FFFFF)
 			{
-				_blocksNotFull.erase(_blocksNotFull.begin());
+				c = 0x1FFFFF;
 			}
-			return;
+			return std::uint64_t(c);
+		}
+	}
+
+	std::uint64_t BFCMortonCell(const glm::vec4 &sphere, float cellSize)
+	{
+		if (cellSize <= 0.0f)
+		{
+			return 0;
+		}
+		return MortonSpread(MortonCoordinate(sphere.x, cellSize))
+			| (MortonSpread(MortonCoordinate(sphere.y, cellSize)) << 1)
+			| (MortonSpread(MortonCoordinate(sphere.z, cellSize)) << 2);
+	}
+
+	void BFCBlockManager::createItem(BFCCullableObject *object, BlockID &blockID, ItemID &itemId, std::uint64_t cell)
+	{
+		std::size_t b = _findBlock(cell);
+		auto &block = _blocks[b];
+		itemId = block->createItem(object, cell);
+		blockID = std::uint8_t(b);
+		if (block->isFull())
+		{
+			_setFull(b, true);
 		}
-		_blocks.push_back(std::make_shared<BFCBlock>());
-		AGE_ASSERT(_blocks.size() < MaxBlockID);
-		_blocksNotFull.insert(_blocks.size() - 1);
-		createItem(object, blockID, itemId);
 	}
 
 	void BFCBlockManager::deleteItem(BlockID &blockID, ItemID &itemId)
 	{
 		AGE_ASSERT(blockID < _blocks.size());
 		_blocks[blockID]->deleteItem(itemId);
-		_blocksNotFull.insert(blockID);
+		_setFull(blockID, false);
+	}
+
+	std::size_t BFCBlockManager::_findBlock(std::uint64_t cell)
+	{
+		auto found = _cellBlocksNotFull.find(cell);
+		if (found != std::end(_cellBlocksNotFull) && found->second.empty() == false)
+		{
+			return *found->second.begin();
+		}
+
+		// an empty block can change of cell
+		for (auto b : _blocksNotFull)
+		{
+			auto &block = _blocks[b];
+			if (block->isEmpty())
+			{
+				_cellBlocksNotFull[block->_cell].erase(b);
+				block->_cell = cell;
+				_cellBlocksNotFull[cell].insert(b);
+				return b;
+			}
+		}
+
+		if (_blocks.size() + 1 < MaxBlockID)
+		{
+			_blocks.push_back(std::make_shared<BFCBlock>());
+			std::size_t b = _blocks.size() - 1;
+			_blocks[b]->_cell = cell;
+			_blocksNotFull.insert(b);
+			_cellBlocksNotFull[cell].insert(b);
+			return b;
+		}
+
+		// no more blocks, use the closest cell in morton order
+		AGE_ASSERT(_blocksNotFull.empty() == false);
+		std::size_t best = *_blocksNotFull.begin();
+		std::uint64_t bestDistance = std::uint64_t(-1);
+		for (auto b : _blocksNotFull)
+		{
+			std::uint64_t c = _blocks[b]->_cell;
+			std::uint64_t distance = c > cell ? c - cell : cell - c;
+			if (distance < bestDistance)
+			{
+				bestDistance = distance;
+				best = b;
+			}
+		}
+		return best;
+	}
+
+	void BFCBlockManager::_setFull(std::size_t block, bool full)
+	{
+		auto cell = _blocks[block]->_cell;
+		if (full)
+		{
+			_blocksNotFull.erase(block);
+			_cellBlocksNotFull[cell].erase(block);
+		}
+		else
+		{
+			_blocksNotFull.insert(block);
+			_cellBlocksNotFull[cell].insert(block);
+		}
 	}
-}
\ No newline at end of file
+}
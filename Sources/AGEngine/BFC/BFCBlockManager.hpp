@@ -3,8 +3,11 @@
 #include <memory>
 #include <vector>
 #include <set>
+#include <map>
 #include <cstdint>
 
+#include <glm/glm.hpp>
+
 #include "BFCItemID.hpp"
 
 namespace AGE
@@ -13,15 +16,28 @@ namespace AGE
 	struct BFCCullableObject;
 	class BFCBlockManagerFactory;
 
+	// Morton code of the grid cell containing the sphere center
+	// 21 bits per axis, so cells are close in memory order when close in space
+	std::uint64_t BFCMortonCell(const glm::vec4 &sphere, float cellSize);
+	// morton codes use 63 bits, the last one separate moving items
+	// so blocks of static items stay untouched
+	static const std::uint64_t BFCDynamicCell = std::uint64_t(1) << 63;
+
 	class BFCBlockManager
 	{
 	public:
 	private:
-		void createItem(BFCCullableObject *object, BlockID &blockID, ItemID &itemId);
+		// items are put in a block of their cell when possible
+		void createItem(BFCCullableObject *object, BlockID &blockID, ItemID &itemId, std::uint64_t cell = 0);
 		void deleteItem(BlockID &blockID, ItemID &itemId);
+		std::size_t _findBlock(std::uint64_t cell);
+		void _setFull(std::size_t block, bool full);
+
 		std::vector<std::shared_ptr<BFCBlock>> _blocks;
 		std::set<std::size_t> _blocksNotFull;
+		// not full blocks by cell
+		std::map<std::uint64_t, std::set<std::size_t>> _cellBlocksNotFull;
 
 		friend class BFCBlockManagerFactory;
 	};
-}
\ No newline at end of file
+}
@@ -3,11 +3,17 @@
 #include "BFCCullableObject.hpp"
 #include "BFCBlock.hpp"
 
+#include "BFCCullingOptions.hpp"
+
 #include "Utils/Frustum.hh"
 
 #include "Utils/Debug.hpp"
 #include "Utils/Profiler.hpp"
 
+#include <Threads/TaskScheduler.hpp>
+#include <Threads/Tasks/BasicTasks.hpp>
+#include <TMQ/queue.hpp>
+
 
 namespace AGE
 {
@@ -32,7 +38,11 @@ namespace AGE
 
 		auto &manager = _managers[typeId];
 
-		manager.createItem(object, result._itemID._blockID, result._itemID._itemID);
+		// position is not known yet, items are moved in the block
+		// of their cell by updateBlocks
+		const float cellSize = BFCCullingConfig::g_spatial_blocks_is_enabled ? BFCCullingConfig::g_block_cell_size : 0.0f;
+		manager.createItem(object, result._itemID._blockID, result._itemID._itemID, BFCMortonCell(glm::vec4(0), cellSize));
+		object->_bfcItemId = result._itemID;
 
 		return result;
 	}
@@ -49,6 +59,7 @@ namespace AGE
 		AGE_ASSERT(itemId._blockManagerID < _managers.size());
 
 		_managers[itemId._blockManagerID].deleteItem(itemId._blockID, itemId._itemID);
+		handle._elementPtr->_bfcItemId = BFCItemID();
 	}
 
 	BFCItem &BFCBlockManagerFactory::getItem(const BFCItemID &id)
@@ -59,6 +70,12 @@ namespace AGE
 		return _managers[id._blockManagerID]._blocks[id._blockID]->_items[id._itemID];
 	}
 
+	void BFCBlockManagerFactory::setItemPosition(const BFCItemID &id, const glm::vec4 &position)
+	{
+		AGE_ASSERT(id._blockManagerID < _managers.size());
+		_managers[id._blockManagerID]._blocks[id._blockID]->setItemPosition(id._itemID, position);
+	}
+
 	std::size_t BFCBlockManagerFactory::cullOnBlock(CullableTypeID channel, LFList<BFCItem> &result, const Frustum &frustum, std::size_t blockIdFrom, std::size_t numberOfBlocks)
 	{
 		SCOPE_profile_cpu_function("BFC");
@@ -165,4 +182,100 @@ namespace AGE
 		}
 		return _managers[channel]._blocks.size();
 	}
-}
\ No newline at end of file
+
+	void BFCBlockManagerFactory::updateBlocks()
+	{
+		SCOPE_profile_cpu_function("BFC");
+
+		const float cellSize = BFCCullingConfig::g_spatial_blocks_is_enabled ? BFCCullingConfig::g_block_cell_size : 0.0f;
+		const std::uint32_t staticFrames = BFCCullingConfig::g_static_partition_is_enabled ? BFCCullingConfig::g_static_frames : 0;
+
+		for (std::size_t channel = 0; channel < _managers.size(); ++channel)
+		{
+			auto &manager = _managers[channel];
+
+			// dynamic blocks are always updated to count the frames items did not move
+			_updatedBlocks.clear();
+			for (std::size_t b = 0; b < manager._blocks.size(); ++b)
+			{
+				if (manager._blocks[b]->isDirty() || manager._blocks[b]->isDynamic())
+				{
+					_updatedBlocks.push_back(b);
+				}
+			}
+			if (_updatedBlocks.empty())
+			{
+				continue;
+			}
+			if (_movedItems.size() < _updatedBlocks.size())
+			{
+				_movedItems.resize(_updatedBlocks.size());
+			}
+
+			{
+				SCOPE_profile_cpu_i("BFC", "UpdateBlockBounds");
+				TaskCounter counter;
+				for (std::size_t i = 0; i < _updatedBlocks.size(); ++i)
+				{
+					BFCBlock *block = manager._blocks[_updatedBlocks[i]].get();
+					std::vector<BFCItemMove> *moved = &_movedItems[i];
+					moved->clear();
+					// blocks are independent, the last one is updated on this thread
+					if (i + 1 == _updatedBlocks.size())
+					{
+						block->update(cellSize, staticFrames, *moved);
+						break;
+					}
+					counter.increment();
+					TMQ::TaskManager::emplaceSharedTask<Tasks::Basic::VoidFunction>([block, moved, cellSize, staticFrames, &counter]()
+					{
+						block->update(cellSize, staticFrames, *moved);
+						counter.decrement();
+					});
+				}
+				WaitForCounter(counter);
+			}
+
+			{
+				SCOPE_profile_cpu_i("BFC", "MoveItems");
+				for (std::size_t i = 0; i < _updatedBlocks.size(); ++i)
+				{
+					for (auto &move : _movedItems[i])
+					{
+						_moveItem(CullableTypeID(channel), BlockID(_updatedBlocks[i]), move);
+					}
+				}
+			}
+		}
+	}
+
+	void BFCBlockManagerFactory::_moveItem(CullableTypeID channel, BlockID blockId, const BFCItemMove &move)
+	{
+		auto &manager = _managers[channel];
+		auto &from = *manager._blocks[blockId];
+		ItemID itemId = move.item;
+		BFCItem &item = from._items[itemId];
+		BFCCullableObject *object = item.getDrawable();
+		const glm::vec4 position = item.getPosition();
+
+		if (from.getCell() == move.cell)
+		{
+			// came back in its block cell
+			from._itemCells[itemId] = move.cell;
+			return;
+		}
+
+		BFCItemID id;
+		id._blockManagerID = channel;
+		manager.createItem(object, id._blockID, id._itemID, move.cell);
+		auto &to = *manager._blocks[id._blockID];
+		to.setItemPosition(id._itemID, position);
+		to._moved[id._itemID] = 0;
+		to._stillFrames[id._itemID] = from._stillFrames[itemId];
+		to._bounds.expand(position);
+		// the destination is already up to date
+		to._dirty.store(false, std::memory_order_relaxed);
+		manager.deleteItem(blockId, itemId);
+		object->_bfcItemId = id;
+	}
+}
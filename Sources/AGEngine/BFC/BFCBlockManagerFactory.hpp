@@ -4,6 +4,7 @@
 #include "BFCItemID.hpp"
 #include "IBFCCullCallback.hpp"
 #include "BFCBlock.hpp"
+#include "BFCVisibilityCache.hpp"
 
 #include <Utils/Containers/LFList.hpp>
 
@@ -23,12 +24,18 @@ namespace AGE
 		BFCCullableHandle createItem(BFCCullableObject *object);
 		void deleteItem(const BFCCullableHandle &handle);
 		BFCItem &getItem(const BFCItemID &id);
+		// update item bounding sphere and block SoA spheres
+		void setItemPosition(const BFCItemID &id, const glm::vec4 &position);
 		std::size_t cullOnBlock(CullableTypeID channel, LFList<BFCItem> &result, const Frustum &frustum, std::size_t blockIdFrom, std::size_t numberOfBlocks);
 		std::size_t cullOnBlock(CullableTypeID channel, const Frustum &frustum, std::size_t blockIdFrom, std::size_t numberOfBlocks, IBFCCuller *culler);
 		// do not cull, all tests are accepted
 		std::size_t fillOnBlock(CullableTypeID channel, LFList<BFCItem> &result, std::size_t blockIdFrom, std::size_t numberOfBlocks, IBFCCuller *callback = nullptr);
 		// return the number of block to treat (each in on job)
 		std::size_t getBlockNumberToCull(CullableTypeID channel) const;
+		// recompute bounds of the blocks which changed and move items
+		// in the blocks of their cell, call it once all items positions
+		// are set and before culling
+		void updateBlocks();
 
 		template <typename CullerType>
 		void cullOnBlock(
@@ -36,11 +43,14 @@ namespace AGE
 			, CullerType *culler
 			, std::size_t from
 			, std::size_t numberOfBlocks
-			, std::vector<IBFCOutput*> &outputs)
+			, std::vector<IBFCOutput*> &outputs
+			, BFCVisibilityCache::Block *cache = nullptr)
 		{
 			SCOPE_profile_cpu_function("BFC");
 
 			AGE_ASSERT(channel < MaxCullableTypeID);
+			// a cache entry is for one block
+			AGE_ASSERT(cache == nullptr || numberOfBlocks == 1);
 
 			if (channel < _managers.size())
 			{
@@ -53,9 +63,13 @@ namespace AGE
 					if (blockId >= manager._blocks.size())
 						break;
 					auto &block = manager._blocks[blockId];
-					for (auto &item : block->_items)
+					if (cache)
 					{
-						culler->cullItem(item);
+						culler->cullBlockCached(*block, *cache);
+					}
+					else
+					{
+						culler->cullBlockWithBounds(*block);
 					}
 					++i;
 				}
@@ -67,6 +81,10 @@ namespace AGE
 			}
 		}
 	private:
+		void _moveItem(CullableTypeID channel, BlockID blockId, const BFCItemMove &move);
+
 		std::vector<BFCBlockManager> _managers;
+		std::vector<std::size_t> _updatedBlocks;
+		std::vector<std::vector<BFCItemMove>> _movedItems;
 	};
 }
\ No newline at end of file
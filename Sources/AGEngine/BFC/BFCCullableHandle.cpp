@@ -1,4 +1,5 @@
 #include "BFCCullableHandle.hpp"
+#include "BFCCullableObject.hpp"
 
 namespace AGE
 {
@@ -7,6 +8,15 @@ namespace AGE
 		return (_itemID.isValid() == false || _elementPtr == nullptr);
 	}
 
+	const BFCItemID BFCCullableHandle::getItemId() const
+	{
+		if (_elementPtr == nullptr)
+		{
+			return _itemID;
+		}
+		return _elementPtr->getBFCItemId();
+	}
+
 	bool BFCCullableHandle::operator==(const BFCCullableHandle &o) const
 	{
 		return o._itemID == _itemID && o._elementPtr == _elementPtr;
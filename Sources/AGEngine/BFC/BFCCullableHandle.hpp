@@ -21,7 +21,8 @@ namespace AGE
 		inline T *getPtr() { return (T*)(_elementPtr); }
 		template<typename T> // be carefull that's static cast, be sure to call the good type
 		inline const T *getPtr() const { return (T*)(_elementPtr); }
-		inline const BFCItemID getItemId() const { return _itemID; }
+		// the item can have been moved since the handle creation
+		const BFCItemID getItemId() const;
 
 	private:
 		BFCItemID              _itemID;
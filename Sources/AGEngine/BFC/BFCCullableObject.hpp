@@ -21,8 +21,15 @@ namespace AGE
 		virtual ~BFCCullableObject() {}
 		inline CullableTypeID getBFCType() const { return _type; };
 		virtual glm::vec4 setBFCTransform(const glm::mat4 &transformation);
+		// current place of the object in the blocks, items can be moved
+		// by the factory to keep blocks spatially coherent
+		inline const BFCItemID &getBFCItemId() const { return _bfcItemId; }
 	protected:
 		glm::mat4 _transform;
 		const CullableTypeID _type;
+	private:
+		BFCItemID _bfcItemId;
+
+		friend class BFCBlockManagerFactory;
 	};
 }
\ No newline at end of file
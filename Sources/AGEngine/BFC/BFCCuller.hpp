@@ -13,10 +13,14 @@
 
 #include "TMQ/Queue.hpp"
 #include "Threads/Tasks/BasicTasks.hpp"
+#include "Threads/TaskScheduler.hpp"
 #include "Utils/Containers/LFQueue.hpp"
 
 #include "BFC/BFCItemID.hpp"
 #include "BFC/BFCArray.hpp"
+#include "BFC/BFCBlock.hpp"
+#include "BFC/BFCCullingOptions.hpp"
+#include "BFC/BFCVisibilityCache.hpp"
 
 namespace AGE
 {
@@ -39,6 +43,13 @@ namespace AGE
 		{
 			_culler.prepareForCulling(args...);
 			_counter = nullptr;
+			_cache = nullptr;
+		}
+
+		// optional, the cache have to outlive the culling tasks
+		inline void setVisibilityCache(BFCVisibilityCache *cache)
+		{
+			_cache = cache;
 		}
 
 		template<typename OutputType>
@@ -52,7 +63,9 @@ namespace AGE
 			_channels[cullingChannel].push_back(output);
 		}
 
-		std::size_t cull(BFCBlockManagerFactory *factory, std::atomic_size_t *counter)
+		// counter is incremented by the number of culling tasks
+		// and decremented when each of them is done
+		std::size_t cull(BFCBlockManagerFactory *factory, TaskCounter *counter)
 		{
 			std::size_t res = 0;
 			_counter = counter;
@@ -61,12 +74,16 @@ namespace AGE
 			{
 				auto blockNumber = factory->getBlockNumberToCull(channel.first);
 				res += blockNumber;
-				_counter->fetch_add(blockNumber);
+				_counter->increment(blockNumber);
 
 				for (IBFCOutput *output : channel.second)
 				{
 					output->setNumberOfBlocks(blockNumber);
 				}
+				if (blockNumber > 0 && _cache)
+				{
+					_cache->resize(channel.first, blockNumber);
+				}
 				if (blockNumber > 0)
 				{
 					auto tasks = TMQ::TaskManager::allocSharedTasks<Tasks::Basic::VoidFunction>(blockNumber);
@@ -77,8 +94,9 @@ namespace AGE
 							// TODO make a global pool of culler
 							CullerType *culler = BFCCullerMethod<CullerType>::GetNewCullerMethod();
 							*culler = _culler;
-							factory->cullOnBlock(channel.first, culler, i, 1, channel.second);
-							_counter->fetch_sub(1);
+							BFCVisibilityCache::Block *cache = _cache ? &_cache->getBlock(channel.first, i) : nullptr;
+							factory->cullOnBlock(channel.first, culler, i, 1, channel.second, cache);
+							_counter->decrement();
 							BFCCullerMethod<CullerType>::Recycle(culler);
 						});
 					}
@@ -95,18 +113,102 @@ namespace AGE
 	private:
 		CullerType                               _culler;
 		std::map<CullableTypeID, std::vector<IBFCOutput*>> _channels;
-		std::atomic_size_t                       *_counter = nullptr;
+		TaskCounter                              *_counter = nullptr;
+		BFCVisibilityCache                       *_cache = nullptr;
 	};
 
 	// Cullers
 	//////////////////////////////////////////
 
+	enum class BFCBoundsTest
+	{
+		Outside,
+		Intersect,
+		Inside
+	};
+
 	template <typename T>
 	class BFCCullerMethod
 	{
 	public:
 		inline const BFCCullArray      &getArray() const { return _cullerArray; }
 		inline void                    reset() { _cullerArray.clear(); }
+		// default behavior : items are tested one by one
+		// cullers can hide it to treat the whole block at once
+		inline void                    cullBlock(const BFCBlock &block)
+		{
+			const BFCItem *items = block.getItems();
+			for (ItemID i = 0; i < MaxItemID; ++i)
+			{
+				static_cast<T*>(this)->cullItem(items[i]);
+			}
+		}
+		// default behavior : bounds can't be tested, items are culled
+		inline BFCBoundsTest           testBounds(const BFCBlockBounds &)
+		{
+			return BFCBoundsTest::Intersect;
+		}
+		// all the items of the block pass the test
+		inline void                    acceptBlock(const BFCBlock &block)
+		{
+			const BFCItem *items = block.getItems();
+			for (ItemID i = 0; i < MaxItemID; ++i)
+			{
+				if (items[i].getDrawable())
+				{
+					_cullerArray.push(items[i]);
+				}
+			}
+		}
+		// reuse the result of the last frame if the block did not change
+		// the cache is prepared with the view, so it is dropped when the view move
+		inline void                    cullBlockCached(const BFCBlock &block, BFCVisibilityCache::Block &cache)
+		{
+			if (BFCCullingConfig::g_visibility_cache_is_enabled == false || block.isDynamic() || block.isDirty())
+			{
+				cache.valid = false;
+				cullBlockWithBounds(block);
+				return;
+			}
+			if (cache.valid && cache.version == block.getVersion())
+			{
+				for (auto &item : cache.items)
+				{
+					_cullerArray.push(item);
+				}
+				return;
+			}
+			const ItemID from = _cullerArray.size();
+			cullBlockWithBounds(block);
+			cache.items.assign(_cullerArray.data() + from, _cullerArray.data() + _cullerArray.size());
+			cache.version = block.getVersion();
+			cache.valid = true;
+		}
+		inline void                    cullBlockWithBounds(const BFCBlock &block)
+		{
+			T *self = static_cast<T*>(this);
+			// bounds of dirty blocks are not up to date
+			if (BFCCullingConfig::g_block_bounds_is_enabled == false || block.isDirty())
+			{
+				self->cullBlock(block);
+				return;
+			}
+			if (block.getBounds().empty())
+			{
+				return;
+			}
+			switch (self->testBounds(block.getBounds()))
+			{
+			case BFCBoundsTest::Outside:
+				break;
+			case BFCBoundsTest::Inside:
+				self->acceptBlock(block);
+				break;
+			default:
+				self->cullBlock(block);
+				break;
+			}
+		}
 		static T                       *GetNewCullerMethod()
 		{
 			T *t;
@@ -0,0 +1,14 @@
+#include "BFCCullingOptions.hpp"
+
+namespace AGE
+{
+	bool BFCCullingConfig::g_SIMD_is_enabled = true;
+	bool BFCCullingConfig::g_sort_keys_is_enabled = true;
+	bool BFCCullingConfig::g_block_bounds_is_enabled = true;
+	bool BFCCullingConfig::g_spatial_blocks_is_enabled = true;
+	float BFCCullingConfig::g_block_cell_size = 64.0f;
+	bool BFCCullingConfig::g_static_partition_is_enabled = true;
+	unsigned int BFCCullingConfig::g_static_frames = 30;
+	bool BFCCullingConfig::g_visibility_cache_is_enabled = true;
+	float BFCCullingConfig::g_visibility_cache_threshold = 0.00001f;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+namespace AGE
+{
+	class BFCCullingConfig
+	{
+	public:
+		// Frustum cullers test the SoA spheres of each block
+		// 4 or 8 at a time instead of testing items one by one
+		static bool g_SIMD_is_enabled;
+		// Outputs sort 64 bits keys with a radix sort per culled chunk
+		// and merge the sorted chunks instead of sorting all the items again
+		static bool g_sort_keys_is_enabled;
+		// Cullers test the block bounds first to reject or accept
+		// all the block items at once
+		static bool g_block_bounds_is_enabled;
+		// Items are moved in blocks grouping them by grid cell
+		static bool g_spatial_blocks_is_enabled;
+		static float g_block_cell_size;
+		// Items which did not move for g_static_frames updates are kept
+		// in static blocks, the others in dynamic blocks
+		static bool g_static_partition_is_enabled;
+		static unsigned int g_static_frames;
+		// Cullers with a visibility cache reuse the results of the
+		// static blocks which did not change when their frustum did not change
+		static bool g_visibility_cache_is_enabled;
+		static float g_visibility_cache_threshold;
+	};
+}
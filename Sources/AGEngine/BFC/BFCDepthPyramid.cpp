@@ -0,0 +1,121 @@
+#include "BFCDepthPyramid.hpp"
+
+#include "Utils/Profiler.hpp"
+
+#include <algorithm>
+
+namespace AGE
+{
+	void BFCDepthPyramid::buildFromDepthStencil(const std::uint32_t *pixels, std::size_t width, std::size_t height, const glm::mat4 &viewProj)
+	{
+		SCOPE_profile_cpu_function("BFC");
+
+		_levels.resize(1);
+		auto &base = _levels[0];
+		base.width = width;
+		base.height = height;
+		base.depths.resize(width * height);
+		const float toFloat = 1.0f / float(0xFFFFFF);
+		for (std::size_t i = 0; i < width * height; ++i)
+		{
+			base.depths[i] = float(pixels[i] >> 8) * toFloat;
+		}
+		_viewProj = viewProj;
+		_buildLevels();
+	}
+
+	void BFCDepthPyramid::build(const float *depths, std::size_t width, std::size_t height, const glm::mat4 &viewProj)
+	{
+		SCOPE_profile_cpu_function("BFC");
+
+		_levels.resize(1);
+		auto &base = _levels[0];
+		base.width = width;
+		base.height = height;
+		base.depths.assign(depths, depths + width * height);
+		_viewProj = viewProj;
+		_buildLevels();
+	}
+
+	void BFCDepthPyramid::clear()
+	{
+		_levels.clear();
+	}
+
+	void BFCDepthPyramid::_buildLevels()
+	{
+		if (_levels[0].width == 0 || _levels[0].height == 0)
+		{
+			_levels.clear();
+			return;
+		}
+		while (_levels.back().width > 1 || _levels.back().height > 1)
+		{
+			_levels.emplace_back();
+			const Level &src = _levels[_levels.size() - 2];
+			Level &dst = _levels.back();
+			// odd sizes are rounded up, the last texel only covers one source texel
+			dst.width = (src.width + 1) / 2;
+			dst.height = (src.height + 1) / 2;
+			dst.depths.resize(dst.width * dst.height);
+
+			for (std::size_t y = 0; y < dst.height; ++y)
+			{
+				const std::size_t y0 = y * 2;
+				const std::size_t y1 = std::min(y0 + 1, src.height - 1);
+				const float *row0 = &src.depths[y0 * src.width];
+				const float *row1 = &src.depths[y1 * src.width];
+				float *out = &dst.depths[y * dst.width];
+				for (std::size_t x = 0; x < dst.width; ++x)
+				{
+					const std::size_t x0 = x * 2;
+					const std::size_t x1 = std::min(x0 + 1, src.width - 1);
+					out[x] = std::max(std::max(row0[x0], row0[x1]), std::max(row1[x0], row1[x1]));
+				}
+			}
+		}
+	}
+
+	bool BFCDepthPyramid::isOccluded(const glm::vec2 &min, const glm::vec2 &max, float depth) const
+	{
+		if (_levels.empty() || depth <= 0.0f)
+		{
+			return false;
+		}
+		const Level &base = _levels[0];
+		const glm::vec2 size(float(base.width), float(base.height));
+		const glm::vec2 from = glm::clamp(min, glm::vec2(0.0f), glm::vec2(1.0f)) * size;
+		const glm::vec2 to = glm::clamp(max, glm::vec2(0.0f), glm::vec2(1.0f)) * size;
+
+		std::size_t x0 = std::min(std::size_t(from.x), base.width - 1);
+		std::size_t y0 = std::min(std::size_t(from.y), base.height - 1);
+		std::size_t x1 = std::min(std::size_t(to.x), base.width - 1);
+		std::size_t y1 = std::min(std::size_t(to.y), base.height - 1);
+
+		// the level where the rect covers at most 2x2 texels
+		// (3x3 when it is not aligned on the texel grid)
+		std::size_t level = 0;
+		std::size_t extent = std::max(x1 - x0, y1 - y0);
+		while (extent > 1 && level + 1 < _levels.size())
+		{
+			extent >>= 1;
+			++level;
+		}
+		x0 >>= level; x1 >>= level;
+		y0 >>= level; y1 >>= level;
+
+		const Level &l = _levels[level];
+		for (std::size_t y = y0; y <= y1; ++y)
+		{
+			const float *row = &l.depths[y * l.width];
+			for (std::size_t x = x0; x <= x1; ++x)
+			{
+				if (depth <= row[x])
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+}
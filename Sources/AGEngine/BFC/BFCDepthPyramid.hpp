@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace AGE
+{
+	// Hierarchical depth buffer used for occlusion culling
+	// Level 0 is the source depth buffer, each next level keeps the farthest
+	// depth of the 2x2 texels under it, so testing against a coarse texel
+	// is conservative.
+	// Depths are in [0, 1] with 1 on the far plane (OpenGL default depth range).
+	// It does not depend on the GPU, it can be built from any depth buffer.
+	class BFCDepthPyramid
+	{
+	public:
+		struct Level
+		{
+			std::size_t width = 0;
+			std::size_t height = 0;
+			std::vector<float> depths;
+		};
+
+		// depth in the 24 high bits, like GL_UNSIGNED_INT_24_8 read backs
+		void buildFromDepthStencil(const std::uint32_t *pixels, std::size_t width, std::size_t height, const glm::mat4 &viewProj);
+		void build(const float *depths, std::size_t width, std::size_t height, const glm::mat4 &viewProj);
+		void clear();
+
+		// min and max in [0, 1] screen coordinates
+		// depth is the nearest depth of the tested bounds
+		bool isOccluded(const glm::vec2 &min, const glm::vec2 &max, float depth) const;
+
+		inline bool isValid() const { return _levels.empty() == false; }
+		// view projection of the frame the depth buffer comes from
+		inline const glm::mat4 &getViewProj() const { return _viewProj; }
+		inline std::size_t getLevelNumber() const { return _levels.size(); }
+		inline const Level &getLevel(std::size_t level) const { return _levels[level]; }
+	private:
+		void _buildLevels();
+
+		std::vector<Level> _levels;
+		glm::mat4 _viewProj;
+	};
+}
@@ -0,0 +1,183 @@
+#include "BFCFrustumCuller.hpp"
+
+#include "Utils/Profiler.hpp"
+
+#include <intrin.h>
+
+// AVX is used only if the compiler is allowed to (/arch:AVX)
+// SSE is always available on x64
+#if defined(__AVX__)
+# include <immintrin.h>
+# define AGE_BFC_CULLING_AVX
+#elif defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1) || defined(__SSE__)
+# include <xmmintrin.h>
+# define AGE_BFC_CULLING_SSE
+#endif
+
+namespace AGE
+{
+	void BFCFrustumCuller::cullBlock(const BFCBlock &block)
+	{
+		if (_useSimd)
+		{
+			_cullSpheres(block);
+		}
+		else
+		{
+			BFCCullerMethod<BFCFrustumCuller>::cullBlock(block);
+		}
+	}
+
+	BFCBoundsTest BFCFrustumCuller::testBounds(const BFCBlockBounds &bounds)
+	{
+		const glm::vec3 center = (bounds.min + bounds.max) * 0.5f;
+		const glm::vec3 extent = (bounds.max - bounds.min) * 0.5f;
+		BFCBoundsTest result = BFCBoundsTest::Inside;
+		for (int p = 0; p < Frustum::PlaneNumber; ++p)
+		{
+			auto &plane = _frustum.getPlane(p);
+			const glm::vec3 &n = plane.getNormal();
+			float d = glm::dot(n, center) + plane.getDistance();
+			float r = glm::dot(glm::abs(n), extent);
+			if (d + r < 0.0f)
+			{
+				return BFCBoundsTest::Outside;
+			}
+			if (d - r < 0.0f)
+			{
+				result = BFCBoundsTest::Intersect;
+			}
+		}
+		return result;
+	}
+
+	void BFCFrustumCuller::_pushAccepted(const BFCItem *items, ItemID from, unsigned int mask)
+	{
+		unsigned long bit;
+		while (_BitScanForward(&bit, mask))
+		{
+			mask &= mask - 1;
+			auto &item = items[from + bit];
+			if (item.getDrawable())
+			{
+				_cullerArray.push(item);
+			}
+		}
+	}
+
+#if defined(AGE_BFC_CULLING_AVX)
+
+	void BFCFrustumCuller::_cullSpheres(const BFCBlock &block)
+	{
+		const BFCBlockSpheres &spheres = block.getSpheres();
+		const BFCItem *items = block.getItems();
+
+		__m256 nx[Frustum::PlaneNumber];
+		__m256 ny[Frustum::PlaneNumber];
+		__m256 nz[Frustum::PlaneNumber];
+		__m256 nd[Frustum::PlaneNumber];
+		for (int p = 0; p < Frustum::PlaneNumber; ++p)
+		{
+			auto &plane = _frustum.getPlane(p);
+			nx[p] = _mm256_set1_ps(plane.getNormal().x);
+			ny[p] = _mm256_set1_ps(plane.getNormal().y);
+			nz[p] = _mm256_set1_ps(plane.getNormal().z);
+			nd[p] = _mm256_set1_ps(plane.getDistance());
+		}
+		const __m256 zero = _mm256_setzero_ps();
+
+		for (ItemID i = 0; i < MaxItemID; i += 8)
+		{
+			const __m256 x = _mm256_loadu_ps(&spheres.x[i]);
+			const __m256 y = _mm256_loadu_ps(&spheres.y[i]);
+			const __m256 z = _mm256_loadu_ps(&spheres.z[i]);
+			const __m256 r = _mm256_loadu_ps(&spheres.radius[i]);
+
+			unsigned int mask = 0xFF;
+			for (int p = 0; p < Frustum::PlaneNumber && mask != 0; ++p)
+			{
+				// dist + radius >= 0 for every plane
+				__m256 d = _mm256_add_ps(
+					_mm256_add_ps(_mm256_mul_ps(x, nx[p]), _mm256_mul_ps(y, ny[p])),
+					_mm256_add_ps(_mm256_mul_ps(z, nz[p]), _mm256_add_ps(nd[p], r)));
+				mask &= (unsigned int)_mm256_movemask_ps(_mm256_cmp_ps(d, zero, _CMP_GE_OQ));
+			}
+			_pushAccepted(items, i, mask);
+		}
+	}
+
+#elif defined(AGE_BFC_CULLING_SSE)
+
+	void BFCFrustumCuller::_cullSpheres(const BFCBlock &block)
+	{
+		const BFCBlockSpheres &spheres = block.getSpheres();
+		const BFCItem *items = block.getItems();
+
+		__m128 nx[Frustum::PlaneNumber];
+		__m128 ny[Frustum::PlaneNumber];
+		__m128 nz[Frustum::PlaneNumber];
+		__m128 nd[Frustum::PlaneNumber];
+		for (int p = 0; p < Frustum::PlaneNumber; ++p)
+		{
+			auto &plane = _frustum.getPlane(p);
+			nx[p] = _mm_set1_ps(plane.getNormal().x);
+			ny[p] = _mm_set1_ps(plane.getNormal().y);
+			nz[p] = _mm_set1_ps(plane.getNormal().z);
+			nd[p] = _mm_set1_ps(plane.getDistance());
+		}
+		const __m128 zero = _mm_setzero_ps();
+
+		for (ItemID i = 0; i < MaxItemID; i += 4)
+		{
+			const __m128 x = _mm_loadu_ps(&spheres.x[i]);
+			const __m128 y = _mm_loadu_ps(&spheres.y[i]);
+			const __m128 z = _mm_loadu_ps(&spheres.z[i]);
+			const __m128 r = _mm_loadu_ps(&spheres.radius[i]);
+
+			unsigned int mask = 0xF;
+			for (int p = 0; p < Frustum::PlaneNumber && mask != 0; ++p)
+			{
+				// dist + radius >= 0 for every plane
+				__m128 d = _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(x, nx[p]), _mm_mul_ps(y, ny[p])),
+					_mm_add_ps(_mm_mul_ps(z, nz[p]), _mm_add_ps(nd[p], r)));
+				mask &= (unsigned int)_mm_movemask_ps(_mm_cmpge_ps(d, zero));
+			}
+			_pushAccepted(items, i, mask);
+		}
+	}
+
+#else
+
+	// scalar fallback, still benefits from SoA layout
+	void BFCFrustumCuller::_cullSpheres(const BFCBlock &block)
+	{
+		const BFCBlockSpheres &spheres = block.getSpheres();
+		const BFCItem *items = block.getItems();
+
+		for (ItemID i = 0; i < MaxItemID; i += 4)
+		{
+			unsigned int mask = 0;
+			for (ItemID j = 0; j < 4; ++j)
+			{
+				bool inside = true;
+				for (int p = 0; p < Frustum::PlaneNumber && inside; ++p)
+				{
+					auto &plane = _frustum.getPlane(p);
+					float d = plane.getNormal().x * spheres.x[i + j]
+						+ plane.getNormal().y * spheres.y[i + j]
+						+ plane.getNormal().z * spheres.z[i + j]
+						+ plane.getDistance() + spheres.radius[i + j];
+					inside = d >= 0.0f;
+				}
+				if (inside)
+				{
+					mask |= 1 << j;
+				}
+			}
+			_pushAccepted(items, i, mask);
+		}
+	}
+
+#endif
+}
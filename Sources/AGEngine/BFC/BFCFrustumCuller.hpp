@@ -2,14 +2,21 @@
 
 #include "Utils/Frustum.hh"
 
+#include "BFC/BFCCuller.hpp"
+#include "BFC/BFCCullingOptions.hpp"
+
 namespace AGE
 {
 	class BFCFrustumCuller : public BFCCullerMethod<BFCFrustumCuller>
 	{
 	public:
+		BFCFrustumCuller()
+			: _useSimd(BFCCullingConfig::g_SIMD_is_enabled)
+		{}
 		void prepareForCulling(const Frustum &frustum)
 		{
 			_frustum = frustum;
+			_useSimd = BFCCullingConfig::g_SIMD_is_enabled;
 		}
 		inline void cullItem(const BFCItem &item)
 		{
@@ -18,12 +25,22 @@ namespace AGE
 				_cullerArray.push(item);
 			}
 		}
+		// test the whole block using its SoA spheres
+		// fallback on per item test if simd is disabled
+		void cullBlock(const BFCBlock &block);
+		BFCBoundsTest testBounds(const BFCBlockBounds &bounds);
+		inline void setSimdEnabled(bool enabled) { _useSimd = enabled; }
 		BFCFrustumCuller &operator=(BFCFrustumCuller &o)
 		{
 			_frustum = o._frustum;
+			_useSimd = o._useSimd;
 			return *this;
 		}
 	private:
+		void _cullSpheres(const BFCBlock &block);
+		void _pushAccepted(const BFCItem *items, ItemID from, unsigned int mask);
+
 		Frustum            _frustum;
+		bool               _useSimd;
 	};
-}
\ No newline at end of file
+}
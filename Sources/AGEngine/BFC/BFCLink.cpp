@@ -66,7 +66,6 @@ namespace AGE
 	{
 		popAnObject(handle);
 		_bfcBlockFactory->deleteItem(handle);
-		unregisterFromTracker();
 	}
 
 	// dangerous !
@@ -92,7 +91,9 @@ namespace AGE
 
 		std::swap(_cullables[i], _cullables.back());
 		_cullables.pop_back();
-		unregisterFromTracker();
+		// the link stays in the tracker : a dirty link is only registered once,
+		// by the move that made it dirty, removing it would leave it and its children
+		// dirty and untracked. The tracker drops it at its next update anyway.
 	}
 
 	void BFCLink::resetBFCTrackerIndex()
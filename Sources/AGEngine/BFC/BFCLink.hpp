@@ -32,10 +32,15 @@ namespace AGE
 		inline glm::mat4 getTransform() const { return _globalTransformation; }
 	protected:
 		void registerToTracker();
+		// only when the link is destroyed, the tracker must update the dirty links
 		void unregisterFromTracker();
 
 		// called by LinkTracker
 		void resetBFCTrackerIndex();
+		// called by LinkTracker, level by level : parents are up to date
+		virtual void computeGlobalTransform() = 0;
+		// number of parents
+		virtual std::size_t getHierarchyDepth() const = 0;
 
 		glm::mat4 _globalTransformation;
 	private:
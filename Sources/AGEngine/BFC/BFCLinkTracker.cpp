@@ -8,8 +8,17 @@
 #include <Utils/Debug.hpp>
 #include <Utils/Profiler.hpp>
 
+#include <Threads/TaskScheduler.hpp>
+#include <Threads/Tasks/BasicTasks.hpp>
+#include <TMQ/queue.hpp>
+
+#include <algorithm>
+
 namespace AGE
 {
+	// links updated by one task, small levels are updated on the calling thread
+	static const std::size_t g_bfcLinksPerTask = 256;
+
 	BFCLinkTracker::BFCLinkTracker()
 	{}
 
@@ -46,23 +55,50 @@ namespace AGE
 	{
 		SCOPE_profile_cpu_function("BFC");
 		{
-			SCOPE_profile_cpu_i("BFC", "ResetLinks");
+			SCOPE_profile_cpu_i("BFC", "SortLinks");
+			for (auto &level : _levels)
+			{
+				level.clear();
+			}
 			for (auto &e : _links)
 			{
-				// beurk
 				if (e != nullptr)
 				{
-					e->resetBFCTrackerIndex();
-					for (auto &cullable : e->_cullables)
+					auto depth = e->getHierarchyDepth();
+					if (_levels.size() <= depth)
 					{
-						auto &item = e->_bfcBlockFactory->getItem(cullable.getItemId());
-						item.setPosition(cullable.getPtr()->setBFCTransform(e->_globalTransformation));
+						_levels.resize(depth + 1);
 					}
-					e = nullptr;
+					_levels[depth].push_back(e);
 				}
 			}
 			_links.clear();
 		}
+		{
+			SCOPE_profile_cpu_i("BFC", "UpdateLinks");
+			for (auto &level : _levels)
+			{
+				if (level.size() < g_bfcLinksPerTask * 2)
+				{
+					_updateLinks(level.data(), level.size());
+					continue;
+				}
+				// parents are in the previous levels, so links of a level are independent
+				TaskCounter counter;
+				for (std::size_t i = 0; i < level.size(); i += g_bfcLinksPerTask)
+				{
+					BFCLink **links = level.data() + i;
+					std::size_t number = std::min(g_bfcLinksPerTask, level.size() - i);
+					counter.increment();
+					TMQ::TaskManager::emplaceSharedTask<Tasks::Basic::VoidFunction>([links, number, &counter]()
+					{
+						_updateLinks(links, number);
+						counter.decrement();
+					});
+				}
+				WaitForCounter(counter);
+			}
+		}
 		{
 			SCOPE_profile_cpu_i("BFC", "ResetFree");
 			//beurk
@@ -71,4 +107,18 @@ namespace AGE
 		}
 	}
 
-}
\ No newline at end of file
+	void BFCLinkTracker::_updateLinks(BFCLink **links, std::size_t number)
+	{
+		SCOPE_profile_cpu_i("BFC", "UpdateLinksTask");
+		for (std::size_t i = 0; i < number; ++i)
+		{
+			BFCLink *e = links[i];
+			e->resetBFCTrackerIndex();
+			e->computeGlobalTransform();
+			for (auto &cullable : e->_cullables)
+			{
+				e->_bfcBlockFactory->setItemPosition(cullable.getItemId(), cullable.getPtr()->setBFCTransform(e->_globalTransformation));
+			}
+		}
+	}
+}
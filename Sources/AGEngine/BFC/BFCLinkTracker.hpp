@@ -13,10 +13,16 @@ namespace AGE
 		BFCLinkTracker();
 		std::size_t addLink(BFCLink *link);
 		void removeLink(std::size_t link);
+		// compute the global transform of the modified links and
+		// write it in their BFC items
+		// links are sorted by depth, each level is updated in parallel
 		void reset();
 		inline std::size_t getLinkCount() const { return _links.size(); }
 	private:
+		static void _updateLinks(BFCLink **links, std::size_t number);
+
 		std::vector<BFCLink*> _links;
 		std::queue<std::size_t> _free;
+		std::vector<std::vector<BFCLink*>> _levels;
 	};
 }
\ No newline at end of file
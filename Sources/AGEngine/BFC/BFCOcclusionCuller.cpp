@@ -0,0 +1,238 @@
+#include "BFCOcclusionCuller.hpp"
+
+#include "Utils/Profiler.hpp"
+
+#include <algorithm>
+
+// same rules than BFCFrustumCuller, SSE is always available on x64
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1) || defined(__SSE__)
+# include <xmmintrin.h>
+# define AGE_BFC_OCCLUSION_SSE
+#endif
+
+namespace AGE
+{
+	namespace
+	{
+		// bounds closer than that to the eye plane are considered visible
+		const float g_occlusionNearW = 0.0001f;
+	}
+
+	BFCOcclusionCuller::BFCOcclusionCuller()
+		: _useSimd(BFCCullingConfig::g_SIMD_is_enabled)
+	{
+	}
+
+	void BFCOcclusionCuller::prepareForCulling(const Frustum &frustum, const BFCDepthPyramid *pyramid)
+	{
+		_frustumCuller.prepareForCulling(frustum);
+		_pyramid = (pyramid && pyramid->isValid()) ? pyramid : nullptr;
+		_useSimd = BFCCullingConfig::g_SIMD_is_enabled;
+		if (_pyramid)
+		{
+			_viewProj = _pyramid->getViewProj();
+			for (int i = 0; i < 4; ++i)
+			{
+				_rowLengths[i] = glm::length(glm::vec3(_viewProj[0][i], _viewProj[1][i], _viewProj[2][i]));
+			}
+		}
+	}
+
+	void BFCOcclusionCuller::cullItem(const BFCItem &item)
+	{
+		_frustumCuller.reset();
+		_frustumCuller.cullItem(item);
+		auto &visible = _frustumCuller.getArray();
+		_cullOccluded(visible.data(), visible.size());
+	}
+
+	void BFCOcclusionCuller::cullBlock(const BFCBlock &block)
+	{
+		_frustumCuller.reset();
+		_frustumCuller.cullBlock(block);
+		auto &visible = _frustumCuller.getArray();
+		_cullOccluded(visible.data(), visible.size());
+	}
+
+	BFCBoundsTest BFCOcclusionCuller::testBounds(const BFCBlockBounds &bounds)
+	{
+		BFCBoundsTest result = _frustumCuller.testBounds(bounds);
+		if (result == BFCBoundsTest::Outside || _pyramid == nullptr)
+		{
+			return result;
+		}
+		const glm::vec3 center = (bounds.min + bounds.max) * 0.5f;
+		const glm::vec3 extent = (bounds.max - bounds.min) * 0.5f;
+		glm::vec4 clipExtent;
+		for (int i = 0; i < 4; ++i)
+		{
+			clipExtent[i] = glm::dot(glm::abs(glm::vec3(_viewProj[0][i], _viewProj[1][i], _viewProj[2][i])), extent);
+		}
+		if (_isOccluded(_viewProj * glm::vec4(center, 1.0f), clipExtent))
+		{
+			return BFCBoundsTest::Outside;
+		}
+		return result;
+	}
+
+	void BFCOcclusionCuller::acceptBlock(const BFCBlock &block)
+	{
+		// in the frustum, but items can still be occluded
+		_frustumCuller.reset();
+		_frustumCuller.acceptBlock(block);
+		auto &visible = _frustumCuller.getArray();
+		_cullOccluded(visible.data(), visible.size());
+	}
+
+	// center and extent in clip space
+	// the extent is conservative, the projected rect contains the bounds
+	bool BFCOcclusionCuller::_isOccluded(const glm::vec4 &center, const glm::vec4 &extent) const
+	{
+		const float wMin = center.w - extent.w;
+		if (wMin <= g_occlusionNearW)
+		{
+			return false;
+		}
+		const float wMax = center.w + extent.w;
+		const glm::vec3 low = glm::vec3(center) - glm::vec3(extent);
+		const glm::vec3 high = glm::vec3(center) + glm::vec3(extent);
+		const glm::vec3 ndcMin = glm::min(low / wMin, low / wMax);
+		const glm::vec3 ndcMax = glm::max(high / wMin, high / wMax);
+
+		// the depth buffer knows nothing outside of its screen
+		if (ndcMin.x < -1.0f || ndcMin.y < -1.0f || ndcMax.x > 1.0f || ndcMax.y > 1.0f)
+		{
+			return false;
+		}
+		return _pyramid->isOccluded(glm::vec2(ndcMin) * 0.5f + 0.5f, glm::vec2(ndcMax) * 0.5f + 0.5f, ndcMin.z * 0.5f + 0.5f);
+	}
+
+#if defined(AGE_BFC_OCCLUSION_SSE)
+
+	void BFCOcclusionCuller::_cullOccluded(const BFCItem *items, ItemID number)
+	{
+		if (_pyramid == nullptr)
+		{
+			for (ItemID i = 0; i < number; ++i)
+			{
+				_cullerArray.push(items[i]);
+			}
+			return;
+		}
+		if (_useSimd == false)
+		{
+			for (ItemID i = 0; i < number; ++i)
+			{
+				const glm::vec4 sphere = items[i].getPosition();
+				if (_isOccluded(_viewProj * glm::vec4(glm::vec3(sphere), 1.0f), _rowLengths * sphere.w) == false)
+				{
+					_cullerArray.push(items[i]);
+				}
+			}
+			return;
+		}
+
+		__m128 row[4];
+		__m128 length[4];
+		for (int i = 0; i < 4; ++i)
+		{
+			row[i] = _mm_setr_ps(_viewProj[0][i], _viewProj[1][i], _viewProj[2][i], _viewProj[3][i]);
+			length[i] = _mm_set1_ps(_rowLengths[i]);
+		}
+		const __m128 nearW = _mm_set1_ps(g_occlusionNearW);
+		const __m128 minusOne = _mm_set1_ps(-1.0f);
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 half = _mm_set1_ps(0.5f);
+
+		__declspec(align(16)) float spheres[4][4];
+		__declspec(align(16)) float rect[4][4];
+		__declspec(align(16)) float depth[4];
+
+		for (ItemID i = 0; i < number; i += 4)
+		{
+			const ItemID count = std::min(ItemID(4), ItemID(number - i));
+			for (ItemID j = 0; j < 4; ++j)
+			{
+				// the last group is padded with the last item
+				const glm::vec4 sphere = items[i + std::min(j, ItemID(count - 1))].getPosition();
+				_mm_store_ps(spheres[j], _mm_setr_ps(sphere.x, sphere.y, sphere.z, sphere.w));
+			}
+			__m128 x = _mm_load_ps(spheres[0]);
+			__m128 y = _mm_load_ps(spheres[1]);
+			__m128 z = _mm_load_ps(spheres[2]);
+			__m128 r = _mm_load_ps(spheres[3]);
+			_MM_TRANSPOSE4_PS(x, y, z, r);
+
+			// clip space center and extent of the 4 spheres
+			__m128 center[4];
+			__m128 extent[4];
+			for (int k = 0; k < 4; ++k)
+			{
+				const __m128 rx = _mm_shuffle_ps(row[k], row[k], _MM_SHUFFLE(0, 0, 0, 0));
+				const __m128 ry = _mm_shuffle_ps(row[k], row[k], _MM_SHUFFLE(1, 1, 1, 1));
+				const __m128 rz = _mm_shuffle_ps(row[k], row[k], _MM_SHUFFLE(2, 2, 2, 2));
+				const __m128 rw = _mm_shuffle_ps(row[k], row[k], _MM_SHUFFLE(3, 3, 3, 3));
+				center[k] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, x), _mm_mul_ps(ry, y)), _mm_add_ps(_mm_mul_ps(rz, z), rw));
+				extent[k] = _mm_mul_ps(length[k], r);
+			}
+
+			const __m128 wMin = _mm_sub_ps(center[3], extent[3]);
+			const __m128 wMax = _mm_add_ps(center[3], extent[3]);
+			// lanes crossing the eye plane are visible, avoid dividing by them
+			const __m128 inFront = _mm_cmpgt_ps(wMin, nearW);
+			const __m128 invMin = _mm_div_ps(one, _mm_or_ps(_mm_and_ps(inFront, wMin), _mm_andnot_ps(inFront, one)));
+			const __m128 invMax = _mm_div_ps(one, _mm_or_ps(_mm_and_ps(inFront, wMax), _mm_andnot_ps(inFront, one)));
+
+			__m128 ndcMin[3];
+			__m128 ndcMax[3];
+			for (int k = 0; k < 3; ++k)
+			{
+				const __m128 low = _mm_sub_ps(center[k], extent[k]);
+				const __m128 high = _mm_add_ps(center[k], extent[k]);
+				ndcMin[k] = _mm_min_ps(_mm_mul_ps(low, invMin), _mm_mul_ps(low, invMax));
+				ndcMax[k] = _mm_max_ps(_mm_mul_ps(high, invMin), _mm_mul_ps(high, invMax));
+			}
+
+			// the depth buffer knows nothing outside of its screen
+			__m128 onScreen = _mm_and_ps(_mm_cmpge_ps(ndcMin[0], minusOne), _mm_cmpge_ps(ndcMin[1], minusOne));
+			onScreen = _mm_and_ps(onScreen, _mm_and_ps(_mm_cmple_ps(ndcMax[0], one), _mm_cmple_ps(ndcMax[1], one)));
+			const unsigned int testMask = (unsigned int)_mm_movemask_ps(_mm_and_ps(inFront, onScreen));
+
+			_mm_store_ps(rect[0], _mm_add_ps(_mm_mul_ps(ndcMin[0], half), half));
+			_mm_store_ps(rect[1], _mm_add_ps(_mm_mul_ps(ndcMin[1], half), half));
+			_mm_store_ps(rect[2], _mm_add_ps(_mm_mul_ps(ndcMax[0], half), half));
+			_mm_store_ps(rect[3], _mm_add_ps(_mm_mul_ps(ndcMax[1], half), half));
+			_mm_store_ps(depth, _mm_add_ps(_mm_mul_ps(ndcMin[2], half), half));
+
+			for (ItemID j = 0; j < count; ++j)
+			{
+				if ((testMask & (1 << j))
+					&& _pyramid->isOccluded(glm::vec2(rect[0][j], rect[1][j]), glm::vec2(rect[2][j], rect[3][j]), depth[j]))
+				{
+					continue;
+				}
+				_cullerArray.push(items[i + j]);
+			}
+		}
+	}
+
+#else
+
+	void BFCOcclusionCuller::_cullOccluded(const BFCItem *items, ItemID number)
+	{
+		for (ItemID i = 0; i < number; ++i)
+		{
+			if (_pyramid)
+			{
+				const glm::vec4 sphere = items[i].getPosition();
+				if (_isOccluded(_viewProj * glm::vec4(glm::vec3(sphere), 1.0f), _rowLengths * sphere.w))
+				{
+					continue;
+				}
+			}
+			_cullerArray.push(items[i]);
+		}
+	}
+
+#endif
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "BFC/BFCCuller.hpp"
+#include "BFC/BFCFrustumCuller.hpp"
+#include "BFC/BFCDepthPyramid.hpp"
+
+namespace AGE
+{
+	// Frustum culling followed by a hierarchical-Z occlusion test
+	// Items in the frustum are projected with the view projection of the depth pyramid
+	// (the one of the frame it was read back from) and rejected if their nearest depth
+	// is behind the pyramid depth on all the texels they cover.
+	// Without pyramid it behaves like BFCFrustumCuller.
+	class BFCOcclusionCuller : public BFCCullerMethod<BFCOcclusionCuller>
+	{
+	public:
+		BFCOcclusionCuller();
+		// the pyramid have to outlive the culling tasks
+		void prepareForCulling(const Frustum &frustum, const BFCDepthPyramid *pyramid);
+		void cullItem(const BFCItem &item);
+		void cullBlock(const BFCBlock &block);
+		// blocks in the frustum are still tested for occlusion, with their bounds first
+		BFCBoundsTest testBounds(const BFCBlockBounds &bounds);
+		void acceptBlock(const BFCBlock &block);
+		BFCOcclusionCuller &operator=(BFCOcclusionCuller &o)
+		{
+			_frustumCuller = o._frustumCuller;
+			_pyramid = o._pyramid;
+			_viewProj = o._viewProj;
+			_rowLengths = o._rowLengths;
+			_useSimd = o._useSimd;
+			return *this;
+		}
+	private:
+		// test items 4 by 4, push the visible ones
+		void _cullOccluded(const BFCItem *items, ItemID number);
+		bool _isOccluded(const glm::vec4 &center, const glm::vec4 &extent) const;
+
+		BFCFrustumCuller       _frustumCuller;
+		const BFCDepthPyramid  *_pyramid = nullptr;
+		glm::mat4              _viewProj;
+		// length of the xyz part of each view projection row, to project sphere radius
+		glm::vec4              _rowLengths;
+		bool                   _useSimd;
+	};
+}
@@ -1,20 +1,44 @@
 #pragma once
 
 #include <atomic>
+#include <vector>
 #include <Utils/Containers/LFQueue.hpp>
 #include <Utils/Containers/LFVector.hpp>
 
 #include "BFCArray.hpp"
+#include "BFCSortKey.hpp"
+#include "BFCCullingOptions.hpp"
 
 namespace AGE
 {
+	// Point of view of an output, given to Treat
+	// so the treatment can depend on the viewer (lod selection)
+	struct BFCOutputView
+	{
+		glm::vec3 position = glm::vec3(0);
+		// projection[1][1], projected size = radius * projectionScale / distance
+		// 0 for views without perspective (no lod selection)
+		float projectionScale = 0.0f;
+		// height in pixels of the target, 0 for views that do not sample the materials
+		// (no texture residency request)
+		float viewportHeight = 0.0f;
+		// slot of the treatment states kept between frames (lod hysteresis)
+		// the culling tasks of all the views run together, so a slot
+		// can be used by only one view per frame
+		static const std::uint8_t NoSlot = 0xFF;
+		std::uint8_t slot = NoSlot;
+	};
+
 	/*
 	Model for RawInfos data structure
 	All this method have to be implemented
 	struct THIS_TYPE
 	{
-		static void Treat(const BFCItem &item, BFCArray<THIS_TYPE> &result);
+		static void Treat(const BFCItem &item, BFCArray<THIS_TYPE> &result, const BFCOutputView &view);
 		static bool Compare(const THIS_TYPE &a, const THIS_TYPE &b);
+		// key ordered like Compare, used by the radix sort
+		// collisions are allowed, commands are split with operator!=
+		static std::uint64_t SortKey(const THIS_TYPE &a);
 		static THIS_TYPE Invalid();
 		bool operator!=(const THIS_TYPE &o);
 	};
@@ -23,8 +47,9 @@ namespace AGE
 	// Example
 	struct EMPTY_BFCRawType
 	{
-		static bool Treat(const BFCItem &, BFCArray<EMPTY_BFCRawType> &){}
+		static bool Treat(const BFCItem &, BFCArray<EMPTY_BFCRawType> &, const BFCOutputView &){}
 		static bool Compare(const EMPTY_BFCRawType &a, const EMPTY_BFCRawType &b){ return true; }
+		static std::uint64_t SortKey(const EMPTY_BFCRawType &){ return 0; }
 		static EMPTY_BFCRawType Invalid() { return EMPTY_BFCRawType(); }
 		bool operator!=(const EMPTY_BFCRawType &o) { return true; }
 	};
@@ -46,6 +71,8 @@ namespace AGE
 		void treatCulledChunk(const BFCCullArray *array);
 		void treatCulledResult();
 		void setNumberOfBlocks(const std::size_t number);
+		inline void setView(const BFCOutputView &view) { _view = view; }
+		inline const BFCOutputView &getView() const { return _view; }
 
 		template <typename ResultType>
 		void setResultQueue(LFQueue<ResultType*> *resultQueue)
@@ -59,6 +86,7 @@ namespace AGE
 	protected:
 		std::atomic_size_t  _counter;
 		LFQueue<IBFCOutput*> *_resultQueue;
+		BFCOutputView        _view;
 	};
 
 	template <typename RawInfosType, std::size_t RawInfosNbr
@@ -69,6 +97,8 @@ namespace AGE
 		struct BFCOutputChunk
 		{
 			BFCArray<RawInfosType> rawChunck;
+			BFCSortEntry           keys[MaxItemID];
+			BFCSortEntry           tmpKeys[MaxItemID];
 			BFCOutput              *output;
 			inline void reset() { rawChunck.clear(); }
 		};
@@ -76,8 +106,14 @@ namespace AGE
 		inline void reset()
 		{
 			_rawInfos.clear();
+			_sortEntries.clear();
+			_sortRuns.clear();
+			_droppedItems = 0;
+			// latched here so all the chunks of a frame use the same path
+			_useSortKeys = BFCCullingConfig::g_sort_keys_is_enabled;
 			_counter = 0;
 			_resultQueue = nullptr;
+			_view = BFCOutputView();
 			_commandOutput.reset();
 		}
 
@@ -96,10 +132,15 @@ namespace AGE
 				for (ItemID i = 0; i < array->size(); ++i)
 				{
 					// return false if the array is full
-					if (RawInfosType::Treat((*array)[i], chunk->rawChunck) == false)
+					if (RawInfosType::Treat((*array)[i], chunk->rawChunck, _view) == false)
 						break;
 				}
 
+				if (_useSortKeys)
+				{
+					mergeChunckKeys(chunk);
+					return;
+				}
 				if (chunk->rawChunck.size() > 0)
 				{
 					std::sort(chunk->rawChunck.data(), (chunk->rawChunck.data() + chunk->rawChunck.size()), RawInfosType::Compare);
@@ -110,6 +151,12 @@ namespace AGE
 
 		virtual void _treatCulledResult()
 		{
+			if (_useSortKeys)
+			{
+				_treatCulledResultKeys();
+				return;
+			}
+			AGE_ASSERT(_droppedItems == 0 && "BFC output full, increase its RawInfosNbr");
 			if (_rawInfos.size() != 0)
 			{
 				std::sort(_rawInfos.data(), _rawInfos.data() + _rawInfos.size(), RawInfosType::Compare);
@@ -139,11 +186,42 @@ namespace AGE
 		{
 			if (chunck)
 			{
-				_rawInfos.pushChunk(chunck->rawChunck.data(), chunck->rawChunck.size());
+				const std::size_t size = chunck->rawChunck.size();
+				_droppedItems += size - _rawInfos.pushChunk(chunck->rawChunck.data(), size);
 				_chunckQueue.enqueue(chunck);
 			}
 		}
 
+		// datas are copied unsorted, only the keys are sorted
+		// and pushed as a sorted run, merged in _treatCulledResultKeys
+		void mergeChunckKeys(BFCOutputChunk *chunck)
+		{
+			const std::size_t size = chunck->rawChunck.size();
+			if (size > 0)
+			{
+				std::size_t offset = 0;
+				std::size_t pushed = _rawInfos.pushChunk(chunck->rawChunck.data(), size, offset);
+				_droppedItems += size - pushed;
+
+				for (std::size_t i = 0; i < pushed; ++i)
+				{
+					chunck->keys[i].key = RawInfosType::SortKey(chunck->rawChunck[ItemID(i)]);
+					chunck->keys[i].index = std::uint32_t(offset + i);
+				}
+				BFCRadixSort(chunck->keys, chunck->tmpKeys, pushed);
+
+				std::size_t runOffset = 0;
+				BFCSortRun run;
+				run.size = std::uint32_t(_sortEntries.pushChunk(chunck->keys, pushed, runOffset));
+				run.from = std::uint32_t(runOffset);
+				if (run.size > 0)
+				{
+					_sortRuns.push(run);
+				}
+			}
+			_chunckQueue.enqueue(chunck);
+		}
+
 		static BFCOutput *GetNewOutput()
 		{
 			BFCOutput *instance = nullptr;
@@ -162,11 +240,47 @@ namespace AGE
 			output->_isInUse = false;
 			getInstancePool().enqueue(output);
 		}
+		// items treated but not drawn because the output was full (RawInfosNbr)
+		inline std::size_t getDroppedItems() const { return _droppedItems; }
 		inline const CommandOutput &getCommandOutput() const { return _commandOutput; }
 		inline CommandOutput &getCommandOutput() { return _commandOutput; }
 	private:
+		void _treatCulledResultKeys()
+		{
+			AGE_ASSERT(_droppedItems == 0 && "BFC output full, increase its RawInfosNbr");
+			const std::size_t max = _sortEntries.size();
+			if (max == 0)
+			{
+				return;
+			}
+
+			_mergedEntries.resize(max);
+			BFCMergeSortedRuns(_sortEntries.data(), _sortRuns.data(), _sortRuns.size(), _mergedEntries.data());
+
+			RawInfosType lastInfos = RawInfosType::Invalid();
+
+			_commandOutput.begin();
+			for (std::size_t i = 0; i < max; ++i)
+			{
+				auto &c = _rawInfos[_mergedEntries[i].index];
+				if (c != lastInfos)
+				{
+					lastInfos = c;
+					_commandOutput.setKeyInfos(c);
+				}
+				_commandOutput.setCommandData(c);
+			}
+			_commandOutput.end();
+		}
+
 		static LFQueue<BFCOutputChunk*>	    _chunckQueue;
 		LFVector<RawInfosType, RawInfosNbr> _rawInfos;
+		// one sorted run of entries per culled chunk
+		LFVector<BFCSortEntry, RawInfosNbr> _sortEntries;
+		LFVector<BFCSortRun, RawInfosNbr>    _sortRuns;
+		std::vector<BFCSortEntry>           _mergedEntries;
+		std::atomic_size_t                  _droppedItems;
+		bool                                _useSortKeys = true;
 		CommandOutput                       _commandOutput;
 		bool                                _isInUse = false;
 
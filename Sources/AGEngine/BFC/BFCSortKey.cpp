@@ -0,0 +1,125 @@
+#include "BFCSortKey.hpp"
+
+#include <Utils/Profiler.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <cstring>
+
+namespace AGE
+{
+	void BFCRadixSort(BFCSortEntry *entries, BFCSortEntry *tmp, std::size_t size)
+	{
+		if (size < 2)
+		{
+			return;
+		}
+
+		// bits which are not the same for all the keys
+		std::uint64_t orKeys = 0;
+		std::uint64_t andKeys = ~std::uint64_t(0);
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			orKeys |= entries[i].key;
+			andKeys &= entries[i].key;
+		}
+		const std::uint64_t differentBits = orKeys ^ andKeys;
+
+		BFCSortEntry *from = entries;
+		BFCSortEntry *to = tmp;
+		for (std::uint32_t shift = 0; shift < 64; shift += 8)
+		{
+			if (((differentBits >> shift) & 0xFF) == 0)
+			{
+				continue;
+			}
+			std::size_t offsets[256];
+			memset(offsets, 0, sizeof(offsets));
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				++offsets[(from[i].key >> shift) & 0xFF];
+			}
+			std::size_t total = 0;
+			for (std::size_t d = 0; d < 256; ++d)
+			{
+				std::size_t count = offsets[d];
+				offsets[d] = total;
+				total += count;
+			}
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				to[offsets[(from[i].key >> shift) & 0xFF]++] = from[i];
+			}
+			std::swap(from, to);
+		}
+		if (from != entries)
+		{
+			memcpy(entries, from, size * sizeof(BFCSortEntry));
+		}
+	}
+
+	namespace
+	{
+		struct RunHead
+		{
+			std::uint64_t key;
+			std::uint32_t run;
+			std::uint32_t position;
+		};
+
+		// std heap is a max heap
+		inline bool RunHeadGreater(const RunHead &a, const RunHead &b)
+		{
+			if (a.key == b.key)
+			{
+				return a.run > b.run;
+			}
+			return a.key > b.key;
+		}
+	}
+
+	void BFCMergeSortedRuns(const BFCSortEntry *entries, const BFCSortRun *runs, std::size_t runNumber, BFCSortEntry *result)
+	{
+		SCOPE_profile_cpu_function("BFC");
+
+		if (runNumber == 1)
+		{
+			memcpy(result, entries + runs[0].from, runs[0].size * sizeof(BFCSortEntry));
+			return;
+		}
+
+		std::vector<RunHead> heap;
+		heap.reserve(runNumber);
+		for (std::size_t i = 0; i < runNumber; ++i)
+		{
+			if (runs[i].size > 0)
+			{
+				RunHead head;
+				head.key = entries[runs[i].from].key;
+				head.run = std::uint32_t(i);
+				head.position = 0;
+				heap.push_back(head);
+			}
+		}
+		std::make_heap(heap.begin(), heap.end(), RunHeadGreater);
+
+		std::size_t out = 0;
+		while (heap.empty() == false)
+		{
+			std::pop_heap(heap.begin(), heap.end(), RunHeadGreater);
+			RunHead &head = heap.back();
+			const BFCSortRun &run = runs[head.run];
+			result[out++] = entries[run.from + head.position];
+			++head.position;
+			if (head.position < run.size)
+			{
+				head.key = entries[run.from + head.position].key;
+				std::push_heap(heap.begin(), heap.end(), RunHeadGreater);
+			}
+			else
+			{
+				heap.pop_back();
+			}
+		}
+	}
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace AGE
+{
+	// 64 bits key used to sort culled items without moving their datas
+	// index is the position of the item in the output raw infos
+	struct BFCSortEntry
+	{
+		std::uint64_t key;
+		std::uint32_t index;
+	};
+
+	// sorted entries of one culled chunk
+	struct BFCSortRun
+	{
+		std::uint32_t from;
+		std::uint32_t size;
+	};
+
+	// Keys are truncated to fit in the 64 bits : two different values can have
+	// the same key, so command generation have to compare the real datas
+	inline std::uint64_t BFCSortKeyField(std::uint64_t value, std::uint32_t bits, std::uint32_t shift)
+	{
+		return (value & ((std::uint64_t(1) << bits) - 1)) << shift;
+	}
+
+	// pointers are at least 16 bytes aligned, low bits are always 0
+	inline std::uint64_t BFCSortKeyPointer(const void *ptr)
+	{
+		return std::uint64_t(reinterpret_cast<std::uintptr_t>(ptr)) >> 4;
+	}
+
+	// LSD radix sort on 8 bits digits, stable
+	// digits shared by all the keys are skipped
+	// result is in entries, tmp is a buffer of the same size
+	void BFCRadixSort(BFCSortEntry *entries, BFCSortEntry *tmp, std::size_t size);
+
+	// k-way merge of sorted runs into result
+	// stable : with equal keys, entries of the first runs come first
+	void BFCMergeSortedRuns(const BFCSortEntry *entries, const BFCSortRun *runs, std::size_t runNumber, BFCSortEntry *result);
+}
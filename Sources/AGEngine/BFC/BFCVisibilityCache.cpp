@@ -0,0 +1,49 @@
+#include "BFCVisibilityCache.hpp"
+#include "BFCCullingOptions.hpp"
+
+#include <cmath>
+
+namespace AGE
+{
+	void BFCVisibilityCache::prepare(const glm::mat4 &viewProj)
+	{
+		bool changed = _hasViewProj == false;
+		for (int c = 0; c < 4 && changed == false; ++c)
+		{
+			for (int r = 0; r < 4 && changed == false; ++r)
+			{
+				changed = std::abs(viewProj[c][r] - _viewProj[c][r]) > BFCCullingConfig::g_visibility_cache_threshold;
+			}
+		}
+		if (changed)
+		{
+			clear();
+			_viewProj = viewProj;
+			_hasViewProj = true;
+		}
+	}
+
+	void BFCVisibilityCache::resize(CullableTypeID channel, std::size_t blockNumber)
+	{
+		if (_channels.size() <= channel)
+		{
+			_channels.resize(channel + 1);
+		}
+		if (_channels[channel].size() < blockNumber)
+		{
+			_channels[channel].resize(blockNumber);
+		}
+	}
+
+	void BFCVisibilityCache::clear()
+	{
+		for (auto &channel : _channels)
+		{
+			for (auto &block : channel)
+			{
+				block.valid = false;
+				block.items.clear();
+			}
+		}
+	}
+}
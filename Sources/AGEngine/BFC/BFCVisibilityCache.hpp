@@ -0,0 +1,39 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "BFCItem.hpp"
+#include "BFCItemID.hpp"
+
+namespace AGE
+{
+	// Culling results of the static blocks for one view
+	// Results of a block are valid while the view matrix and the block version
+	// do not change, so they can be reused for static scenery
+	class BFCVisibilityCache
+	{
+	public:
+		struct Block
+		{
+			std::vector<BFCItem> items;
+			std::uint32_t        version = 0;
+			bool                 valid = false;
+		};
+
+		// call it before culling, results are dropped
+		// if the view moved more than the threshold
+		void prepare(const glm::mat4 &viewProj);
+		// size the cache before culling tasks access it
+		void resize(CullableTypeID channel, std::size_t blockNumber);
+		inline Block &getBlock(CullableTypeID channel, std::size_t block) { return _channels[channel][block]; }
+		void clear();
+
+	private:
+		glm::mat4                       _viewProj;
+		bool                            _hasViewProj = false;
+		std::vector<std::vector<Block>> _channels;
+	};
+}
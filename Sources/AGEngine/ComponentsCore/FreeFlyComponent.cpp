@@ -4,6 +4,8 @@ namespace AGE
 {
 	void FreeFlyComponent::init()
 	{
+		angles = glm::vec2(0.0f);
+		hasAngles = false;
 	}
 
 	void FreeFlyComponent::_copyFrom(const ComponentBase *model)
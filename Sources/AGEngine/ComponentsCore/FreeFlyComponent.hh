@@ -2,6 +2,7 @@
 
 #include <Components/Component.hh>
 #include <Utils/Serialization/SerializationArchives.hpp>
+#include <glm/glm.hpp>
 
 namespace AGE
 {
@@ -11,6 +12,9 @@ namespace AGE
 	{
 		AGE_COMPONENT_UNIQUE_IDENTIFIER("AGE_CORE_FreeFlyComponent");
 		size_t notEmpty;
+		// pitch and yaw of the camera, read from its orientation the first time it is updated
+		glm::vec2 angles;
+		bool hasAngles = false;
 
 		// never copied
 		virtual void _copyFrom(const ComponentBase *model);
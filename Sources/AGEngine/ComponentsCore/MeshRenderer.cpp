@@ -16,6 +16,7 @@
 #include "Graphic\DRBMeshData.hpp"
 #include "Graphic/DRBSkinnedMesh.hpp"
 #include "Utils/StringID.hpp"
+#include <algorithm>
 
 //tmp
 #include "Configuration.hpp"
@@ -99,6 +100,21 @@ namespace AGE
 		AGE_ASSERT(success, "You tried to update skinning matrix of a non skinned mesh.");
 	}
 
+	float MeshRenderer::consumeSkinnedScreenSize()
+	{
+		float size = 0.0f;
+		if (_drawableHandle.invalid())
+			return size;
+		for (auto &handle : _drawableHandle.getHandles())
+		{
+			if (handle.getPtr<DRBMesh>()->getDatas()->hadRenderMode(RenderModes::AGE_SKINNED))
+			{
+				size = std::max(size, handle.getPtr<DRBSkinnedMesh>()->consumeScreenSize());
+			}
+		}
+		return size;
+	}
+
 	void MeshRenderer::_copyFrom(const ComponentBase *model)
 	{
 		auto o = static_cast<const MeshRenderer*>(model);
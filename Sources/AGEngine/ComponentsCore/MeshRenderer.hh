@@ -44,6 +44,8 @@ namespace AGE
 		void disableRenderMode(RenderModes mode);
 
 		void setSkinningMatrix(std::size_t size);
+		// biggest screen size of the skinned meshes in the last culling, 0 if they were not visible
+		float consumeSkinnedScreenSize();
 
 		virtual void _copyFrom(const ComponentBase *destination);
 
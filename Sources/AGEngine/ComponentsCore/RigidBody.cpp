@@ -258,6 +258,10 @@ namespace AGE
 			entity->getScene()->getInstance<Physics::PhysicsInterface>()->getWorld()->destroyRigidBody(rigidBody);
 			rigidBody = nullptr;
 		}
+		// the component is reused, the poses read by the PhysicsSystem belong to the old body
+		hasSimulatedPose = false;
+		syncStamp = 0;
+		lastStepStamp = 0;
 		if (!entity->haveComponent<Collider>())
 		{
 			entity->removeComponent<Private::PhysicsData>();
@@ -153,6 +153,28 @@ namespace AGE
 		// Attributes
 		Physics::RigidBodyInterface *rigidBody = nullptr;
 
+		// Poses of the two last steps, the link is interpolated between them
+		glm::vec3 previousPosition;
+
+		glm::quat previousRotation;
+
+		glm::vec3 currentPosition;
+
+		glm::quat currentRotation;
+
+		// Pose before the last step of an update doing several steps, it becomes the previous pose
+		glm::vec3 lastStepPosition;
+
+		glm::quat lastStepRotation;
+
+		bool hasSimulatedPose = false;
+
+		// Last update of the PhysicsSystem that read the pose, a body can be reported once per step
+		std::size_t syncStamp = 0;
+
+		// Last update of the PhysicsSystem that read the pose before the last step
+		std::size_t lastStepStamp = 0;
+
 		// Methods
 		void setPosition(const glm::vec3 &position);
 
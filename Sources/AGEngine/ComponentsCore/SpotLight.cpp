@@ -106,14 +106,24 @@ namespace AGE
 
 	glm::mat4 SpotLightComponent::updateShadowMatrix()
 	{
-		float spotFov = glm::max(0.001f, (1.0f - cutOff) * glm::radians(180.0f));
-		// We add 30 degres to have the spot entierly in the frustum (otherwise it is circumscribed)
-		float adaptedFov = glm::min(spotFov + glm::radians(30.0f), glm::radians(179.9f));
+		float adaptedFov = _getShadowFov();
 		glm::mat4 invTransform = glm::inverse(entity->getLink().getGlobalTransform());
 		glm::mat4 spotViewProj = glm::perspective(adaptedFov, 1.0f, 0.1f, 1000.0f) * invTransform;
 		return (spotViewProj);
 	}
 
+	float SpotLightComponent::getShadowProjectionScale() const
+	{
+		return 1.0f / glm::tan(_getShadowFov() * 0.5f);
+	}
+
+	float SpotLightComponent::_getShadowFov() const
+	{
+		float spotFov = glm::max(0.001f, (1.0f - cutOff) * glm::radians(180.0f));
+		// We add 30 degres to have the spot entierly in the frustum (otherwise it is circumscribed)
+		return glm::min(spotFov + glm::radians(30.0f), glm::radians(179.9f));
+	}
+
 	glm::vec3 SpotLightComponent::getDirection() const
 	{
 		auto direction = glm::transpose(glm::inverse(glm::mat3(entity->getLink().getGlobalTransform()))) * glm::vec3(0.0f, 0.0f, -1.0f);
@@ -58,12 +58,16 @@ namespace AGE
 		inline float getExponent() const { return exponent; }
 
 		glm::mat4 updateShadowMatrix();
+		// projection[1][1] of the shadow matrix
+		float getShadowProjectionScale() const;
 		glm::vec3 getDirection() const;
 		glm::vec3 getColor() const;
 		glm::vec3 getPosition() const;
 		glm::vec3 getAttenuation() const;
 
 	private:
+		float _getShadowFov() const;
+
 		glm::vec4 color;
 		glm::vec3 range;
 		float exponent;
@@ -18,6 +18,15 @@ namespace AGE
 
 #define AGE_BFC
 
+// Comment to disable the chunk storage
+// In context entities are sorted in 16 KB chunks by component signature
+// and filters can iterate them with forEachChunk
+#define AGE_CHUNK_STORAGE
+
+// Comment to upload the skinning matrices as full 4x4 matrices
+// Bones are affine, so by default only their first 3 rows are sent to the GPU
+#define AGE_BONES_3X4
+
 // Enable if you want to activate OpenGL checks
 // like glCheckFramebufferStatus for example
 // #define AGE_CHECK_OPENGL_STATUS
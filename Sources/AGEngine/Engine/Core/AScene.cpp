@@ -55,14 +55,78 @@ namespace AGE
 		SCOPE_profile_cpu_function("Scenes");
 		{
 			SCOPE_profile_cpu_i("Scenes", _name.c_str());
+			if (SystemsConfig::g_parallel_update_is_enabled == false)
+			{
+				for (auto &e : _systems)
+				{
+					if (e.second->isActivated())
+					{
+						e.second->update(time);
+						e.second->synchronize(time);
+					}
+				}
+				return;
+			}
+			// exclusive systems split the update in batches
+			// systems of a batch run in parallel, except the conflicting ones
+			_systemBatch.clear();
 			for (auto &e : _systems)
 			{
-				if (e.second->isActivated())
-					e.second->update(time);
+				if (!e.second->isActivated())
+					continue;
+				if (e.second->hasDeclaredAccess())
+				{
+					_systemBatch.push_back(e.second.get());
+					continue;
+				}
+				_updateSystemBatch(time);
+				e.second->update(time);
+				e.second->synchronize(time);
 			}
+			_updateSystemBatch(time);
 		}
 	}
 
+	void                            AScene::_updateSystemBatch(float time)
+	{
+		if (_systemBatch.empty())
+			return;
+		if (_systemBatch.size() == 1)
+		{
+			_systemBatch.front()->update(time);
+			_systemBatch.front()->synchronize(time);
+			_systemBatch.clear();
+			return;
+		}
+
+		SCOPE_profile_cpu_i("Scenes", "Parallel systems");
+		// a system depends on every previous system of the batch it conflicts with,
+		// so conflicting writes keep the priority order of _systems
+		std::vector<TaskGraph::Job*> jobs(_systemBatch.size());
+		for (std::size_t i = 0; i < _systemBatch.size(); ++i)
+		{
+			SystemBase *system = _systemBatch[i];
+			jobs[i] = _systemGraph.addJob([system, time]()
+			{
+				system->update(time);
+			}, system->isMainThreadOnly());
+			for (std::size_t j = 0; j < i; ++j)
+			{
+				if (_systemBatch[j]->conflictWith(*system))
+					_systemGraph.addDependency(jobs[j], jobs[i]);
+			}
+		}
+		_systemGraph.launch();
+		_systemGraph.wait();
+		_systemGraph.reset();
+
+		for (auto system : _systemBatch)
+		{
+			system->synchronize(time);
+		}
+		_systemBatch.clear();
+	}
+
 	bool                    AScene::userStart()
 	{
 		SCOPE_profile_cpu_function("Scenes");
@@ -134,6 +198,9 @@ namespace AGE
 	void                    AScene::informFiltersComponentAddition(ComponentType id, const EntityData &entity)
 	{
 		SCOPE_profile_cpu_function("Scenes");
+#ifdef AGE_CHUNK_STORAGE
+		_chunkStorage.updateEntity(entity);
+#endif
 		for (auto &&f : _filters[id])
 		{
 			f->componentAdded(entity, id);
@@ -143,6 +210,9 @@ namespace AGE
 	void                    AScene::informFiltersComponentDeletion(ComponentType id, const EntityData &entity)
 	{
 		SCOPE_profile_cpu_function("Scenes");
+#ifdef AGE_CHUNK_STORAGE
+		_chunkStorage.updateEntity(entity);
+#endif
 		for (auto &&f : _filters[id])
 		{
 			f->componentRemoved(entity, id);
@@ -153,6 +223,9 @@ namespace AGE
 	void                    AScene::informFiltersEntityCreation(const EntityData &entity)
 	{
 		SCOPE_profile_cpu_function("Scenes");
+#ifdef AGE_CHUNK_STORAGE
+		_chunkStorage.addEntity(entity);
+#endif
 		for (auto &f : _allFilters)
 		{
 			f->entityAdded(entity);
@@ -162,6 +235,9 @@ namespace AGE
 	void                    AScene::informFiltersEntityDeletion(const EntityData &entity)
 	{
 		SCOPE_profile_cpu_function("Scenes");
+#ifdef AGE_CHUNK_STORAGE
+		_chunkStorage.removeEntity(entity);
+#endif
 		for (auto &f : _allFilters)
 		{
 			f->entityRemoved(entity);
@@ -205,6 +281,10 @@ namespace AGE
 		++data->entity.version;
 		data->entity.flags = 0;
 		_freeEntityId.push(e.id);
+#ifdef AGE_CHUNK_STORAGE
+		// removed first, so the storage do not move the entity for each deleted component
+		_chunkStorage.removeEntity(*data);
+#endif
 		for (ComponentType i = 0, mi = (ComponentType)data->components.size(); i < mi; ++i)
 		{
 			if (data->components[i])
@@ -22,6 +22,8 @@
 #include "Entity/EntityData.hh"
 
 #include "Core/ComponentManager.hpp"
+#include <Threads/TaskScheduler.hpp>
+#include <Entity/EntityChunkStorage.hpp>
 
 
 namespace AGE
@@ -50,6 +52,11 @@ namespace AGE
 		bool                                                                    _active;
 		std::unique_ptr<Link>                                                   _rootLink;
 		std::string                                                             _name;
+		TaskGraph                                                               _systemGraph;
+		std::vector<SystemBase*>                                                _systemBatch;
+#ifdef AGE_CHUNK_STORAGE
+		EntityChunkStorage                                                      _chunkStorage;
+#endif
 #ifdef AGE_BFC
 	protected:
 		BFCLinkTracker                                                          *_bfcLinkTracker;
@@ -61,10 +68,16 @@ namespace AGE
 	protected:
 		AGE::Engine *                                              _engine;
 		inline void setActive(bool tof) { _active = tof; }
+	private:
+		void                    _updateSystemBatch(float time);
+	protected:
 	public:
 #ifdef AGE_BFC
 		BFCLinkTracker *getBfcLinkTracker();
 		BFCBlockManagerFactory *getBfcBlockManagerFactory();
+#endif
+#ifdef AGE_CHUNK_STORAGE
+		inline const EntityChunkStorage &getChunkStorage() const { return _chunkStorage; }
 #endif
 		AScene(AGE::Engine *engine);
 		virtual ~AScene();
@@ -0,0 +1,58 @@
+#include "EntityCollection.hpp"
+
+namespace AGE
+{
+	const std::uint32_t EntityCollection::InvalidIndex;
+
+	EntityCollection::EntityCollection()
+	{
+	}
+
+	bool EntityCollection::insert(const Entity &entity)
+	{
+		const ENTITY_ID id = entity.getId();
+		if (_sparse.size() <= id)
+		{
+			// grow by steps to avoid a resize for each new id
+			_sparse.resize(std::size_t(id) + 1 + _sparse.size() / 2, InvalidIndex);
+		}
+		if (_sparse[id] != InvalidIndex)
+		{
+			return false;
+		}
+		_sparse[id] = std::uint32_t(_dense.size());
+		_dense.push_back(entity);
+		return true;
+	}
+
+	bool EntityCollection::erase(const Entity &entity)
+	{
+		const ENTITY_ID id = entity.getId();
+		if (_sparse.size() <= id || _sparse[id] == InvalidIndex)
+		{
+			return false;
+		}
+		const std::uint32_t index = _sparse[id];
+		const Entity &last = _dense.back();
+		_sparse[last.getId()] = index;
+		_dense[index] = last;
+		_dense.pop_back();
+		_sparse[id] = InvalidIndex;
+		return true;
+	}
+
+	bool EntityCollection::contains(const Entity &entity) const
+	{
+		const ENTITY_ID id = entity.getId();
+		return _sparse.size() > id && _sparse[id] != InvalidIndex;
+	}
+
+	void EntityCollection::clear()
+	{
+		for (auto &e : _dense)
+		{
+			_sparse[e.getId()] = InvalidIndex;
+		}
+		_dense.clear();
+	}
+}
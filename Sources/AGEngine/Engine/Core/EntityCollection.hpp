@@ -0,0 +1,44 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <Entity/Entity.hh>
+
+namespace AGE
+{
+	// Sparse set of entities
+	// - dense array of entities, iterated like a vector
+	// - sparse array indexed by entity id, giving the position in the dense array
+	// Insertion and removal are O(1), removal move the last entity in the hole
+	// so the order is not stable
+	class EntityCollection
+	{
+	public:
+		typedef std::vector<Entity>::const_iterator const_iterator;
+		typedef const_iterator iterator;
+
+		EntityCollection();
+
+		// return false if the entity was already in the collection
+		bool insert(const Entity &entity);
+		// return false if the entity was not in the collection
+		bool erase(const Entity &entity);
+		bool contains(const Entity &entity) const;
+		void clear();
+
+		inline std::size_t size() const { return _dense.size(); }
+		inline bool empty() const { return _dense.empty(); }
+		inline const Entity &operator[](std::size_t index) const { return _dense[index]; }
+		inline const Entity *data() const { return _dense.data(); }
+
+		inline const_iterator begin() const { return _dense.begin(); }
+		inline const_iterator end() const { return _dense.end(); }
+
+	private:
+		static const std::uint32_t InvalidIndex = std::uint32_t(-1);
+
+		std::vector<Entity> _dense;
+		std::vector<std::uint32_t> _sparse;
+	};
+}
@@ -6,6 +6,9 @@ namespace AGE
 	EntityFilter::EntityFilter(AScene *scene)
 		: _scene(scene)
 		, _locked(false)
+#ifdef AGE_CHUNK_STORAGE
+		, _testedChunkGroups(0)
+#endif
 	{
 		assert(_scene != nullptr && "System Scene is not valid.");
 		_scene->registerFilter(this);
@@ -15,26 +18,27 @@ namespace AGE
 	{
 	}
 
-	std::set<Entity> &EntityFilter::getCollection()
-	{
-		return _collection;
-	}
-
-	const std::set<Entity> &EntityFilter::getCollection() const
+	const EntityCollection &EntityFilter::getCollection() const
 	{
 		return _collection;
 	}
 
 	void EntityFilter::requireComponent(ComponentType typeId)
 	{
-		_barcode.insert(typeId);
+		_barcode.set(typeId);
 		_scene->filterSubscribe(typeId, this);
+#ifdef AGE_CHUNK_STORAGE
+		_resetChunkGroups();
+#endif
 	}
 
 	void EntityFilter::unRequireComponent(ComponentType typeId)
 	{
-		_barcode.erase(typeId);
+		_barcode.reset(typeId);
 		_scene->filterUnsubscribe(typeId, this);
+#ifdef AGE_CHUNK_STORAGE
+		_resetChunkGroups();
+#endif
 	}
 
 	void EntityFilter::requireTag(TAG_ID id)
@@ -55,12 +59,7 @@ namespace AGE
 
 	bool EntityFilter::match(const EntityData &e)
 	{
-		for (auto &b : _barcode)
-		{
-			if (!e.haveComponent(b))
-				return false;
-		}
-		return true;
+		return (e.getSignature() & _barcode) == _barcode;
 	}
 
 	void EntityFilter::componentAdded(const EntityData &e, ComponentType typeId)
@@ -68,12 +67,7 @@ namespace AGE
 
 		if (match(e))
 		{
-			if (_locked)
-			{
-				_toAdd.insert(e.entity);
-			}
-			else
-				_collection.insert(e.entity);
+			_add(e.entity);
 			if (_onAdd)
 				_onAdd(e.entity);
 		}
@@ -83,12 +77,7 @@ namespace AGE
 	{
 		if (!match(e))
 		{
-			if (_locked)
-			{
-				_trash.insert(e.entity);
-			}
-			else
-				_collection.erase(e.entity);
+			_remove(e.entity);
 			if (_onRemove)
 				_onRemove(e.entity);
 		}
@@ -98,12 +87,7 @@ namespace AGE
 	{
 		if (match(e))
 		{
-			if (_locked)
-			{
-				_toAdd.insert(e.entity);
-			}
-			else
-				_collection.insert(e.entity);
+			_add(e.entity);
 			if (_onAdd)
 				_onAdd(e.entity);
 		}
@@ -113,12 +97,7 @@ namespace AGE
 	{
 		if (!match(e))
 		{
-			if (_locked)
-			{
-				_trash.insert(e.entity);
-			}
-			else
-				_collection.erase(e.entity);
+			_remove(e.entity);
 			if (_onRemove)
 				_onRemove(e.entity);
 		}
@@ -126,14 +105,9 @@ namespace AGE
 
 	void EntityFilter::entityAdded(const EntityData &e)
 	{
-		if (this->_barcode.empty())
+		if (this->_barcode.none())
 		{
-			if (_locked)
-			{
-				_toAdd.insert(e.entity);
-			}
-			else
-				_collection.insert(e.entity);
+			_add(e.entity);
 			if (_onAdd)
 				_onAdd(e.entity);
 		}
@@ -141,24 +115,14 @@ namespace AGE
 
 	void EntityFilter::entityRemoved(const EntityData &e)
 	{
-		if (_locked)
-		{
-			_trash.insert(e.entity);
-		}
-		else
-			_collection.erase(e.entity);
+		_remove(e.entity);
 		if (_onRemove)
 			_onRemove(e.entity);
 	}
 
 	void EntityFilter::manuallyRemoveEntity(const Entity &e)
 	{
-		if (_locked)
-		{
-			_trash.insert(e);
-		}
-		else
-			_collection.erase(e);
+		_remove(e);
 		if (_onRemove)
 			_onRemove(e);
 	}
@@ -175,20 +139,66 @@ namespace AGE
 		if (!_locked)
 			return;
 		_locked = false;
-		for (auto &e : _toAdd)
+		for (auto &change : _lockedChanges)
 		{
-			_collection.insert(e);
+			if (change.add)
+				_collection.insert(change.entity);
+			else
+				_collection.erase(change.entity);
 		}
-		for (auto &e : _trash)
+		_lockedChanges.clear();
+	}
+
+	void EntityFilter::_add(const Entity &e)
+	{
+		if (_locked)
 		{
-			_collection.erase(e);
+			LockedChange change;
+			change.entity = e;
+			change.add = true;
+			_lockedChanges.push_back(change);
+		}
+		else
+			_collection.insert(e);
+	}
+
+	void EntityFilter::_remove(const Entity &e)
+	{
+		if (_locked)
+		{
+			LockedChange change;
+			change.entity = e;
+			change.add = false;
+			_lockedChanges.push_back(change);
 		}
-		_trash.clear();
-		_toAdd.clear();
+		else
+			_collection.erase(e);
 	}
 
 	bool EntityFilter::isLocked() const
 	{
 		return _locked;
 	}
+
+#ifdef AGE_CHUNK_STORAGE
+	const std::vector<EntityChunkGroup*> &EntityFilter::getChunkGroups()
+	{
+		auto &storage = _scene->getChunkStorage();
+		for (std::size_t mi = storage.getGroupNumber(); _testedChunkGroups < mi; ++_testedChunkGroups)
+		{
+			auto group = storage.getGroup(_testedChunkGroups);
+			if ((group->getSignature() & _barcode) == _barcode)
+			{
+				_chunkGroups.push_back(group);
+			}
+		}
+		return _chunkGroups;
+	}
+
+	void EntityFilter::_resetChunkGroups()
+	{
+		_chunkGroups.clear();
+		_testedChunkGroups = 0;
+	}
+#endif
 }
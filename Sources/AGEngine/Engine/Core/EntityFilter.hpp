@@ -1,9 +1,15 @@
 #pragma once
 
-#include <set>
+#include <vector>
 #include <Entity/Entity.hh>
 #include <functional>
 #include <Entity/EntityTypedef.hpp>
+#include <Core/EntityCollection.hpp>
+#include <Configuration.hpp>
+
+#ifdef AGE_CHUNK_STORAGE
+#include <Entity/EntityChunkStorage.hpp>
+#endif
 
 namespace AGE
 {
@@ -33,8 +39,8 @@ namespace AGE
 		void requireTag(TAG_ID tag);
 		void unRequireTag(TAG_ID tag);
 
-		std::set<Entity> &getCollection();
-		const std::set<Entity> &getCollection() const;
+		// Order is not stable, adding or removing an entity can move another one
+		const EntityCollection &getCollection() const;
 
 		inline void clearCollection() { _collection.clear(); }
 
@@ -53,6 +59,29 @@ namespace AGE
 
 		bool isLocked() const;
 
+#ifdef AGE_CHUNK_STORAGE
+		// Groups of chunks with all the required components,
+		// new groups are tested lazily when called
+		const std::vector<EntityChunkGroup*> &getChunkGroups();
+
+		// Entities and components must not be added or removed while iterating
+		template <typename Function>
+		void forEachChunk(Function &&function)
+		{
+			for (auto group : getChunkGroups())
+			{
+				for (std::size_t i = 0, mi = group->getChunkNumber(); i < mi; ++i)
+				{
+					const EntityChunk &chunk = group->getChunk(i);
+					if (!chunk.empty())
+					{
+						function(chunk);
+					}
+				}
+			}
+		}
+#endif
+
 		struct Lock
 		{
 			Lock(EntityFilter &filter)
@@ -75,8 +104,8 @@ namespace AGE
 		};
 
 	protected:
-		std::set<ComponentType> _barcode;
-		std::set<Entity> _collection;
+		ComponentSignature _barcode;
+		EntityCollection _collection;
 		AScene *_scene;
 
 		void lock();
@@ -85,10 +114,25 @@ namespace AGE
 		bool match(const EntityData &e);
 
 	private:
+		// changes done while locked, applied in order on unlock
+		struct LockedChange
+		{
+			Entity entity;
+			bool add;
+		};
+
 		bool _locked;
-		std::set<Entity> _trash;
-		std::set<Entity> _toAdd;
+		std::vector<LockedChange> _lockedChanges;
 		std::function<void(Entity e)> _onAdd;
 		std::function<void(Entity e)> _onRemove;
+#ifdef AGE_CHUNK_STORAGE
+		std::vector<EntityChunkGroup*> _chunkGroups;
+		std::size_t _testedChunkGroups;
+
+		void _resetChunkGroups();
+#endif
+
+		void _add(const Entity &e);
+		void _remove(const Entity &e);
 	};
 }
\ No newline at end of file
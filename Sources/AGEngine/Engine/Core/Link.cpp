@@ -79,7 +79,7 @@ void Link::internalSetPosition(const glm::vec3 &v, bool recalculate)
 	_position = v;
 	if (recalculate)
 	{
-		_updateGlobalTransform();
+		_invalidateGlobalTransform();
 	}
 }
 
@@ -95,7 +95,7 @@ void Link::internalSetForward(const glm::vec3 &v, bool recalculate)
 	_position.z = _position.z + get.z;
 	if (recalculate)
 	{
-		_updateGlobalTransform();
+		_invalidateGlobalTransform();
 	}
 }
 
@@ -116,7 +116,7 @@ void Link::internalSetTransform(const glm::mat4 &t, bool recalculate)
 	_localTransformation = t;
 	if (recalculate)
 	{
-		_updateGlobalTransform();
+		_invalidateGlobalTransform();
 	}
 }
 
@@ -130,7 +130,7 @@ void Link::internalSetScale(const glm::vec3 &v, bool recalculate)
 	_scale = v;
 	if (recalculate)
 	{
-		_updateGlobalTransform();
+		_invalidateGlobalTransform();
 	}
 }
 
@@ -143,39 +143,43 @@ void Link::internalSetOrientation(const glm::quat &v, bool recalculate)
 	_orientation = v;
 	if (recalculate)
 	{
-		_updateGlobalTransform();
+		_invalidateGlobalTransform();
 	}
 }
 
+// Getters never write the cached matrices, systems can read links from
+// several threads. Dirty links are computed on the stack until the link
+// tracker stores their matrices.
 const glm::mat4 Link::getLocalTransform() const
 {
-	return const_cast<Link *>(this)->getLocalTransform();
-}
-
-const glm::mat4 &Link::getLocalTransform()
-{
-	SCOPE_profile_cpu_function("Link");
-
 	if (_localDirty)
 	{
-		_localTransformation = glm::mat4(1);
-		_localTransformation = glm::translate(_localTransformation, _position);
-		_localTransformation = _localTransformation * glm::toMat4(_orientation);
-		_localTransformation = glm::scale(_localTransformation, _scale);
-		_localDirty = false;
+		return _composeLocalTransform();
 	}
 	return _localTransformation;
 }
 
 const glm::mat4 Link::getGlobalTransform() const
 {
-	return _globalTransformation;
+	if (!_globalDirty)
+	{
+		return _globalTransformation;
+	}
+	glm::mat4 p = glm::mat4(1);
+	if (hasParent())
+	{
+		p = _parent->getGlobalTransform();
+	}
+	return p * getLocalTransform();
 }
 
-
-const glm::mat4 &Link::getGlobalTransform()
+glm::mat4 Link::_composeLocalTransform() const
 {
-	return _globalTransformation;
+	SCOPE_profile_cpu_function("Link");
+
+	glm::mat4 result = glm::translate(glm::mat4(1), _position);
+	result = result * glm::toMat4(_orientation);
+	return glm::scale(result, _scale);
 }
 
 
@@ -208,6 +212,7 @@ void Link::reset()
 	_localTransformation = glm::mat4(1);
 	_globalTransformation = glm::mat4(1);
 	_localDirty = true;
+	_globalDirty = false;
 	_parent = nullptr;
 }
 
@@ -228,7 +233,7 @@ void Link::attachChild(Link *child)
 	}
 	child->_setParent(this);
 	_setChild(child);
-	child->_updateGlobalTransform();
+	child->_invalidateGlobalTransform();
 }
 
 void Link::detachChild(Link *child)
@@ -241,7 +246,7 @@ void Link::detachChild(Link *child)
 		return;
 	}
 	child->_removeParent();
-	child->_updateGlobalTransform();
+	child->_invalidateGlobalTransform();
 	_removeChild(child);
 }
 
@@ -252,7 +257,7 @@ void Link::detachChildren()
 	for (auto &e : _children)
 	{
 		e->_removeParent();
-		e->_updateGlobalTransform();
+		e->_invalidateGlobalTransform();
 	}
 	_children.clear();
 	if (hasParent())
@@ -283,7 +288,7 @@ void Link::attachParent(Link *parent)
 	}
 	_setParent(parent);
 	_parent->_setChild(this);
-	_parent->_updateGlobalTransform();
+	_parent->_invalidateGlobalTransform();
 }
 
 void Link::detachParent()
@@ -297,7 +302,7 @@ void Link::detachParent()
 	}
 	_parent->_removeChild(this);
 	_removeParent();
-	_updateGlobalTransform();
+	_invalidateGlobalTransform();
 }
 
 void Link::_setChild(Link *ptr)
@@ -377,19 +382,70 @@ void Link::_removeParent()
 	_parent = nullptr;
 }
 
-void Link::_updateGlobalTransform()
+#ifdef AGE_BFC
+void Link::_invalidateGlobalTransform()
 {
-	SCOPE_profile_cpu_function("Link");
-
+	// a dirty link stays in the tracker until it is updated (the BFC items
+	// removals do not unregister it) and its children are dirty too
+	if (_globalDirty)
+	{
+		return;
+	}
 	BFC_ADD();
+	_globalDirty = true;
+	for (auto &e : _children)
+	{
+		e->_invalidateGlobalTransform();
+	}
+}
+#else
+void Link::_invalidateGlobalTransform()
+{
+	// no link tracker, the subtree is updated by the writer right away
+	_globalDirty = true;
+	_computeGlobalTransform();
+	for (auto &e : _children)
+	{
+		e->_invalidateGlobalTransform();
+	}
+}
+#endif
+
+// Only called by the writer of the link : the link tracker pass
+// (parents are in a previous level) or the setters without tracker
+void Link::_computeGlobalTransform()
+{
+	if (_localDirty)
+	{
+		_localTransformation = _composeLocalTransform();
+		_localDirty = false;
+	}
+	if (!_globalDirty)
+	{
+		return;
+	}
 	glm::mat4 p = glm::mat4(1);
 	if (hasParent())
 	{
 		p = _parent->getGlobalTransform();
 	}
-	_globalTransformation = p * getLocalTransform();
-	for (auto &e : _children)
+	_globalTransformation = p * _localTransformation;
+	_globalDirty = false;
+}
+
+void Link::computeGlobalTransform()
+{
+	_computeGlobalTransform();
+}
+
+std::size_t Link::getHierarchyDepth() const
+{
+	std::size_t depth = 0;
+	const Link *current = this;
+	while (current->hasParent())
 	{
-		e->_updateGlobalTransform();
+		++depth;
+		current = current->_parent;
 	}
+	return depth;
 }
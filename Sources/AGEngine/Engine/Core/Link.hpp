@@ -80,10 +80,14 @@ namespace AGE
 		void attachParent(Link *parent);
 		void detachParent();
 
+		// read only, safe to call from several threads while nobody writes the hierarchy
 		const glm::mat4 getGlobalTransform() const;
-		const glm::mat4 &getGlobalTransform();
 		const glm::mat4 getLocalTransform() const;
-		const glm::mat4 &getLocalTransform();
+
+		// Used by the BFC link tracker which update modified links
+		// once per frame, level by level
+		virtual void computeGlobalTransform();
+		virtual std::size_t getHierarchyDepth() const;
 	private:
 #ifdef AGE_BFC
 		void BFC_ADD();
@@ -104,6 +108,9 @@ namespace AGE
 		glm::mat4 _globalTransformation;
 #endif
 		bool _localDirty;
+		// the global transform is stored by the BFC link tracker,
+		// until then getters compute it from the parents
+		bool _globalDirty;
 		Link *_parent;
 		std::vector<Link*> _children;
 
@@ -113,7 +120,10 @@ namespace AGE
 		void _removeParent();
 		void _detachFromRoot();
 		void _attachToRoot();
-		void _updateGlobalTransform();
+		// mark the link and its children as dirty
+		void _invalidateGlobalTransform();
+		void _computeGlobalTransform();
+		glm::mat4 _composeLocalTransform() const;
 
 		AScene *_scene;
 	public:
@@ -0,0 +1,211 @@
+#include "EntityChunkStorage.hpp"
+#include "EntityData.hh"
+
+#include <Utils/Debug.hpp>
+#include <Utils/Profiler.hpp>
+
+#include <new>
+
+namespace AGE
+{
+	EntityChunk::EntityChunk(EntityChunkGroup *group)
+		: _group(group)
+		, _size(0)
+		, _buffer(new std::uint8_t[Size])
+	{
+	}
+
+	EntityChunk::~EntityChunk()
+	{
+		for (std::size_t i = 0; i < _size; ++i)
+		{
+			_entities()[i].~Entity();
+		}
+		delete[] _buffer;
+	}
+
+	ComponentBase *const *EntityChunk::getComponents(ComponentType type) const
+	{
+		auto index = _group->getColumnIndex(type);
+		if (index < 0)
+		{
+			return nullptr;
+		}
+		return reinterpret_cast<ComponentBase *const *>(_buffer + _group->getColumnOffset(index));
+	}
+
+	ComponentBase **EntityChunk::_column(std::size_t index)
+	{
+		return reinterpret_cast<ComponentBase **>(_buffer + _group->getColumnOffset(index));
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+
+	EntityChunkGroup::EntityChunkGroup(const ComponentSignature &signature)
+		: _signature(signature)
+		, _capacity(0)
+		, _entityNumber(0)
+	{
+		_columnIndex.fill(-1);
+		for (std::size_t i = 0; i < MAX_CPT_NUMBER; ++i)
+		{
+			if (_signature.test(i))
+			{
+				_columnIndex[i] = std::int32_t(_types.size());
+				_types.push_back(ComponentType(i));
+			}
+		}
+
+		// entities first, then one column of pointers per type
+		const std::size_t bytesPerEntity = sizeof(Entity) + _types.size() * sizeof(ComponentBase*);
+		_capacity = EntityChunk::Size / bytesPerEntity;
+		_columnOffsets.resize(_types.size());
+		while (_capacity > 0)
+		{
+			std::size_t offset = sizeof(Entity) * _capacity;
+			for (std::size_t i = 0; i < _types.size(); ++i)
+			{
+				offset = (offset + sizeof(ComponentBase*) - 1) & ~(sizeof(ComponentBase*) - 1);
+				_columnOffsets[i] = offset;
+				offset += sizeof(ComponentBase*) * _capacity;
+			}
+			if (offset <= EntityChunk::Size)
+			{
+				break;
+			}
+			--_capacity;
+		}
+		AGE_ASSERT(_capacity > 0);
+	}
+
+	EntityChunkGroup::Location EntityChunkGroup::add(const EntityData &entity)
+	{
+		if (_entityNumber == _chunks.size() * _capacity)
+		{
+			_chunks.emplace_back(new EntityChunk(this));
+		}
+		Location location;
+		location.group = this;
+		location.chunk = std::uint32_t(_entityNumber / _capacity);
+		location.row = std::uint32_t(_entityNumber % _capacity);
+
+		auto &chunk = *_chunks[location.chunk];
+		AGE_ASSERT(chunk._size == location.row);
+		new (&chunk._entities()[location.row]) Entity(entity.getEntity());
+		++chunk._size;
+		++_entityNumber;
+		refresh(location, entity);
+		return location;
+	}
+
+	void EntityChunkGroup::remove(const Location &location, std::vector<Location> &locations)
+	{
+		AGE_ASSERT(location.group == this && _entityNumber > 0);
+
+		auto &chunk = *_chunks[location.chunk];
+		auto &last = *_chunks[(_entityNumber - 1) / _capacity];
+		const std::size_t lastRow = last._size - 1;
+
+		if (&chunk != &last || location.row != lastRow)
+		{
+			// move the last entity in the hole
+			const Entity &moved = last._entities()[lastRow];
+			chunk._entities()[location.row] = moved;
+			for (std::size_t i = 0; i < _types.size(); ++i)
+			{
+				chunk._column(i)[location.row] = last._column(i)[lastRow];
+			}
+			locations[moved.getId()] = location;
+		}
+		last._entities()[lastRow].~Entity();
+		--last._size;
+		--_entityNumber;
+
+		// keep one empty chunk to avoid reallocation when an entity come and go
+		if (_chunks.size() > 1 && _chunks.back()->empty() && _chunks[_chunks.size() - 2]->empty())
+		{
+			_chunks.pop_back();
+		}
+	}
+
+	void EntityChunkGroup::refresh(const Location &location, const EntityData &entity)
+	{
+		auto &chunk = *_chunks[location.chunk];
+		auto &components = entity.getComponentList();
+		for (std::size_t i = 0; i < _types.size(); ++i)
+		{
+			chunk._column(i)[location.row] = components[_types[i]];
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+
+	EntityChunkStorage::EntityChunkStorage()
+	{
+	}
+
+	EntityChunkStorage::~EntityChunkStorage()
+	{
+	}
+
+	void EntityChunkStorage::addEntity(const EntityData &entity)
+	{
+		SCOPE_profile_cpu_function("Entity");
+
+		auto id = entity.getEntity().getId();
+		if (_locations.size() <= id)
+		{
+			_locations.resize(id + 1);
+		}
+		AGE_ASSERT(_locations[id].group == nullptr);
+		_locations[id] = _getGroup(entity.getSignature())->add(entity);
+	}
+
+	void EntityChunkStorage::removeEntity(const EntityData &entity)
+	{
+		SCOPE_profile_cpu_function("Entity");
+
+		auto id = entity.getEntity().getId();
+		if (_locations.size() <= id || _locations[id].group == nullptr)
+		{
+			return;
+		}
+		auto location = _locations[id];
+		location.group->remove(location, _locations);
+		_locations[id] = EntityChunkGroup::Location();
+	}
+
+	void EntityChunkStorage::updateEntity(const EntityData &entity)
+	{
+		SCOPE_profile_cpu_function("Entity");
+
+		auto id = entity.getEntity().getId();
+		if (_locations.size() <= id || _locations[id].group == nullptr)
+		{
+			// entity is being destroyed, or not in context
+			return;
+		}
+		auto location = _locations[id];
+		auto signature = entity.getSignature();
+		if (location.group->getSignature() == signature)
+		{
+			location.group->refresh(location, entity);
+			return;
+		}
+		location.group->remove(location, _locations);
+		_locations[id] = _getGroup(signature)->add(entity);
+	}
+
+	EntityChunkGroup *EntityChunkStorage::_getGroup(const ComponentSignature &signature)
+	{
+		auto found = _groupsBySignature.find(signature);
+		if (found != std::end(_groupsBySignature))
+		{
+			return found->second;
+		}
+		_groups.emplace_back(new EntityChunkGroup(signature));
+		auto group = _groups.back().get();
+		_groupsBySignature.insert(std::make_pair(signature, group));
+		return group;
+	}
+}
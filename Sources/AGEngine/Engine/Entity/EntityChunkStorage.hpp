@@ -0,0 +1,135 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <array>
+#include <unordered_map>
+
+#include "EntityTypedef.hpp"
+#include "Entity.hh"
+#include <Components/Component.hh>
+
+namespace AGE
+{
+	class EntityData;
+	class EntityChunkGroup;
+	struct ComponentBase;
+
+	// 16 KB block of entities sharing the same component signature
+	// Memory is SoA : one column of entities then one column per component type
+	// Components stay in the component pools (they are polymorphic and not relocatable),
+	// columns only store their addresses : a chunk replaces the filter set walk
+	// by flat arrays, but component data is still read through one indirection
+	// per component, in pool order and not in chunk order.
+	class EntityChunk
+	{
+	public:
+		static const std::size_t Size = 16 * 1024;
+
+		EntityChunk(EntityChunkGroup *group);
+		~EntityChunk();
+		EntityChunk(const EntityChunk &) = delete;
+		EntityChunk &operator=(const EntityChunk &) = delete;
+
+		inline std::size_t size() const { return _size; }
+		inline bool empty() const { return _size == 0; }
+		inline EntityChunkGroup *getGroup() const { return _group; }
+
+		inline const Entity *getEntities() const { return reinterpret_cast<const Entity*>(_buffer); }
+		// nullptr if the type is not in the signature
+		ComponentBase *const *getComponents(ComponentType type) const;
+
+		template <typename T>
+		inline T *getComponent(ComponentType type, std::size_t row) const
+		{
+			return static_cast<T*>(getComponents(type)[row]);
+		}
+
+		template <typename T>
+		inline T *getComponent(std::size_t row) const
+		{
+			return getComponent<T>(Component<T>::getTypeId(), row);
+		}
+
+	private:
+		inline Entity *_entities() { return reinterpret_cast<Entity*>(_buffer); }
+		ComponentBase **_column(std::size_t index);
+
+		EntityChunkGroup *_group;
+		std::size_t _size;
+		std::uint8_t *_buffer;
+
+		friend class EntityChunkGroup;
+	};
+
+	// All the chunks of a component signature
+	class EntityChunkGroup
+	{
+	public:
+		struct Location
+		{
+			EntityChunkGroup *group = nullptr;
+			std::uint32_t chunk = 0;
+			std::uint32_t row = 0;
+		};
+
+		EntityChunkGroup(const ComponentSignature &signature);
+		EntityChunkGroup(const EntityChunkGroup &) = delete;
+		EntityChunkGroup &operator=(const EntityChunkGroup &) = delete;
+
+		inline const ComponentSignature &getSignature() const { return _signature; }
+		inline const std::vector<ComponentType> &getTypes() const { return _types; }
+		inline std::size_t getCapacityPerChunk() const { return _capacity; }
+		inline std::size_t getEntityNumber() const { return _entityNumber; }
+		inline std::size_t getChunkNumber() const { return _chunks.size(); }
+		inline const EntityChunk &getChunk(std::size_t index) const { return *_chunks[index]; }
+
+		inline std::int32_t getColumnIndex(ComponentType type) const { return _columnIndex[type]; }
+		inline std::size_t getColumnOffset(std::size_t index) const { return _columnOffsets[index]; }
+
+		// return the location of the entity in the group
+		Location add(const EntityData &entity);
+		// the last entity of the group is moved in the hole,
+		// its location in `locations` is updated
+		void remove(const Location &location, std::vector<Location> &locations);
+		// update component addresses of the row
+		void refresh(const Location &location, const EntityData &entity);
+
+	private:
+		ComponentSignature _signature;
+		std::vector<ComponentType> _types;
+		std::array<std::int32_t, MAX_CPT_NUMBER> _columnIndex;
+		std::vector<std::size_t> _columnOffsets;
+		std::size_t _capacity;
+		std::size_t _entityNumber;
+		std::vector<std::unique_ptr<EntityChunk>> _chunks;
+	};
+
+	// Keep in context entities sorted by component signature
+	// Filled by the scene when entities and components are added or removed
+	class EntityChunkStorage
+	{
+	public:
+		EntityChunkStorage();
+		~EntityChunkStorage();
+		EntityChunkStorage(const EntityChunkStorage &) = delete;
+		EntityChunkStorage &operator=(const EntityChunkStorage &) = delete;
+
+		void addEntity(const EntityData &entity);
+		void removeEntity(const EntityData &entity);
+		// entity signature changed or a component has been replaced
+		void updateEntity(const EntityData &entity);
+
+		// groups are never destroyed, so filters can keep track
+		// of the groups they already tested with the group number
+		inline std::size_t getGroupNumber() const { return _groups.size(); }
+		inline EntityChunkGroup *getGroup(std::size_t index) const { return _groups[index].get(); }
+	private:
+		EntityChunkGroup *_getGroup(const ComponentSignature &signature);
+
+		std::vector<std::unique_ptr<EntityChunkGroup>> _groups;
+		std::unordered_map<ComponentSignature, EntityChunkGroup*> _groupsBySignature;
+		// indexed by entity id
+		std::vector<EntityChunkGroup::Location> _locations;
+	};
+}
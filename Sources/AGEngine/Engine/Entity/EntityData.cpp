@@ -39,6 +39,7 @@ namespace AGE
 			components.resize(id + 1, nullptr);
 		}
 		components[id] = cpt;
+		signature.set(id);
 		if (!outOfContext)
 		{
 			scene->informFiltersComponentAddition(id, *this);
@@ -70,6 +71,7 @@ namespace AGE
 			components.resize(id + 1, nullptr);
 		}
 		components[id] = newCpt;
+		signature.set(id);
 		if (!outOfContext)
 		{
 			scene->informFiltersComponentAddition(id, *this);
@@ -85,6 +87,7 @@ namespace AGE
 		components[id]->reset();
 		scene->deleteComponent(components[id]);
 		components[id] = nullptr;
+		signature.reset(id);
 		if (!outOfContext)
 		{
 			scene->informFiltersComponentDeletion(id, *this);
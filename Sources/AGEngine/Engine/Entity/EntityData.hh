@@ -59,6 +59,7 @@ namespace AGE
 				components.resize(id + 1, nullptr);
 			T *ptr = scene->createComponent<T>(entity);
 			components[id] = ptr;
+			signature.set(id);
 			if (!outOfContext)
 			{
 				scene->informFiltersComponentAddition(id, *this);
@@ -69,11 +70,13 @@ namespace AGE
 		}
 
 		const std::vector<ComponentBase*> &getComponentList() const;
+		inline const ComponentSignature &getSignature() const { return signature; }
 
 	private:
 		Entity entity;
 		AGE::Link link;
 		std::vector<ComponentBase*> components;
+		ComponentSignature signature;
 		AScene *scene;
 		bool outOfContext;
 	public:
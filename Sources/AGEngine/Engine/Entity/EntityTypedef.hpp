@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <bitset>
 
 namespace AGE
 {
@@ -23,4 +24,7 @@ namespace AGE
 
 #define MAX_ENTITY_NUMBER ((ENTITY_ID)(-1))
 
+	// one bit per component type
+	typedef std::bitset<MAX_CPT_NUMBER> ComponentSignature;
+
 }
\ No newline at end of file
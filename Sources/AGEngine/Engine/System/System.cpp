@@ -4,11 +4,14 @@
 namespace AGE
 {
 	SystemType SystemBase::_typeCounter = 0;
+	bool SystemsConfig::g_parallel_update_is_enabled = true;
 
 	SystemBase::SystemBase(AScene *scene, const SystemType typeId) :
 		_scene(scene)
 		, _activated(false)
 		, _typeId(typeId)
+		, _declaredAccess(false)
+		, _mainThreadOnly(false)
 	{
 		AGE_ASSERT(_typeId != std::size_t(-1));
 	}
@@ -25,6 +28,29 @@ namespace AGE
 		updateEnd(time);
 	}
 
+	void SystemBase::synchronize(float time)
+	{
+		updateSynchronized(time);
+	}
+
+	bool SystemBase::conflictWith(const SystemBase &other) const
+	{
+		if (!_declaredAccess || !other._declaredAccess)
+			return true;
+		return (_writes & (other._reads | other._writes)).any()
+			|| (other._writes & _reads).any();
+	}
+
+	void SystemBase::_declareAccess(std::size_t id, bool write)
+	{
+		AGE_ASSERT(id < _reads.size());
+		_declaredAccess = true;
+		if (write)
+			_writes.set(id);
+		else
+			_reads.set(id);
+	}
+
 	bool SystemBase::init()
 	{
 		if (!initialize())
@@ -73,6 +99,10 @@ namespace AGE
 	{
 	}
 
+	void SystemBase::updateSynchronized(float time)
+	{
+	}
+
 	bool SystemBase::initialize()
 	{
 		return true;
@@ -1,23 +1,52 @@
 #pragma once
 
 #include <Core/EntityFilter.hpp>
+#include <Components/Component.hh>
+#include <bitset>
 
 namespace AGE
 {
 	typedef std::uint32_t SystemType;
 
+	// Shared data which are not components but that systems can read or write
+	enum class SystemResource : std::uint8_t
+	{
+		Links = 0, // transformations and the BFC link tracker
+		Physics,   // physic world, bodies and controllers
+		END
+	};
+
+	typedef std::bitset<MAX_CPT_NUMBER + std::size_t(SystemResource::END)> SystemAccessSet;
+
+	class SystemsConfig
+	{
+	public:
+		// Systems which declare their accesses are updated
+		// on the workers, in parallel when they do not conflict
+		static bool g_parallel_update_is_enabled;
+	};
+
 	class	SystemBase
 	{
 	public:
 		SystemBase(AScene *scene, const SystemType typeId);
 		virtual ~SystemBase();
 		void update(float time);
+		// called on the main thread once the update of the system is done,
+		// after the other systems of the same parallel batch
+		void synchronize(float time);
 		bool init();
 		virtual void finalize(void);
 		bool setActivation(bool tof);
 		bool isActivated() const;
 		inline const std::string &getName() const { return _name; }
 		inline const SystemType getTypeId() const { return _typeId; }
+
+		// Systems without declared accesses are exclusive :
+		// they run alone, on the main thread
+		inline bool hasDeclaredAccess() const { return _declaredAccess; }
+		inline bool isMainThreadOnly() const { return _mainThreadOnly; }
+		bool conflictWith(const SystemBase &other) const;
 	protected:
 		AScene *_scene;
 		std::string _name;
@@ -28,9 +57,44 @@ namespace AGE
 		virtual void updateBegin(float time);
 		virtual void updateEnd(float time);
 		virtual void mainUpdate(float time);
+		// entity creation and destruction of parallel systems have to be done here
+		virtual void updateSynchronized(float time);
 		virtual bool initialize();
 		virtual bool activate();
 		virtual bool deactivate();
+
+		// To call in the constructor or in initialize()
+		template <typename T>
+		inline void readComponent()
+		{
+			_declareAccess(Component<T>::getTypeId(), false);
+		}
+
+		template <typename T>
+		inline void writeComponent()
+		{
+			_declareAccess(Component<T>::getTypeId(), true);
+		}
+
+		inline void readResource(SystemResource resource)
+		{
+			_declareAccess(MAX_CPT_NUMBER + std::size_t(resource), false);
+		}
+
+		inline void writeResource(SystemResource resource)
+		{
+			_declareAccess(MAX_CPT_NUMBER + std::size_t(resource), true);
+		}
+
+		// the system is scheduled with the others but executed by the main thread
+		inline void runOnMainThread() { _mainThreadOnly = true; }
+	private:
+		void _declareAccess(std::size_t id, bool write);
+
+		SystemAccessSet _reads;
+		SystemAccessSet _writes;
+		bool _declaredAccess;
+		bool _mainThreadOnly;
 	};
 
 	template <typename Type>
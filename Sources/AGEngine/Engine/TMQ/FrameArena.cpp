@@ -0,0 +1,103 @@
+#include "FrameArena.hpp"
+
+#include <new>
+#include <algorithm>
+
+#include "Utils/Debug.hpp"
+
+namespace TMQ
+{
+	static inline std::size_t AlignAllocationSize(std::size_t size)
+	{
+		return (sizeof(MessageAllocation) + size + 15) & ~std::size_t(15);
+	}
+
+	FrameArena::FrameArena()
+		: _buffer(nullptr)
+		, _current(nullptr)
+		, _frame(std::size_t(-1))
+	{
+		_buffer = new char[FrameCapacity * FrameNumber];
+		AGE_ASSERT(_buffer != nullptr);
+		for (std::size_t i = 0; i < FrameNumber; ++i)
+		{
+			_slices[i].buffer = _buffer + i * FrameCapacity;
+			_slices[i].offset = 0;
+			_slices[i].liveAllocations = 0;
+		}
+		_stats.frameCapacity = FrameCapacity;
+	}
+
+	FrameArena::~FrameArena()
+	{
+		delete[] _buffer;
+	}
+
+	void FrameArena::_beginFrame(std::size_t frame)
+	{
+		if (_current != nullptr)
+		{
+			_stats.lastFrameUsage = _current->offset;
+		}
+		_frame = frame;
+		_current = &_slices[frame % FrameNumber];
+		if (_current->liveAllocations.load(std::memory_order_acquire) == 0)
+		{
+			_current->offset = 0;
+		}
+		else
+		{
+			// some messages are still in the queues, we continue after them
+			++_stats.delayedResets;
+		}
+	}
+
+	MessageAllocation *FrameArena::allocate(std::size_t size, std::size_t messageNumber, std::size_t frame)
+	{
+		if (frame != _frame)
+		{
+			_beginFrame(frame);
+		}
+
+		std::size_t total = AlignAllocationSize(size);
+		if (_current->offset + total > FrameCapacity)
+		{
+			++_stats.heapFallbacks;
+			return allocateOnHeap(size, messageNumber);
+		}
+
+		auto allocation = new (_current->buffer + _current->offset) MessageAllocation();
+		allocation->slice = _current;
+		allocation->messages = messageNumber;
+		_current->liveAllocations.fetch_add(1, std::memory_order_relaxed);
+		_current->offset += total;
+		_stats.highWaterMark = std::max(_stats.highWaterMark, _current->offset);
+		return allocation;
+	}
+
+	MessageAllocation *FrameArena::allocateOnHeap(std::size_t size, std::size_t messageNumber)
+	{
+		auto allocation = new (new char[AlignAllocationSize(size)]) MessageAllocation();
+		allocation->slice = nullptr;
+		allocation->messages = messageNumber;
+		return allocation;
+	}
+
+	void FrameArena::release(MessageAllocation *allocation)
+	{
+		AGE_ASSERT(allocation != nullptr);
+		if (allocation->messages.fetch_sub(1, std::memory_order_acq_rel) != 1)
+		{
+			return;
+		}
+		if (allocation->slice != nullptr)
+		{
+			allocation->slice->liveAllocations.fetch_sub(1, std::memory_order_release);
+		}
+		else
+		{
+			allocation->~MessageAllocation();
+			delete[] (char*)(allocation);
+		}
+	}
+}
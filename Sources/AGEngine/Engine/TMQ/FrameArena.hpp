@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace TMQ
+{
+	struct FrameArenaSlice;
+
+	// Header placed before each message allocation
+	// An allocation can contain multiple messages (see TaskManager::allocSharedTasks)
+	__declspec(align(16))
+	struct MessageAllocation
+	{
+		FrameArenaSlice    *slice;    // nullptr if allocated on heap
+		std::atomic_size_t messages;  // number of messages not released yet
+
+		inline void *getData() { return (void*)(this + 1); }
+	};
+
+	struct FrameArenaSlice
+	{
+		char               *buffer = nullptr;
+		std::size_t        offset = 0;
+		std::atomic_size_t liveAllocations;
+	};
+
+	struct FrameArenaStats
+	{
+		std::size_t frameCapacity = 0;
+		std::size_t lastFrameUsage = 0;
+		std::size_t highWaterMark = 0;
+		// allocations which did not fit in the frame slice
+		std::size_t heapFallbacks = 0;
+		// slices which were still in use when their frame came back
+		std::size_t delayedResets = 0;
+	};
+
+	// Linear allocator owned by one thread
+	// Each frame has its own slice, reset in bulk when the frame comes back
+	// and only if all the messages allocated in it have been released.
+	// If the slice is full, allocation fallback on heap.
+	class FrameArena
+	{
+	public:
+		static const std::size_t FrameNumber = 3;
+		static const std::size_t FrameCapacity = 1024 * 1024;
+
+		FrameArena();
+		~FrameArena();
+		FrameArena(const FrameArena &) = delete;
+		FrameArena &operator=(const FrameArena &) = delete;
+
+		// owner thread only
+		MessageAllocation *allocate(std::size_t size, std::size_t messageNumber, std::size_t frame);
+		inline const FrameArenaStats &getStats() const { return _stats; }
+
+		// any thread
+		static MessageAllocation *allocateOnHeap(std::size_t size, std::size_t messageNumber);
+		static void release(MessageAllocation *allocation);
+	private:
+		void _beginFrame(std::size_t frame);
+
+		char            *_buffer;
+		FrameArenaSlice _slices[FrameNumber];
+		FrameArenaSlice *_current;
+		std::size_t     _frame;
+		FrameArenaStats _stats;
+	};
+}
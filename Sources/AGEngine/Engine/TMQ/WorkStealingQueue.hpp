@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace TMQ
+{
+	// Chase-Lev work stealing deque
+	// - push and pop are called only by the owner thread (LIFO, at the bottom)
+	// - steal can be called by any thread (FIFO, at the top)
+	// Capacity is fixed and have to be a power of two,
+	// push return false when the deque is full so the caller can fallback on another queue
+	template <typename T, std::size_t Capacity>
+	class WorkStealingQueue
+	{
+		static_assert((Capacity & (Capacity - 1)) == 0, "Capacity have to be a power of two");
+		static const std::int64_t Mask = std::int64_t(Capacity) - 1;
+	public:
+		WorkStealingQueue()
+		{
+			_top = 0;
+			_bottom = 0;
+			for (std::size_t i = 0; i < Capacity; ++i)
+			{
+				_buffer[i] = T();
+			}
+		}
+
+		WorkStealingQueue(const WorkStealingQueue &) = delete;
+		WorkStealingQueue &operator=(const WorkStealingQueue &) = delete;
+
+		// owner only
+		bool push(T item)
+		{
+			std::int64_t b = _bottom.load(std::memory_order_relaxed);
+			std::int64_t t = _top.load(std::memory_order_acquire);
+			if (b - t >= std::int64_t(Capacity))
+			{
+				return false;
+			}
+			_buffer[b & Mask].store(item, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			_bottom.store(b + 1, std::memory_order_relaxed);
+			return true;
+		}
+
+		// owner only
+		bool pop(T &item)
+		{
+			std::int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+			_bottom.store(b, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			std::int64_t t = _top.load(std::memory_order_relaxed);
+
+			if (t > b)
+			{
+				// empty
+				_bottom.store(b + 1, std::memory_order_relaxed);
+				return false;
+			}
+			item = _buffer[b & Mask].load(std::memory_order_relaxed);
+			if (t != b)
+			{
+				return true;
+			}
+			// last item, we race against thieves
+			bool won = _top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			_bottom.store(b + 1, std::memory_order_relaxed);
+			return won;
+		}
+
+		// any thread
+		bool steal(T &item)
+		{
+			std::int64_t t = _top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			std::int64_t b = _bottom.load(std::memory_order_acquire);
+
+			if (t >= b)
+			{
+				return false;
+			}
+			item = _buffer[t & Mask].load(std::memory_order_relaxed);
+			// another thief or the owner was faster
+			return _top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		}
+
+		inline bool empty() const
+		{
+			return _bottom.load(std::memory_order_relaxed) <= _top.load(std::memory_order_relaxed);
+		}
+
+	private:
+		// top and bottom on different cache lines, thieves hammer top
+		__declspec(align(64)) std::atomic<std::int64_t> _top;
+		__declspec(align(64)) std::atomic<std::int64_t> _bottom;
+		__declspec(align(64)) std::atomic<T> _buffer[Capacity];
+	};
+}
@@ -6,6 +6,7 @@ std::size_t MessageBase::__sharedIdCounter = 0;
 
 MessageBase::MessageBase(std::size_t _uid)
 	: uid(_uid)
+	, _allocation(nullptr)
 {
 }
 
@@ -4,6 +4,8 @@
 
 namespace TMQ
 {
+	struct MessageAllocation;
+
 	struct MessageBase
 	{
 		virtual ~MessageBase();
@@ -13,8 +15,13 @@ namespace TMQ
 		MessageBase &operator=(const MessageBase&o) = delete;
 		MessageBase(MessageBase&&o) = delete;
 		MessageBase &operator=(MessageBase&&o) = delete;
+		// set by TaskManager once constructed, used to release the message memory
+		inline MessageAllocation *getAllocation() const { return _allocation; }
+		inline void setAllocation(MessageAllocation *allocation) { _allocation = allocation; }
 	protected:
 		static std::size_t __sharedIdCounter;
+	private:
+		MessageAllocation *_allocation;
 	};
 
 	template <typename T>
@@ -1,14 +1,153 @@
 #include "queue.hpp"
 
+#include <thread>
+
 using namespace TMQ;
 
 moodycamel::ConcurrentQueue<MessageBase*>              TaskManager::RenderThreadQueue::individualQueue;
-TaskManager::CircularBuffer                            TaskManager::RenderThreadQueue::circularBuffer;
 moodycamel::ConcurrentQueue<MessageBase*>              TaskManager::MainThreadQueue::individualQueue;
-TaskManager::CircularBuffer                            TaskManager::MainThreadQueue::circularBuffer;
 moodycamel::ConcurrentQueue<MessageBase*>              TaskManager::TaskQueue::queue;
-TaskManager::CircularBuffer                            TaskManager::TaskQueue::circularBuffer;
 
 moodycamel::details::mpmc_sema::LightweightSemaphore   TaskManager::RenderThreadQueue::individualSemaphore;
 moodycamel::details::mpmc_sema::LightweightSemaphore   TaskManager::TaskQueue::semaphore;
 
+
+TaskManager::StealingQueue                             TaskManager::StealingQueues::queues[TaskManager::MaxStealingQueueNumber];
+std::atomic_size_t                                     TaskManager::StealingQueues::number;
+
+__declspec(thread) static TaskManager::StealingQueue  *g_localStealingQueue = nullptr;
+__declspec(thread) static std::uint32_t                g_stealSeed = 0;
+
+bool TaskManager::RegisterStealingQueue()
+{
+	AGE_ASSERT(g_localStealingQueue == nullptr);
+	// number is never incremented past the array, thieves iterate over it
+	std::size_t index = StealingQueues::number.load();
+	do
+	{
+		if (index >= MaxStealingQueueNumber)
+		{
+			return false;
+		}
+	} while (StealingQueues::number.compare_exchange_weak(index, index + 1) == false);
+	g_localStealingQueue = &StealingQueues::queues[index];
+	g_stealSeed = std::uint32_t(index + 1) * 2654435761u;
+	return true;
+}
+
+TaskManager::StealingQueue *TaskManager::LocalStealingQueue()
+{
+	return g_localStealingQueue;
+}
+
+bool TaskManager::StealTask(MessageBase *& task, const StealingQueue *self)
+{
+	std::size_t number = StealingQueues::number.load();
+	if (number == 0)
+	{
+		return false;
+	}
+
+	// xorshift, we just want the thieves to not all start on the same victim
+	if (g_stealSeed == 0)
+	{
+		g_stealSeed = std::uint32_t(std::hash<std::thread::id>()(std::this_thread::get_id())) | 1;
+	}
+	g_stealSeed ^= g_stealSeed << 13;
+	g_stealSeed ^= g_stealSeed >> 17;
+	g_stealSeed ^= g_stealSeed << 5;
+
+	std::size_t start = g_stealSeed % number;
+	for (std::size_t i = 0; i < number; ++i)
+	{
+		auto &victim = StealingQueues::queues[(start + i) % number];
+		if (&victim == self)
+		{
+			continue;
+		}
+		if (victim.steal(task))
+		{
+			return true;
+		}
+	}
+	task = nullptr;
+	return false;
+}
+
+bool TaskManager::HasSharedTask(const StealingQueue *self)
+{
+	if (TaskQueue::queue.size_approx() != 0)
+	{
+		return true;
+	}
+	std::size_t number = StealingQueues::number.load();
+	for (std::size_t i = 0; i < number; ++i)
+	{
+		auto &victim = StealingQueues::queues[i];
+		if (&victim != self && victim.empty() == false)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+FrameArena                                            *TaskManager::FrameArenas::arenas[TaskManager::MaxFrameArenaNumber];
+std::atomic_size_t                                     TaskManager::FrameArenas::number;
+std::atomic_size_t                                     TaskManager::FrameArenas::frame;
+
+__declspec(thread) static FrameArena                  *g_localFrameArena = nullptr;
+
+void TaskManager::RegisterFrameArena()
+{
+	AGE_ASSERT(g_localFrameArena == nullptr);
+	// past the limit the thread keeps allocating its messages on heap
+	std::size_t index = FrameArenas::number.load();
+	do
+	{
+		if (index >= MaxFrameArenaNumber)
+		{
+			return;
+		}
+	} while (FrameArenas::number.compare_exchange_weak(index, index + 1) == false);
+	g_localFrameArena = new FrameArena();
+	FrameArenas::arenas[index] = g_localFrameArena;
+}
+
+void TaskManager::BeginFrame()
+{
+	FrameArenas::frame.fetch_add(1);
+}
+
+MessageAllocation *TaskManager::AllocateMessages(std::size_t size, std::size_t messageNumber)
+{
+	if (g_localFrameArena == nullptr)
+	{
+		return FrameArena::allocateOnHeap(size, messageNumber);
+	}
+	return g_localFrameArena->allocate(size, messageNumber, FrameArenas::frame.load(std::memory_order_relaxed));
+}
+
+void TaskManager::ReleaseMessage(MessageAllocation *allocation)
+{
+	if (allocation != nullptr)
+	{
+		FrameArena::release(allocation);
+	}
+}
+
+std::size_t TaskManager::GetFrameArenaNumber()
+{
+	return FrameArenas::number.load();
+}
+
+bool TaskManager::GetFrameArenaStats(std::size_t index, FrameArenaStats &stats)
+{
+	// stats are written by the owner without lock, it's only for debug display
+	if (index >= FrameArenas::number.load() || FrameArenas::arenas[index] == nullptr)
+	{
+		return false;
+	}
+	stats = FrameArenas::arenas[index]->getStats();
+	return true;
+}
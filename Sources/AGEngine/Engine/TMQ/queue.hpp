@@ -1,6 +1,8 @@
 #pragma once
 
 #include "message.hpp"
+#include "WorkStealingQueue.hpp"
+#include "FrameArena.hpp"
 
 #include <concurrentqueue/blockingconcurrentqueue.h>
 
@@ -16,118 +18,108 @@ namespace TMQ
 	class TaskManager
 	{
 	private:
-		struct CircularBuffer
-		{
-			static const std::size_t BufferSize = 10000000 * 5; // 50 mega that's a lot too much but because
-			// we don't have any security to be sure that we didn't write over non deleted data it's better to be safe
-			char *buffer;
-			std::atomic_size_t index;
-
-			CircularBuffer()
-			{
-				index = 0;
-				buffer = new char[BufferSize]();
-				AGE_ASSERT(buffer != nullptr);
-			}
-
-			void *allocMem(std::size_t size)
-			{
-				while (true)
-				{
-					std::size_t i = index.load();
-					std::size_t newIndex = i + size;
-
-					if (newIndex >= BufferSize)
-					{
-						if (index.compare_exchange_weak(i, size))
-						{
-							return (void*)&buffer[0];
-						}
-						continue;
-					}
-					if (index.compare_exchange_weak(i, newIndex))
-					{
-						return (void*)&buffer[i];
-					}
-				}
-			}
+		// Messages are allocated in the frame arena of the calling thread
+		// or on heap if the thread doesn't have one
+		static MessageAllocation *AllocateMessages(std::size_t size, std::size_t messageNumber);
 
-			template <typename T, typename ...Args>
-			T *allocate(Args... args)
-			{
-				std::size_t size = sizeof(T);
-				while (true)
-				{
-					std::size_t i = index.load();
-					std::size_t newIndex = i + size;
-
-					if (newIndex >= BufferSize)
-					{
-						if (index.compare_exchange_weak(i, size))
-						{
-							return new(&buffer[0])T(args...);
-						}
-						continue;
-					}
-					if (index.compare_exchange_weak(i, newIndex))
-					{
-						return new(&buffer[i])T(args...);
-					}
-				}
-			}
+		template <typename T, typename ...Args>
+		static Message<T> *allocateMessage(Args... args)
+		{
+			auto allocation = AllocateMessages(sizeof(Message<T>), 1);
+			auto message = new (allocation->getData()) Message<T>(args...);
+			message->setAllocation(allocation);
+			return message;
+		}
 
-			template <typename T>
-			T *allocateMultiple(std::size_t number)
-			{
-				std::size_t size = sizeof(T) * number;
-				while (true)
-				{
-					std::size_t i = index.load();
-					std::size_t newIndex = i + size;
-
-					if (newIndex >= BufferSize)
-					{
-						if (index.compare_exchange_weak(i, size))
-						{
-							return (T*)(&buffer[0]);
-						}
-						continue;
-					}
-					if (index.compare_exchange_weak(i, newIndex))
-					{
-						return (T*)(&buffer[i]);
-					}
-				}
-			}
-		};
 		struct RenderThreadQueue
 		{
 			static MessageQueue individualQueue;
 			static LWSemapore   individualSemaphore;
-			static CircularBuffer circularBuffer;
 		};
 
 		struct MainThreadQueue
 		{
 			static MessageQueue individualQueue;
-			static CircularBuffer circularBuffer;
 		};
 
+		// Shared tasks pushed by threads which are not workers (main, render)
+		// go to the global queue. Workers push to their own deque
+		// and idle workers or main thread steal from them.
 		struct TaskQueue
 		{
 			static MessageQueue queue;
 			static LWSemapore   semaphore;
-			static CircularBuffer circularBuffer;
 		};
+
 	public:
+		static const std::size_t StealingQueueCapacity = 4096;
+		static const std::size_t MaxStealingQueueNumber = 16;
+		typedef WorkStealingQueue<MessageBase*, StealingQueueCapacity> StealingQueue;
+
+	private:
+		struct StealingQueues
+		{
+			static StealingQueue     queues[MaxStealingQueueNumber];
+			static std::atomic_size_t number;
+		};
+
+		// return the deque of the current thread, nullptr if it's not a worker
+		static StealingQueue *LocalStealingQueue();
+		// try to steal from every worker deque, starting by a random one
+		static bool StealTask(MessageBase *& task, const StealingQueue *self);
+		// true if the global queue or another worker deque still have tasks
+		static bool HasSharedTask(const StealingQueue *self);
+
+		static void pushSharedMessage(MessageBase *message)
+		{
+			auto localQueue = LocalStealingQueue();
+			if (localQueue == nullptr || localQueue->push(message) == false)
+			{
+				TaskQueue::queue.enqueue(message);
+			}
+			TaskQueue::semaphore.signal();
+		}
+
+		static const std::size_t MaxFrameArenaNumber = 32;
+		struct FrameArenas
+		{
+			static FrameArena        *arenas[MaxFrameArenaNumber];
+			static std::atomic_size_t number;
+			static std::atomic_size_t frame;
+		};
+
+	public:
+		// Have to be called by each worker thread in its context
+		// before it pops its first task.
+		// Past MaxStealingQueueNumber workers, the thread keep pushing
+		// to the global queue and return false.
+		static bool RegisterStealingQueue();
+
+		// Give a frame arena to the calling thread, its messages will not be
+		// allocated on heap anymore
+		static void RegisterFrameArena();
+		// Frame fence, called by the main thread at the beginning of each frame.
+		// Arenas switch to their next slice at their next allocation.
+		static void BeginFrame();
+		// Called once the message has been treated
+		static void ReleaseMessage(MessageAllocation *allocation);
+		static std::size_t GetFrameArenaNumber();
+		static bool GetFrameArenaStats(std::size_t index, FrameArenaStats &stats);
+
 		static bool MainThreadGetTask(MessageBase *& task)
 		{
 			task = nullptr;
-			if (!MainThreadQueue::individualQueue.try_dequeue(task))
+			if (MainThreadQueue::individualQueue.try_dequeue(task))
 			{
-				return TaskQueue::queue.try_dequeue(task);
+				return true;
 			}
-			return true;
+			if (TaskQueue::queue.try_dequeue(task) || StealTask(task, nullptr))
+			{
+				// we treat a shared task, so one worker doesn't have to wake up for it
+				TaskQueue::semaphore.tryWait();
+				return true;
+			}
+			return false;
 		}
 
 		static bool RenderThreadGetTask(MessageBase *& task)
@@ -135,19 +127,51 @@ namespace TMQ
 			task = nullptr;
 			RenderThreadQueue::individualSemaphore.wait();
 
-			if (!RenderThreadQueue::individualQueue.try_dequeue(task))
-			{
-				return TaskQueue::queue.try_dequeue(task);
-			}
-			return true;
+			return RenderThreadQueue::individualQueue.try_dequeue(task);
 		}
 
 		static bool TaskThreadGetTask(MessageBase *& task)
 		{
 			task = nullptr;
+			auto localQueue = LocalStealingQueue();
+
+			// our own children tasks first, without sleeping
+			if (localQueue != nullptr && localQueue->pop(task))
+			{
+				TaskQueue::semaphore.tryWait();
+				return true;
+			}
+
 			TaskQueue::semaphore.wait();
 
-			return TaskQueue::queue.try_dequeue(task);
+			// the count we consumed is the one of a task still queued somewhere,
+			// but a steal can fail because of another thief, so we retry
+			// until we get one or there is nothing left to take
+			do
+			{
+				if (TaskQueue::queue.try_dequeue(task) || StealTask(task, localQueue))
+				{
+					return true;
+				}
+			} while (HasSharedTask(localQueue));
+			return false;
+		}
+
+		// Same as TaskThreadGetTask, but never sleep
+		// Used by workers waiting for other tasks to finish
+		static bool TaskThreadTryGetTask(MessageBase *& task)
+		{
+			task = nullptr;
+			auto localQueue = LocalStealingQueue();
+
+			if ((localQueue != nullptr && localQueue->pop(task))
+				|| TaskQueue::queue.try_dequeue(task)
+				|| StealTask(task, localQueue))
+			{
+				TaskQueue::semaphore.tryWait();
+				return true;
+			}
+			return false;
 		}
 
 
@@ -155,33 +179,38 @@ namespace TMQ
 		static void pushSharedTask(const T& e)
 		{
 			SCOPE_profile_cpu_function("TMQ");
-			TaskQueue::queue.enqueue(TaskQueue::circularBuffer.allocate<Message<T>>(e));
-			TaskQueue::semaphore.signal();
-			RenderThreadQueue::individualSemaphore.signal();
+			pushSharedMessage(allocateMessage<T>(e));
 		}
 
 		// They are allocated but NOT CONSTRUCTED !!!
 		template <typename T>
 		static Message<T> *allocSharedTasks(std::size_t number)
 		{
-			return TaskQueue::circularBuffer.allocateMultiple<Message<T>>(number);
+			auto allocation = AllocateMessages(sizeof(Message<T>) * number, number);
+			return (Message<T>*)(allocation->getData());
 		}
 
 		template <typename T>
 		static void pushAllocatedSharedTasks(T *tasks, std::size_t number)
 		{
+			auto localQueue = LocalStealingQueue();
+			// the allocation header is just before the array
+			auto allocation = (MessageAllocation*)(tasks) - 1;
 			for (std::size_t i = 0; i < number; ++i)
-				TaskQueue::queue.enqueue(&tasks[i]);
+			{
+				tasks[i].setAllocation(allocation);
+				if (localQueue == nullptr || localQueue->push(&tasks[i]) == false)
+				{
+					TaskQueue::queue.enqueue(&tasks[i]);
+				}
+			}
 			TaskQueue::semaphore.signal(number);
-			RenderThreadQueue::individualSemaphore.signal(number);
 		}
 
 		template <typename T, typename ...Args>
 		static void emplaceSharedTask(Args... args)
 		{
-			TaskQueue::queue.enqueue(TaskQueue::circularBuffer.allocate<Message<T>>(args...));
-			TaskQueue::semaphore.signal();
-			RenderThreadQueue::individualSemaphore.signal();
+			pushSharedMessage(allocateMessage<T>(args...));
 		}
 
 		template <typename T, typename F>
@@ -189,11 +218,9 @@ namespace TMQ
 		{
 			SCOPE_profile_cpu_function("TMQ");
 			std::future < F > f;
-			auto tmp = TaskQueue::circularBuffer.allocate<Message<T>>(e);
+			auto tmp = allocateMessage<T>(e);
 			f = tmp->getData().getFuture();
-			TaskQueue::queue.enqueue(tmp);
-			TaskQueue::semaphore.signal();
-			RenderThreadQueue::individualSemaphore.signal();
+			pushSharedMessage(tmp);
 			return f;
 		}
 
@@ -202,11 +229,9 @@ namespace TMQ
 		{
 			SCOPE_profile_cpu_function("TMQ");
 			std::future< F > f;
-			auto tmp = TaskQueue::circularBuffer.allocate<Message<T>>(args...);
+			auto tmp = allocateMessage<T>(args...);
 			f = tmp->getData().getFuture();
-			TaskQueue::queue.enqueue(tmp);
-			TaskQueue::semaphore.signal();
-			RenderThreadQueue::individualSemaphore.signal();
+			pushSharedMessage(tmp);
 			return f;
 		}
 
@@ -215,7 +240,7 @@ namespace TMQ
 		static void pushRenderTask(const T& e)
 		{
 			SCOPE_profile_cpu_function("TMQ");
-			RenderThreadQueue::individualQueue.enqueue(RenderThreadQueue::circularBuffer.allocate<Message<T>>(e));
+			RenderThreadQueue::individualQueue.enqueue(allocateMessage<T>(e));
 			RenderThreadQueue::individualSemaphore.signal();
 		}
 
@@ -223,7 +248,7 @@ namespace TMQ
 		static void emplaceRenderTask(Args... args)
 		{
 			SCOPE_profile_cpu_function("TMQ");
-			RenderThreadQueue::individualQueue.enqueue(RenderThreadQueue::circularBuffer.allocate<Message<T>>(args...));
+			RenderThreadQueue::individualQueue.enqueue(allocateMessage<T>(args...));
 			RenderThreadQueue::individualSemaphore.signal();
 		}
 
@@ -232,7 +257,7 @@ namespace TMQ
 		{
 			SCOPE_profile_cpu_function("TMQ");
 			std::future < F > f;
-			auto tmp = RenderThreadQueue::circularBuffer.allocate<Message<T>>(e);
+			auto tmp = allocateMessage<T>(e);
 			f = tmp->getData().getFuture();
 			RenderThreadQueue::individualQueue.enqueue(tmp);
 			RenderThreadQueue::individualSemaphore.signal();
@@ -244,7 +269,7 @@ namespace TMQ
 		{
 			SCOPE_profile_cpu_function("TMQ");
 			std::future< F > f;
-			auto tmp = RenderThreadQueue::circularBuffer.allocate<Message<T>>(args...);
+			auto tmp = allocateMessage<T>(args...);
 			f = tmp->getData().getFuture();
 			RenderThreadQueue::individualQueue.enqueue(tmp);
 			RenderThreadQueue::individualSemaphore.signal();
@@ -257,14 +282,14 @@ namespace TMQ
 		static void pushMainTask(const T& e)
 		{
 			SCOPE_profile_cpu_function("TMQ");
-			MainThreadQueue::individualQueue.enqueue(MainThreadQueue::circularBuffer.allocate<Message<T>>(e));
+			MainThreadQueue::individualQueue.enqueue(allocateMessage<T>(e));
 		}
 
 		template <typename T, typename ...Args>
 		static void emplaceMainTask(Args... args)
 		{
 			SCOPE_profile_cpu_function("TMQ");
-			MainThreadQueue::individualQueue.enqueue(MainThreadQueue::circularBuffer.allocate<Message<T>>(args...));
+			MainThreadQueue::individualQueue.enqueue(allocateMessage<T>(args...));
 		}
 
 		template <typename T, typename F>
@@ -272,7 +297,7 @@ namespace TMQ
 		{
 			SCOPE_profile_cpu_function("TMQ");
 			std::future < F > f;
-			auto tmp = MainThreadQueue::circularBuffer.allocate<Message<T>>(e);
+			auto tmp = allocateMessage<T>(e);
 			f = tmp->getData().getFuture();
 			MainThreadQueue::individualQueue.enqueue(tmp);
 			return f;
@@ -283,7 +308,7 @@ namespace TMQ
 		{
 			SCOPE_profile_cpu_function("TMQ");
 			std::future< F > f;
-			auto tmp = MainThreadQueue::circularBuffer.allocate<Message<T>>(args...);
+			auto tmp = allocateMessage<T>(args...);
 			f = tmp->getData().getFuture();
 			MainThreadQueue::individualQueue.enqueue(tmp);
 			return f;
@@ -43,6 +43,9 @@ namespace AGE
 
 		workStart = std::chrono::high_resolution_clock::now();
 
+		// messages allocated from now are in a new frame arena slice
+		TMQ::TaskManager::BeginFrame();
+
 		if (_frameCounter - GetRenderThread()->getCurrentFrameCount() > 2)
 		{
 			_isRenderFrame = false;
@@ -82,6 +85,8 @@ namespace AGE
 		return true;
 	}
 
+	// Execute one task of the main queue, or a shared one
+	// stolen from the global queue or from a worker deque
 	bool MainThread::tryToStealTasks()
 	{
 		SCOPE_profile_cpu_i("MainThread", "Steal tasks");
@@ -7,6 +7,9 @@ namespace AGE
 	bool QueueOwner::execute(TMQ::MessageBase *task)
 	{
 		std::size_t id = task->uid;
+		// callbacks destroy the message, so we keep its allocation to release it after
+		auto allocation = task->getAllocation();
+		bool result = true;
 		if (_individualCommandCallbacks.size() > id && _individualCommandCallbacks[id] != nullptr)
 		{
 			(*_individualCommandCallbacks[id].get())(task);
@@ -17,8 +20,9 @@ namespace AGE
 		}
 		else
 		{
-			return false;
+			result = false;
 		}
-		return true;
+		TMQ::TaskManager::ReleaseMessage(allocation);
+		return result;
 	}
 }
\ No newline at end of file
@@ -47,12 +47,34 @@ namespace AGE
 		_imguiRenderlist = nullptr;
 #endif
 		_frameCounter = 0;
+		for (auto &e : _bonesFences)
+		{
+			e = nullptr;
+		}
 	}
 
 	RenderThread::~RenderThread()
 	{
 	}
 
+	void RenderThread::_releaseBonesRegions()
+	{
+		for (std::size_t i = 0; i < BonesStream::RegionNumber; ++i)
+		{
+			if (_bonesFences[i] == nullptr)
+			{
+				continue;
+			}
+			auto status = glClientWaitSync(_bonesFences[i], 0, 0);
+			if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED)
+			{
+				glDeleteSync(_bonesFences[i]);
+				_bonesFences[i] = nullptr;
+				_bonesStream.release(i);
+			}
+		}
+	}
+
 	void RenderThread::_recompileShaders()
 	{
 		// to be sure that this function is only called in render thread
@@ -266,13 +288,30 @@ namespace AGE
 			pipelines[DEBUG_DEFERRED] = std::make_unique<DebugDeferredShading>(_context->getScreenSize(), paintingManager);
 			_recompileShaders();
 			_initPipelines();
-			_bonesTexture = createRenderPassOutput<TextureBuffer>(8184 * 2, GL_RGBA32F, sizeof(glm::mat4), GL_DYNAMIC_DRAW);
+			_bonesTexture = createRenderPassOutput<TextureBuffer>(8184 * 2, GL_RGBA32F, sizeof(BoneMatrix), GL_DYNAMIC_DRAW);
+			// the skinning writes directly in it when it is supported, _bonesTexture is the fallback
+			_bonesStreamTexture = std::make_shared<TextureBuffer>();
+			if (_bonesStreamTexture->initPersistent(8184 * 2 * BonesStream::RegionNumber, GL_RGBA32F, sizeof(BoneMatrix)))
+			{
+				_bonesStream.init((BoneMatrix*)_bonesStreamTexture->getMappedMemory(), 8184 * 2);
+			}
+			else
+			{
+				_bonesStreamTexture = nullptr;
+			}
 			msg.setValue(true);
 		});
 
 		registerCallback<Commands::ToRender::Flush>([&](Commands::ToRender::Flush& msg)
 		{
 			SCOPE_profile_cpu_i("RenderTimer", "Render frame");
+			if (_bonesRegion != BonesStream::InvalidRegion)
+			{
+				// the draws of the frame are submitted, the region is free once they are done
+				_bonesFences[_bonesRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+				_bonesStream.setInFlight(_bonesRegion);
+				_bonesRegion = BonesStream::InvalidRegion;
+			}
 			if (msg.isRenderFrame)
 			{
 #ifdef AGE_ENABLE_IMGUI
@@ -293,6 +332,10 @@ namespace AGE
 					first = false;
 				}
 #endif
+				{
+					SCOPE_profile_cpu_i("RenderTimer", "Stream textures");
+					_textureStreamer.update();
+				}
 				_context->swapContext();
 				{
 					SCOPE_profile_gpu_i("Clear buffer");
@@ -367,10 +410,34 @@ namespace AGE
 			}
 		});
 
+		registerCallback<AGE::Tasks::StreamTexture>([&](AGE::Tasks::StreamTexture& msg)
+		{
+			_textureStreamer.push(msg.texture, msg.image, msg.path);
+		});
+
 		registerCallback<AGE::Tasks::UploadBonesToGPU>([&](AGE::Tasks::UploadBonesToGPU& msg)
 		{
 			SCOPE_profile_cpu_i("!!!HACK!!!", "Upload bones matrix to GPU");
-			_bonesTexture->set(msg.bones->data(), msg.bones->size());
+			_releaseBonesRegions();
+			if (msg.region != BonesStream::InvalidRegion)
+			{
+				// already written by the skinning
+				_bonesRegion = msg.region;
+				_bonesTextureUpToDate = false;
+				return;
+			}
+			if (msg.layoutChanged || _bonesTextureUpToDate == false)
+			{
+				_bonesTexture->set(msg.bones->data(), msg.bones->size());
+			}
+			else
+			{
+				for (auto &range : *msg.dirty)
+				{
+					_bonesTexture->setRange(msg.bones->data(), range.first, range.second);
+				}
+			}
+			_bonesTextureUpToDate = true;
 		});
 
 		return true;
@@ -378,6 +445,8 @@ namespace AGE
 
 	bool RenderThread::release()
 	{
+		_textureStreamer.release();
+		_materialBuffer.release();
 		if (_depthMapManager != nullptr)
 			delete _depthMapManager;
 		return true;
@@ -9,6 +9,9 @@
 
 #include <Utils/Containers/Vector.hpp>
 #include <Utils/SpinLock.hpp>
+#include <Skinning/BonesStream.hpp>
+#include <Render/Textures/TextureStreamer.hh>
+#include <Render/Buffer/MaterialBuffer.hh>
 
 #include <memory>
 #include <vector>
@@ -28,6 +31,13 @@ namespace AGE
 	class IProperty;
 	class Vertices;
 	class TextureBuffer;
+}
+
+// GLsync
+struct __GLsync;
+
+namespace AGE
+{
 
 	class RenderThread : public Thread, public QueueOwner
 	{
@@ -47,11 +57,19 @@ namespace AGE
 		inline std::size_t getCurrentFrameCount() const { return _frameCounter; }
 
 		inline DepthMapManager &getDepthMapManager() { return *_depthMapManager; }
+		// the residency stats can be read from any thread
+		inline const TextureStreamer &getTextureStreamer() const { return _textureStreamer; }
+		inline MaterialBuffer &getMaterialBuffer() { return _materialBuffer; }
 
 #ifdef AGE_ENABLE_IMGUI
 		void setImguiDrawList(std::shared_ptr<AGE::RenderImgui> &list);
 #endif
-		std::shared_ptr<AGE::TextureBuffer> getBonesTexture() { return _bonesTexture; }
+		// bones of the frame being drawn, in the stream or in the copy texture
+		std::shared_ptr<AGE::TextureBuffer> getBonesTexture() { return _bonesRegion != BonesStream::InvalidRegion ? _bonesStreamTexture : _bonesTexture; }
+		// to add to the bones index of the meshes
+		std::size_t getBonesOffset() const { return _bonesRegion != BonesStream::InvalidRegion ? _bonesStream.getRegionOffset(_bonesRegion) : 0; }
+		// written by the skinning tasks, not ready when persistent mapping is not supported
+		inline BonesStream &getBonesStream() { return _bonesStream; }
 	public:
 		std::shared_ptr<PaintingManager> paintingManager;
 		std::vector<std::unique_ptr<IRenderingPipeline>> pipelines;
@@ -59,6 +77,8 @@ namespace AGE
 
 		void _recompileShaders();
 		void _initPipelines();
+		// give back the regions of the bones stream the GPU is done with
+		void _releaseBonesRegions();
 		RenderThread();
 		virtual ~RenderThread();
 		RenderThread(const RenderThread &) = delete;
@@ -80,6 +100,16 @@ namespace AGE
 		AGE::SpinLock _mutex;
 
 		std::shared_ptr<AGE::TextureBuffer> _bonesTexture;
+		std::shared_ptr<AGE::TextureBuffer> _bonesStreamTexture;
+		BonesStream _bonesStream;
+		// region used by the frame being drawn
+		std::size_t _bonesRegion = BonesStream::InvalidRegion;
+		__GLsync *_bonesFences[BonesStream::RegionNumber];
+		// the copy texture holds the last copied bones, the dirty ones are enough
+		bool _bonesTextureUpToDate = false;
+
+		TextureStreamer _textureStreamer;
+		MaterialBuffer _materialBuffer;
 
 		friend class ThreadManager;
 	};
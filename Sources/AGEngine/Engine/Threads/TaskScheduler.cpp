@@ -0,0 +1,144 @@
+#include "TaskScheduler.hpp"
+#include "ThreadManager.hpp"
+#include "MainThread.hpp"
+#include "TaskThread.hpp"
+
+#include <Threads/Tasks/BasicTasks.hpp>
+#include <TMQ/queue.hpp>
+
+#include <Utils/Debug.hpp>
+#include <Utils/Profiler.hpp>
+
+#include <thread>
+
+namespace AGE
+{
+	void WaitForCounter(const TaskCounter &counter)
+	{
+		SCOPE_profile_cpu_function("TaskScheduler");
+
+		auto thread = CurrentThread();
+		while (counter.isDone() == false)
+		{
+			bool executed = false;
+			if (thread != nullptr && thread->isMainThread())
+			{
+				executed = static_cast<MainThread*>(thread)->tryToStealTasks();
+			}
+			else if (thread != nullptr && thread->isWorkerThread())
+			{
+				executed = static_cast<TaskThread*>(thread)->tryToStealTasks();
+			}
+			if (executed == false)
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	TaskGraph::Job::Job(const std::function<void()> &function, bool mainThread)
+		: _function(function)
+		, _dependencyNumber(0)
+		, _mainThread(mainThread)
+	{
+		_remainingDependencies = 0;
+	}
+
+	TaskGraph::TaskGraph()
+		: _launched(false)
+	{
+	}
+
+	TaskGraph::~TaskGraph()
+	{
+		AGE_ASSERT(_counter.isDone() && "Task graph destroyed while running");
+	}
+
+	TaskGraph::Job *TaskGraph::addJob(const std::function<void()> &function, bool mainThread)
+	{
+		AGE_ASSERT(_launched == false);
+		_jobs.emplace_back(function, mainThread);
+		_counter.increment();
+		return &_jobs.back();
+	}
+
+	void TaskGraph::addDependency(Job *before, Job *after)
+	{
+		AGE_ASSERT(_launched == false);
+		AGE_ASSERT(before != nullptr && after != nullptr && before != after);
+		before->_continuations.push_back(after);
+		++after->_dependencyNumber;
+	}
+
+	void TaskGraph::launch()
+	{
+		SCOPE_profile_cpu_function("TaskScheduler");
+
+		AGE_ASSERT(_launched == false);
+		_launched = true;
+
+		// all counters are set before the first push, because
+		// a root job can finish and release continuations while we iterate
+		std::vector<Job*> roots;
+		for (auto &job : _jobs)
+		{
+			job._remainingDependencies = job._dependencyNumber;
+			if (job._dependencyNumber == 0)
+			{
+				roots.push_back(&job);
+			}
+		}
+		AGE_ASSERT((_jobs.empty() || roots.empty() == false) && "Task graph has a cycle");
+		for (auto job : roots)
+		{
+			_schedule(job);
+		}
+	}
+
+	void TaskGraph::wait()
+	{
+		SCOPE_profile_cpu_function("TaskScheduler");
+		AGE_ASSERT(_launched || _jobs.empty());
+		WaitForCounter(_counter);
+	}
+
+	void TaskGraph::reset()
+	{
+		AGE_ASSERT(_counter.isDone());
+		_jobs.clear();
+		_launched = false;
+	}
+
+	void TaskGraph::_schedule(Job *job)
+	{
+		if (job->_mainThread)
+		{
+			TMQ::TaskManager::emplaceMainTask<Tasks::Basic::VoidFunction>([this, job]()
+			{
+				_execute(job);
+			});
+			return;
+		}
+		TMQ::TaskManager::emplaceSharedTask<Tasks::Basic::VoidFunction>([this, job]()
+		{
+			_execute(job);
+		});
+	}
+
+	void TaskGraph::_execute(Job *job)
+	{
+		if (job->_function)
+		{
+			job->_function();
+		}
+		for (auto continuation : job->_continuations)
+		{
+			if (continuation->_remainingDependencies.fetch_sub(1) == 1)
+			{
+				_schedule(continuation);
+			}
+		}
+		// last, the graph can be destroyed as soon as it reach 0
+		_counter.decrement();
+	}
+}
@@ -1,3 +1,89 @@
 #pragma once
 
-// todo delete
+#include <atomic>
+#include <deque>
+#include <vector>
+#include <functional>
+
+namespace AGE
+{
+	// Number of unfinished tasks
+	// Incremented when tasks are pushed, decremented by the tasks themselves
+	class TaskCounter
+	{
+	public:
+		TaskCounter() { _value = 0; }
+		explicit TaskCounter(std::size_t value) { _value = value; }
+		TaskCounter(const TaskCounter &) = delete;
+		TaskCounter &operator=(const TaskCounter &) = delete;
+
+		inline void increment(std::size_t number = 1) { _value.fetch_add(number); }
+		inline void decrement() { _value.fetch_sub(1); }
+		inline bool isDone() const { return _value.load() == 0; }
+		inline std::size_t get() const { return _value.load(); }
+	private:
+		std::atomic_size_t _value;
+	};
+
+	// Execute other tasks until the counter reach 0
+	// Main and worker threads steal shared tasks while waiting,
+	// other threads only yield
+	void WaitForCounter(const TaskCounter &counter);
+
+	// Jobs with dependencies
+	// A job is pushed to the workers once all the jobs it depends on are done
+	// The graph have to be waited before being reset or destroyed
+	//
+	// auto skinning = graph.addJob(...);
+	// auto upload = graph.addJob(...);
+	// graph.addDependency(skinning, upload);
+	// graph.launch();
+	// graph.wait();
+	class TaskGraph
+	{
+	public:
+		class Job
+		{
+		public:
+			Job(const std::function<void()> &function, bool mainThread);
+			Job(const Job &) = delete;
+			Job &operator=(const Job &) = delete;
+		private:
+			std::function<void()> _function;
+			std::vector<Job*>     _continuations;
+			std::size_t           _dependencyNumber;
+			std::atomic_size_t    _remainingDependencies;
+			bool                  _mainThread;
+
+			friend class TaskGraph;
+		};
+
+		TaskGraph();
+		~TaskGraph();
+		TaskGraph(const TaskGraph &) = delete;
+		TaskGraph &operator=(const TaskGraph &) = delete;
+
+		// graph construction, before launch only
+		// main thread jobs are executed when the main thread wait for the graph
+		Job *addJob(const std::function<void()> &function, bool mainThread = false);
+		// after will be pushed once before is done
+		void addDependency(Job *before, Job *after);
+
+		// push jobs without dependencies
+		void launch();
+		// execute other tasks while the graph is not done
+		void wait();
+		// clear jobs to reuse the graph
+		void reset();
+
+		inline const TaskCounter &getCounter() const { return _counter; }
+		inline bool isDone() const { return _counter.isDone(); }
+	private:
+		void _schedule(Job *job);
+		void _execute(Job *job);
+
+		std::deque<Job> _jobs;
+		TaskCounter     _counter;
+		bool            _launched;
+	};
+}
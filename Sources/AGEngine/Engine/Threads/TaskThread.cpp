@@ -56,6 +56,7 @@ namespace AGE
 	bool TaskThread::update()
 	{
 		_registerId();
+		TMQ::TaskManager::RegisterStealingQueue();
 		_run = true;
 		_insideRun = true;
 		DWORD threadId = ::GetThreadId(static_cast<HANDLE>(_threadHandle.native_handle()));
@@ -76,4 +77,16 @@ namespace AGE
 		}
 		return true;
 	}
+
+	bool TaskThread::tryToStealTasks()
+	{
+		TMQ::MessageBase *task = nullptr;
+		if (TMQ::TaskManager::TaskThreadTryGetTask(task))
+		{
+			auto result = execute(task);
+			assert(result); // we receive a task that we cannot treat
+			return true;
+		}
+		return false;
+	}
 }
\ No newline at end of file
@@ -15,6 +15,8 @@ namespace AGE
 		virtual bool launch();
 		virtual bool stop();
 		bool update();
+		// execute one shared task if there is one, never sleep
+		bool tryToStealTasks();
 	private:
 		TaskThread(Thread::ThreadType type);
 		virtual ~TaskThread();
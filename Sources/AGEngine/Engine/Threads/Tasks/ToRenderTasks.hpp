@@ -2,6 +2,12 @@
 
 #include <TMQ/message.hpp>
 #include <glm/fwd.hpp>
+#include <Skinning/BoneMatrix.hpp>
+
+#include <vector>
+#include <utility>
+#include <memory>
+#include <string>
 
 namespace AGE
 {
@@ -9,14 +15,33 @@ namespace AGE
 	struct DrawableCollection;
 	class Painter;
 	class Vertices;
+	class ATexture;
+	struct DDSImage;
 
 	namespace Tasks
 	{
 		struct UploadBonesToGPU
 		{
-			std::vector<glm::mat4> *bones;
-			UploadBonesToGPU(std::vector<glm::mat4> *_bones)
-				: bones(_bones){}
+			// written in this region of the bones stream, nothing to upload
+			std::size_t region;
+			// or copied from bones, only the dirty ranges (offset, count) if the layout did not change
+			std::vector<BoneMatrix> *bones;
+			const std::vector<std::pair<std::size_t, std::size_t>> *dirty;
+			bool layoutChanged;
+			UploadBonesToGPU(std::size_t _region)
+				: region(_region), bones(nullptr), dirty(nullptr), layoutChanged(false){}
+			UploadBonesToGPU(std::vector<BoneMatrix> *_bones, const std::vector<std::pair<std::size_t, std::size_t>> *_dirty, bool _layoutChanged)
+				: region(std::size_t(-1)), bones(_bones), dirty(_dirty), layoutChanged(_layoutChanged){}
+		};
+		// parsed by a worker, uploaded by the texture streamer
+		struct StreamTexture
+		{
+			std::shared_ptr<ATexture> texture;
+			std::shared_ptr<DDSImage> image;
+			// file of a texture whose levels follow its screen size, see TextureStreamer::push
+			std::string path;
+			StreamTexture(const std::shared_ptr<ATexture> &_texture, const std::shared_ptr<DDSImage> &_image, const std::string &_path = std::string())
+				: texture(_texture), image(_image), path(_path){}
 		};
 		class Render
 		{
@@ -1,5 +1,6 @@
 #include "Thread.hpp"
 #include "ThreadManager.hpp"
+#include <TMQ/queue.hpp>
 
 #include <thread>
 
@@ -23,6 +24,7 @@ namespace AGE
 		_systemId = std::this_thread::get_id().hash();
 		Singleton<ThreadManager>::getInstance()->registerThreadId(_systemId, _id);
 		SetCurrentThread(this);
+		TMQ::TaskManager::RegisterFrameArena();
 		return _id;
 	}
 
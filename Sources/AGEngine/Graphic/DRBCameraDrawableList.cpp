@@ -35,6 +35,14 @@ namespace AGE
 		return *this;
 	}
 
+	DRBCameraDrawableList::~DRBCameraDrawableList()
+	{
+		if (pointLights)
+		{
+			BasicCommandGeneration::PointlightOutput::RecycleOutput(pointLights);
+		}
+	}
+
 	DRBCameraDrawableListCommand::DRBCameraDrawableListCommand(std::shared_ptr<DRBCameraDrawableList> _list)
 		: list(_list)
 	{}
@@ -10,6 +10,7 @@
 #include "Utils/Key.hh"
 
 #include <Render/Pipelining/Prepare/MeshBufferingPrepare.hpp>
+#include <Render/Pipelining/Prepare/PointlightPrepare.hpp>
 
 #include "Render\Pipelining\RenderInfos/SpotlightRenderInfos.hpp"
 #include "Render\Pipelining\RenderInfos/CameraRenderInfos.hpp"
@@ -86,17 +87,10 @@ namespace AGE
 		CameraData data;
 	};
 
-	struct PointlightInfos
-	{
-		glm::vec3 range;
-		glm::vec3 position;
-		glm::mat4 sphereTransform;
-		glm::vec3 colorLight;
-		glm::vec3 ambiantColor;
-	};
-
 	struct DRBCameraDrawableList
 	{
+		~DRBCameraDrawableList();
+
 		SpotlightRenderInfos::Output                  spotlightsOutput;
 		CameraRenderInfos::Output                     camerasOutput;
 
@@ -105,7 +99,8 @@ namespace AGE
 		BasicCommandGeneration::SkinnedMeshAndMaterialOutput *cameraSkinnedMeshs = nullptr;
 
 		std::list<std::shared_ptr<DRBData>> meshs;
-		std::vector<PointlightInfos> pointLights;
+		// filled by the culling tasks, recycled with the list
+		BasicCommandGeneration::PointlightOutput *pointLights = nullptr;
 		CameraInfos cameraInfos;
 	};
 
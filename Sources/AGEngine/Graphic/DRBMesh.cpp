@@ -21,7 +21,10 @@ namespace AGE
 	glm::vec4 DRBMesh::setBFCTransform(const glm::mat4 &transformation)
 	{
 		datas->setTransformation(transformation);
-		return BFCCullableObject::setBFCTransform(transformation);
+		// the item bounds the whole mesh, not only its pivot,
+		// cullers and lod selection rely on it
+		const glm::vec4 pivot = BFCCullableObject::setBFCTransform(transformation);
+		return datas->getBoundingSphere(pivot.w);
 	}
 
 	const std::shared_ptr<DRBMeshData> DRBMesh::getDatas() const
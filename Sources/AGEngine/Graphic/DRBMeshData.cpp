@@ -2,6 +2,11 @@
 
 #include "Render\GeometryManagement\Painting\Painter.hh"
 #include "Render\GeometryManagement\Data\Vertices.hh"
+#include "BFC\BFCOutput.hpp"
+#include "MeshLodOptions.hpp"
+
+#include <algorithm>
+#include <limits>
 
 namespace AGE
 {
@@ -9,6 +14,10 @@ namespace AGE
 	DRBMeshData::DRBMeshData()
 		: DRBData()
 	{
+		for (auto &e : _lastLods)
+		{
+			e = 0;
+		}
 	}
 
 	DRBMeshData::~DRBMeshData()
@@ -38,6 +47,16 @@ namespace AGE
 	void DRBMeshData::setAABB(const AABoundingBox &box)
 	{
 		_boundingBox = box;
+		_boundingRadius = glm::length(box.maxPoint - box.minPoint) * 0.5f;
+	}
+
+	void DRBMeshData::setLodVerticesKeys(const std::vector<Key<Vertices>> &keys)
+	{
+		_lods = keys;
+		for (auto &e : _lastLods)
+		{
+			e = 0;
+		}
 	}
 
 	const Key<Painter> &DRBMeshData::getPainterKey() const
@@ -50,6 +69,83 @@ namespace AGE
 		return _vertices;
 	}
 
+	glm::vec4 DRBMeshData::getBoundingSphere(float scale) const
+	{
+		if (_boundingRadius <= 0.0f)
+		{
+			return glm::vec4(glm::vec3(_transformation[3]), scale);
+		}
+		const glm::vec4 center = _transformation * glm::vec4(_boundingBox.center, 1.0f);
+		return glm::vec4(glm::vec3(center), _boundingRadius * scale);
+	}
+
+	float DRBMeshData::getScreenSize(const BFCOutputView &view, const glm::vec4 &sphere) const
+	{
+		if (view.projectionScale <= 0.0f)
+		{
+			return std::numeric_limits<float>::max();
+		}
+		const float distance = glm::length(glm::vec3(sphere) - view.position);
+		if (distance <= sphere.w)
+		{
+			return std::numeric_limits<float>::max();
+		}
+		return sphere.w * view.projectionScale / distance;
+	}
+
+	std::size_t DRBMeshData::selectLod(const BFCOutputView &view, const glm::vec4 &sphere) const
+	{
+		if (_lods.empty() || view.projectionScale <= 0.0f || MeshLodConfig::g_lod_is_enabled == false)
+		{
+			return 0;
+		}
+		return selectLodForSize(view, getScreenSize(view, sphere));
+	}
+
+	std::size_t DRBMeshData::selectLodForSize(const BFCOutputView &view, float screenSize) const
+	{
+		const std::size_t lodNumber = std::min(_lods.size(), std::size_t(MeshLodConfig::MaxLod));
+		if (lodNumber == 0 || screenSize == std::numeric_limits<float>::max() || MeshLodConfig::g_lod_is_enabled == false)
+		{
+			return 0;
+		}
+		const float size = screenSize * MeshLodConfig::g_lod_bias;
+
+		auto lodForSize = [&](float factor) -> std::size_t
+		{
+			std::size_t lod = 0;
+			while (lod < lodNumber && size < MeshLodConfig::g_lod_screen_sizes[lod] * factor)
+			{
+				++lod;
+			}
+			return lod;
+		};
+
+		if (view.slot >= LodSlots)
+		{
+			return lodForSize(1.0f);
+		}
+
+		// with hysteresis the lod stay the same while it is in [finest, coarsest]
+		const float hysteresis = MeshLodConfig::g_lod_hysteresis;
+		const std::size_t finest = lodForSize(1.0f - hysteresis);
+		const std::size_t coarsest = lodForSize(1.0f + hysteresis);
+
+		auto &last = _lastLods[view.slot];
+		std::size_t lod = std::max(finest, std::min(coarsest, std::size_t(last.load(std::memory_order_relaxed))));
+		last.store(std::uint8_t(lod), std::memory_order_relaxed);
+		return lod;
+	}
+
+	const Key<Vertices> &DRBMeshData::getLodVerticesKey(std::size_t lod) const
+	{
+		if (lod == 0 || lod > _lods.size())
+		{
+			return _vertices;
+		}
+		return _lods[lod - 1];
+	}
+
 	bool DRBMeshData::hadRenderMode(RenderModes mode) const
 	{
 		return _renderMode.test(mode);
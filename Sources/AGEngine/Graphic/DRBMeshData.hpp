@@ -5,13 +5,22 @@
 #include "Utils/AABoundingBox.hh"
 #include "Utils/Key.hh"
 
+#include <atomic>
+#include <vector>
+
 namespace AGE
 {
 	class Painter;
 	class Vertices;
+	struct BFCOutputView;
 
 	struct DRBMeshData : public DRBData
 	{
+		// lod state of the main camera, other views select their lod
+		// without hysteresis (see BFCOutputView::slot)
+		static const std::size_t LodSlots = 1;
+		static const std::uint8_t CameraLodSlot = 0;
+
 		DRBMeshData();
 		virtual ~DRBMeshData();
 
@@ -20,13 +29,29 @@ namespace AGE
 		void setRenderMode(RenderModes mode, bool activate);
 		void setRenderModes(const RenderModeSet &modes);
 		void setAABB(const AABoundingBox &box);
+		void setLodVerticesKeys(const std::vector<Key<Vertices>> &keys);
 		const Key<Painter> &getPainterKey() const;
 		const Key<Vertices> &getVerticesKey() const;
 		bool hadRenderMode(RenderModes mode) const;
 		AABoundingBox getAABB() const;
+		// world bounding sphere of the mesh with the last transformation,
+		// scale is the max scale of the transformation
+		// without bounding box it is the pivot with scale as radius
+		glm::vec4 getBoundingSphere(float scale) const;
+		// 0 is the full detail, sphere is the bounding sphere of the BFC item
+		// called concurrently by the culling tasks
+		std::size_t selectLod(const BFCOutputView &view, const glm::vec4 &sphere) const;
+		std::size_t selectLodForSize(const BFCOutputView &view, float screenSize) const;
+		// projected radius of the bounds, FLT_MAX when the view is inside them or has no projection
+		float getScreenSize(const BFCOutputView &view, const glm::vec4 &sphere) const;
+		const Key<Vertices> &getLodVerticesKey(std::size_t lod) const;
+		inline std::size_t getLodNumber() const { return _lods.size() + 1; }
 	private:
 		Key<Painter> _painter;
 		Key<Vertices> _vertices;
+		std::vector<Key<Vertices>> _lods;
+		float _boundingRadius = 0.0f;
+		mutable std::atomic<std::uint8_t> _lastLods[LodSlots];
 		RenderModeSet _renderMode;
 		AABoundingBox _boundingBox;
 	};
@@ -1,12 +1,15 @@
 #include "DRBSkinnedMesh.hpp"
 #include "DRBMeshData.hpp"
 
+#include <cstring>
+
 namespace AGE
 {
 	DRBSkinnedMesh::DRBSkinnedMesh()
 		: DRBMesh(BFCCullableType::CullableSkinnedMesh)
 	{
 		datas->setRenderMode(RenderModes::AGE_SKINNED, true);
+		_screenSize = 0;
 	}
 
 	DRBSkinnedMesh::~DRBSkinnedMesh()
@@ -17,4 +20,22 @@ namespace AGE
 		_skinningMatrixIndex = size;
 	}
 
+	void DRBSkinnedMesh::reportScreenSize(float size)
+	{
+		std::uint32_t bits;
+		std::memcpy(&bits, &size, sizeof(bits));
+		auto current = _screenSize.load(std::memory_order_relaxed);
+		while (current < bits && _screenSize.compare_exchange_weak(current, bits, std::memory_order_relaxed) == false)
+		{
+		}
+	}
+
+	float DRBSkinnedMesh::consumeScreenSize()
+	{
+		const std::uint32_t bits = _screenSize.exchange(0, std::memory_order_relaxed);
+		float size;
+		std::memcpy(&size, &bits, sizeof(size));
+		return size;
+	}
+
 }
\ No newline at end of file
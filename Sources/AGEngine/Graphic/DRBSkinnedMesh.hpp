@@ -2,6 +2,8 @@
 
 #include "DRBMesh.hpp"
 
+#include <atomic>
+
 namespace AGE
 {
 	class SkeletonProperty;
@@ -18,8 +20,15 @@ namespace AGE
 
 		inline std::size_t getSkinningIndex() const { return _skinningMatrixIndex; }
 		void setSkinningMatrix(std::size_t size);
+
+		// called concurrently by the culling tasks of all the views the mesh is visible in
+		void reportScreenSize(float size);
+		// biggest size reported since the last call, 0 if it was culled everywhere
+		float consumeScreenSize();
 	private:
 		std::size_t _skinningMatrixIndex;
+		// bits of a positive float, they are ordered like the floats
+		std::atomic<std::uint32_t> _screenSize;
 		friend class GraphicElementManager;
 	}; 
 }
\ No newline at end of file
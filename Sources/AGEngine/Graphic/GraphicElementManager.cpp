@@ -40,6 +40,7 @@ namespace AGE
 
 
 			drbMesh->datas->setVerticesKey(submesh.vertices);
+			drbMesh->datas->setLodVerticesKeys(submesh.lods);
 			drbMesh->datas->setPainterKey(submesh.painter);
 			drbMesh->datas->setAABB(submesh.boundingBox);
 
@@ -0,0 +1,9 @@
+#include "MeshLodOptions.hpp"
+
+namespace AGE
+{
+	bool MeshLodConfig::g_lod_is_enabled = true;
+	float MeshLodConfig::g_lod_screen_sizes[MeshLodConfig::MaxLod] = { 0.25f, 0.1f, 0.04f, 0.016f, 0.0064f, 0.0025f };
+	float MeshLodConfig::g_lod_hysteresis = 0.1f;
+	float MeshLodConfig::g_lod_bias = 1.0f;
+}
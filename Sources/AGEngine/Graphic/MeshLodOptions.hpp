@@ -0,0 +1,20 @@
+#pragma once
+
+namespace AGE
+{
+	class MeshLodConfig
+	{
+	public:
+		static const unsigned int MaxLod = 6;
+		// Mesh outputs choose a lod from the projected radius of the mesh
+		// (fraction of the half screen height)
+		static bool g_lod_is_enabled;
+		// lod i + 1 is used under g_lod_screen_sizes[i]
+		static float g_lod_screen_sizes[MaxLod];
+		// a lod change need the size to cross the threshold of this ratio
+		// so objects near a threshold do not switch every frame
+		static float g_lod_hysteresis;
+		// multiply the projected sizes, lower bias use coarser lods sooner
+		static float g_lod_bias;
+	};
+}
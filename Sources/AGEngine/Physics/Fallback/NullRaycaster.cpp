@@ -21,5 +21,15 @@ namespace AGE
 		{
 			return std::vector<RaycastHit>();
 		}
+
+		std::size_t NullRaycaster::query(const PhysicsQuery &query, RaycastHit *hits)
+		{
+			return 0;
+		}
+
+		bool NullRaycaster::supportsParallelQueries(void) const
+		{
+			return true;
+		}
 	}
 }
\ No newline at end of file
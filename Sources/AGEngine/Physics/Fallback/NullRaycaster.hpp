@@ -27,6 +27,10 @@ namespace AGE
 			bool raycast(const glm::vec3 &origin, const glm::vec3 &direction, float distance, LayerMask layers) override final;
 
 			std::vector<RaycastHit> raycastAll(const glm::vec3 &origin, const glm::vec3 &direction, float distance, LayerMask layers) override final;
+
+			std::size_t query(const PhysicsQuery &query, RaycastHit *hits) override final;
+
+			bool supportsParallelQueries(void) const override final;
 		};
 	}
 }
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <limits>
+
+#include <glm/glm.hpp>
+
+#include "QueryType.hpp"
+#include "FilterGroup.hpp"
+
+namespace AGE
+{
+	namespace Physics
+	{
+		struct PhysicsQuery final
+		{
+			// Attributes
+			QueryType type = QueryType::Raycast;
+
+			glm::vec3 origin = glm::vec3(0.0f);
+
+			// Not used by overlaps
+			glm::vec3 direction = glm::vec3(0.0f, 0.0f, -1.0f);
+
+			float distance = std::numeric_limits<float>::max();
+
+			// Radius of the sphere swept or tested, has to be positive for sweeps and overlaps
+			float radius = 0.0f;
+
+			LayerMask layers = LayerMask::Default;
+
+			// The hits are written from firstHit in the buffer given with the batch
+			std::size_t firstHit = 0;
+
+			// The closest hit is written if maxHits is 1, the hits are sorted by distance otherwise
+			std::size_t maxHits = 1;
+		};
+	}
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+
+namespace AGE
+{
+	namespace Physics
+	{
+		enum class QueryType : std::uint8_t
+		{
+			Raycast,
+			Sweep,
+			Overlap
+		};
+	}
+}
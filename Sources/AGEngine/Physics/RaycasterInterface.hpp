@@ -6,6 +6,7 @@
 #include <glm/glm.hpp>
 
 #include "RaycastHit.hpp"
+#include "PhysicsQuery.hpp"
 #include "FilterGroup.hpp"
 
 namespace AGE
@@ -39,6 +40,19 @@ namespace AGE
 
 			virtual std::vector<RaycastHit> raycastAll(const glm::vec3 &origin, const glm::vec3 &direction, float distance = std::numeric_limits<float>::max(), LayerMask layers = LayerMask::Default) = 0;
 
+			// Runs the queries on the worker threads if the backend supports it, on the calling thread otherwise.
+			// The hits of queries[i] are written in hits + queries[i].firstHit and their number in hitNumbers[i].
+			// The world must not be modified until it returns.
+			void queryBatch(const PhysicsQuery *queries, std::size_t numberOfQueries, RaycastHit *hits, std::size_t *hitNumbers, std::size_t queriesPerTask = 64);
+
+			// Writes at most query.maxHits hits and returns their number
+			// Can be called from several threads at once only if supportsParallelQueries returns true
+			virtual std::size_t query(const PhysicsQuery &query, RaycastHit *hits) = 0;
+
+			// True if query only reads the world, PhysX and Null do.
+			// Bullet queries share scratch memory of the world, they run one at a time.
+			virtual bool supportsParallelQueries(void) const = 0;
+
 		protected:
 			// Attributes
 			WorldInterface *world = nullptr;
@@ -1,9 +1,13 @@
 #pragma once
 
 #include <cassert>
+#include <algorithm>
 
 #include "RaycasterInterface.hpp"
 
+#include <Threads/TaskScheduler.hpp>
+#include <Utils/Profiler.hpp>
+
 namespace AGE
 {
 	namespace Physics
@@ -25,5 +29,33 @@ namespace AGE
 		{
 			return world;
 		}
+
+		inline void RaycasterInterface::queryBatch(const PhysicsQuery *queries, std::size_t numberOfQueries, RaycastHit *hits, std::size_t *hitNumbers, std::size_t queriesPerTask /* = 64 */)
+		{
+			SCOPE_profile_cpu_function("Physic");
+			const std::size_t batchSize = std::max(queriesPerTask, std::size_t(1));
+			if (!supportsParallelQueries() || numberOfQueries <= batchSize)
+			{
+				for (std::size_t index = 0; index < numberOfQueries; ++index)
+				{
+					hitNumbers[index] = query(queries[index], hits + queries[index].firstHit);
+				}
+				return;
+			}
+			TaskGraph graph;
+			for (std::size_t from = 0; from < numberOfQueries; from += batchSize)
+			{
+				const std::size_t to = std::min(from + batchSize, numberOfQueries);
+				graph.addJob([this, queries, hits, hitNumbers, from, to]()
+				{
+					for (std::size_t index = from; index < to; ++index)
+					{
+						hitNumbers[index] = query(queries[index], hits + queries[index].firstHit);
+					}
+				});
+			}
+			graph.launch();
+			graph.wait();
+		}
 	}
 }
\ No newline at end of file
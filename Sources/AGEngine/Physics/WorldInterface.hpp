@@ -2,6 +2,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <glm/glm.hpp>
 
@@ -93,8 +94,46 @@ namespace AGE
 
 			bool isDebugEnabled(void) const;
 
+			void enableFixedTimestep(void);
+
+			void disableFixedTimestep(void);
+
+			bool isFixedTimestepEnabled(void) const;
+
+			void setMaxSubSteps(std::size_t maxSubSteps);
+
+			std::size_t getMaxSubSteps(void) const;
+
 			void update(float elapsedTime);
 
+			// Runs the steps of the frame but the last one
+			void beginUpdate(float elapsedTime);
+
+			// Starts the last step of the frame, asynchronously if the plugin supports it
+			// until then the bodies are at their pose one step before the end of the frame
+			void simulateLastStep(void);
+
+			// Waits for the step started by simulateLastStep
+			void endUpdate(void);
+
+			// Fills the debug draw on the render frames, needs the engine
+			void updateDebugInformation(void);
+
+			bool isSimulating(void) const;
+
+			// Number of steps done by the last update
+			std::size_t getStepCount(void) const;
+
+			// Time simulated by the steps gathered by the last endUpdate
+			double getSimulatedTime(void) const;
+
+			// Factor between the two last gathered steps, they are read one step late
+			// at the time of the frame which started them
+			float getInterpolationFactor(void) const;
+
+			// Bodies moved by the steps of the last update, a body moved by several steps is there several times
+			const std::vector<Private::GenericData *> &getActiveBodies(void) const;
+
 			void setFilterNameForFilterGroup(FilterGroup group, const std::string &name);
 
 			const std::string &getFilterNameForFilterGroup(FilterGroup group) const;
@@ -124,6 +163,9 @@ namespace AGE
 
 			virtual void fillDebugInformation(DebugDrawManager *debugDrawManager) = 0;
 
+			// If false, the active bodies are not reported and all the bodies have to be read after an update
+			virtual bool reportsActiveBodies(void) const;
+
 		protected:
 			// Type Aliases
 			using MaterialTable = std::unordered_map < std::string, std::pair < MaterialInterface *, std::atomic_uint32_t > >;
@@ -143,10 +185,26 @@ namespace AGE
 			// Static Methods
 			static glm::vec3 GetDefaultGravity(void);
 
+			// Methods
+			void addActiveBody(Private::GenericData *data);
+
 		private:
 			// Type Aliases
 			using HashTable = std::unordered_map < std::string, FilterGroup > ;
 
+			struct UpdateTimes
+			{
+				// Time simulated by the steps, the dropped time is not counted
+				double simulatedTime = 0.0;
+
+				// Time of the frame, ahead of the simulated time by what is left in the accumulator
+				double frameTime = 0.0;
+
+				float stepSize = 0.0f;
+
+				bool fixedTimestep = true;
+			};
+
 			// Attributes
 			AssetsManager *assetManager;
 
@@ -162,6 +220,21 @@ namespace AGE
 
 			float accumulator = 0.0f;
 
+			bool fixedTimestepEnabled = true;
+
+			std::size_t maxSubSteps = 4;
+
+			std::size_t stepCount = 0;
+
+			bool simulating = false;
+
+			// Times of the steps started by the last beginUpdate and of the ones gathered by the last endUpdate
+			UpdateTimes startedTimes;
+
+			UpdateTimes fetchedTimes;
+
+			std::vector<Private::GenericData *> activeBodies;
+
 			bool debugEnabled = false;
 
 			HashTable filterNameToFilterGroup;
@@ -192,6 +265,12 @@ namespace AGE
 			virtual void destroyCollider(ColliderInterface *collider) = 0;
 
 			virtual void simulate(float stepSize) = 0;
+
+			// Starts a step without waiting for it, synchronous by default
+			virtual void simulateAsync(float stepSize);
+
+			// Waits for the step started by simulateAsync
+			virtual void fetchResults(void);
 		};
 	}
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <fstream>
+#include <limits>
 
 #include <cereal/cereal.hpp>
 #include <cereal/types/string.hpp>
@@ -184,25 +185,151 @@ namespace AGE
 			return debugEnabled;
 		}
 
+		inline void WorldInterface::enableFixedTimestep(void)
+		{
+			fixedTimestepEnabled = true;
+		}
+
+		inline void WorldInterface::disableFixedTimestep(void)
+		{
+			fixedTimestepEnabled = false;
+			accumulator = 0.0f;
+		}
+
+		inline bool WorldInterface::isFixedTimestepEnabled(void) const
+		{
+			return fixedTimestepEnabled;
+		}
+
+		inline void WorldInterface::setMaxSubSteps(std::size_t maxSubSteps)
+		{
+			assert(maxSubSteps > 0 && "Invalid maxSubSteps");
+			this->maxSubSteps = maxSubSteps;
+		}
+
+		inline std::size_t WorldInterface::getMaxSubSteps(void) const
+		{
+			return maxSubSteps;
+		}
+
 		inline void WorldInterface::update(float elapsedTime)
 		{
-			//if (isDebugEnabled())
-			//{
-			//	debugInformation = DebugInformation();
-			//}
-			simulate(elapsedTime);
+			beginUpdate(elapsedTime);
+			simulateLastStep();
+			endUpdate();
+			updateDebugInformation();
+		}
+
+		inline void WorldInterface::beginUpdate(float elapsedTime)
+		{
+			assert(!simulating && "Simulation already running");
+			activeBodies.clear();
+			startedTimes.fixedTimestep = fixedTimestepEnabled;
+			if (!fixedTimestepEnabled)
+			{
+				stepCount = elapsedTime > std::numeric_limits<float>::epsilon() ? 1 : 0;
+				startedTimes.stepSize = elapsedTime;
+				startedTimes.simulatedTime += static_cast<double>(stepCount) * static_cast<double>(elapsedTime);
+				startedTimes.frameTime = startedTimes.simulatedTime;
+				return;
+			}
+			const float stepSize = 1.0f / static_cast<float>(targetFPS);
+			accumulator += elapsedTime;
+			stepCount = static_cast<std::size_t>(accumulator / stepSize);
+			if (stepCount > maxSubSteps)
+			{
+				// too slow to catch up, the time left is dropped
+				stepCount = maxSubSteps;
+				accumulator = static_cast<float>(maxSubSteps) * stepSize;
+			}
+			accumulator -= static_cast<float>(stepCount) * stepSize;
+			startedTimes.stepSize = stepSize;
+			startedTimes.simulatedTime += static_cast<double>(stepCount) * static_cast<double>(stepSize);
+			startedTimes.frameTime = startedTimes.simulatedTime + static_cast<double>(accumulator);
+			for (std::size_t index = 0; index + 1 < stepCount; ++index)
+			{
+				simulate(stepSize);
+			}
+		}
+
+		inline void WorldInterface::simulateLastStep(void)
+		{
+			assert(!simulating && "Simulation already running");
+			if (stepCount != 0)
+			{
+				simulateAsync(startedTimes.stepSize);
+				simulating = true;
+			}
+		}
+
+		inline void WorldInterface::endUpdate(void)
+		{
+			if (simulating)
+			{
+				fetchResults();
+				simulating = false;
+			}
+			fetchedTimes = startedTimes;
+		}
+
+		inline void WorldInterface::updateDebugInformation(void)
+		{
 			if (GetMainThread()->isRenderFrame() == true && GetEngine()->hasInstance<DebugDrawManager>())
 			{
 				auto debugDrawer = GetEngine()->getInstance<DebugDrawManager>();
 				fillDebugInformation(debugDrawer);
 			}
-			/*const float stepSize = 1.0f / static_cast<float>(targetFPS);
-			accumulator += elapsedTime;
-			while (accumulator >= stepSize)
+		}
+
+		inline bool WorldInterface::isSimulating(void) const
+		{
+			return simulating;
+		}
+
+		inline std::size_t WorldInterface::getStepCount(void) const
+		{
+			return stepCount;
+		}
+
+		inline double WorldInterface::getSimulatedTime(void) const
+		{
+			return fetchedTimes.simulatedTime;
+		}
+
+		inline float WorldInterface::getInterpolationFactor(void) const
+		{
+			if (!fetchedTimes.fixedTimestep || fetchedTimes.stepSize <= std::numeric_limits<float>::epsilon())
 			{
-				simulate(stepSize);
-				accumulator -= stepSize;
-			}*/
+				return 1.0f;
+			}
+			// the two last steps cover [simulatedTime - stepSize, simulatedTime], they are read at frameTime - stepSize
+			const double factor = (fetchedTimes.frameTime - fetchedTimes.simulatedTime) / static_cast<double>(fetchedTimes.stepSize);
+			return glm::clamp(static_cast<float>(factor), 0.0f, 1.0f);
+		}
+
+		inline const std::vector<Private::GenericData *> &WorldInterface::getActiveBodies(void) const
+		{
+			return activeBodies;
+		}
+
+		inline bool WorldInterface::reportsActiveBodies(void) const
+		{
+			return false;
+		}
+
+		inline void WorldInterface::addActiveBody(Private::GenericData *data)
+		{
+			activeBodies.push_back(data);
+		}
+
+		inline void WorldInterface::simulateAsync(float stepSize)
+		{
+			simulate(stepSize);
+		}
+
+		inline void WorldInterface::fetchResults(void)
+		{
+			return;
 		}
 
 		inline void WorldInterface::setFilterNameForFilterGroup(FilterGroup group, const std::string &name)
@@ -0,0 +1,87 @@
+#include <Render/Buffer/MaterialBuffer.hh>
+#include <Utils/OpenGL.hh>
+#include <AssetManagement/Instance/MaterialInstance.hh>
+
+#include <algorithm>
+#include <cstring>
+
+namespace AGE
+{
+	namespace
+	{
+		const std::size_t g_initialCapacity = 64;
+	}
+
+	MaterialBuffer::MaterialBuffer()
+	{
+	}
+
+	MaterialBuffer::~MaterialBuffer()
+	{
+	}
+
+	void MaterialBuffer::bindProgram(unsigned int program)
+	{
+		const GLuint index = glGetUniformBlockIndex(program, "material_block");
+		if (index != GL_INVALID_INDEX)
+		{
+			glUniformBlockBinding(program, index, BindingPoint);
+		}
+	}
+
+	std::size_t MaterialBuffer::getSlot(const MaterialInstance &material)
+	{
+		if (material.uniformSlot != std::size_t(-1))
+		{
+			return material.uniformSlot;
+		}
+		if (_buffer == 0)
+		{
+			GLint alignment = 0;
+			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+			alignment = std::max(alignment, GLint(1));
+			_stride = (sizeof(Block) + std::size_t(alignment) - 1) / std::size_t(alignment) * std::size_t(alignment);
+			glGenBuffers(1, &_buffer);
+		}
+
+		Block block;
+		block.diffuse = material.diffuse;
+		block.specular = material.specular;
+		block.shininess = material.shininess;
+		block.scaleUVs = material.scaleUVs ? 1.0f : 0.0f;
+		block.padding[0] = block.padding[1] = 0.0f;
+
+		const std::size_t slot = _slotNumber++;
+		_blocks.resize(_slotNumber * _stride);
+		std::memcpy(_blocks.data() + slot * _stride, &block, sizeof(Block));
+		glBindBuffer(GL_UNIFORM_BUFFER, _buffer);
+		if (_slotNumber > _capacity)
+		{
+			_capacity = std::max(g_initialCapacity, _capacity * 2);
+			glBufferData(GL_UNIFORM_BUFFER, GLsizeiptr(_capacity * _stride), nullptr, GL_STATIC_DRAW);
+			glBufferSubData(GL_UNIFORM_BUFFER, 0, GLsizeiptr(_blocks.size()), _blocks.data());
+		}
+		else
+		{
+			glBufferSubData(GL_UNIFORM_BUFFER, GLintptr(slot * _stride), sizeof(Block), &block);
+		}
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+		material.uniformSlot = slot;
+		return slot;
+	}
+
+	void MaterialBuffer::bind(std::size_t slot) const
+	{
+		glBindBufferRange(GL_UNIFORM_BUFFER, BindingPoint, _buffer, GLintptr(slot * _stride), sizeof(Block));
+	}
+
+	void MaterialBuffer::release()
+	{
+		if (_buffer != 0)
+		{
+			glDeleteBuffers(1, &_buffer);
+		}
+		_buffer = 0;
+		_capacity = 0;
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace AGE
+{
+	struct MaterialInstance;
+
+	// Parameters of the materials drawn by the buffering passes, in one uniform buffer
+	// A material is uploaded the first time it is drawn and keeps its block,
+	// a draw only binds the range of its material. There is one, owned by the render thread.
+	class MaterialBuffer
+	{
+	public:
+		// std140 layout of the material_block of the buffering shaders
+		struct Block
+		{
+			glm::vec4 diffuse;
+			glm::vec4 specular;
+			float shininess;
+			float scaleUVs;
+			float padding[2];
+		};
+		// the uniform blocks of the program resources are numbered from 0
+		static const unsigned int BindingPoint = 15;
+
+		MaterialBuffer();
+		~MaterialBuffer();
+		MaterialBuffer(const MaterialBuffer &) = delete;
+		MaterialBuffer &operator=(const MaterialBuffer &) = delete;
+
+		// the uniform block of the program is bound to BindingPoint, once per link
+		static void bindProgram(unsigned int program);
+		// uploads the material the first time it is seen
+		std::size_t getSlot(const MaterialInstance &material);
+		void bind(std::size_t slot) const;
+		void release();
+
+		inline std::size_t getMaterialNumber() const { return _slotNumber; }
+	private:
+		// GLuint, the header is included by the render thread one
+		unsigned int _buffer = 0;
+		// size of a block rounded up to the offset alignment of the uniform buffers
+		std::size_t _stride = 0;
+		std::size_t _slotNumber = 0;
+		std::size_t _capacity = 0;
+		// copy of the blocks, to fill the buffer again when it grows
+		std::vector<char> _blocks;
+	};
+}
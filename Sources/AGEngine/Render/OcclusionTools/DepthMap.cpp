@@ -20,6 +20,7 @@ namespace AGE
 			--mipMapCounter;
 		}
 		_buffer.resize(_mipmapHeight * _mipmapWidth, -1);
+		_pyramid.clear();
 	}
 
 	bool DepthMap::testPixel(uint32_t pixelDepth, std::size_t x, std::size_t y) const
@@ -69,4 +70,6 @@ namespace AGE
 	glm::mat4 DepthMap::getMV() const { return _mv; }
 	std::size_t DepthMap::getMipmapWidth() const { return _mipmapWidth; }
 	std::size_t DepthMap::getMipmapHeight() const { return _mipmapHeight; }
+	std::size_t DepthMap::getWidth() const { return _width; }
+	std::size_t DepthMap::getHeight() const { return _height; }
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include <vector>
 #include <glm/glm.hpp>
 
+#include <BFC/BFCDepthPyramid.hpp>
+
 namespace AGE
 {
 	class DepthMapHandle;
@@ -16,6 +18,10 @@ namespace AGE
 		glm::mat4 getMV() const;
 		std::size_t getMipmapWidth() const;
 		std::size_t getMipmapHeight() const;
+		std::size_t getWidth() const;
+		std::size_t getHeight() const;
+		// built by the writer from the buffer, used by the occlusion cullers
+		inline const BFCDepthPyramid &getPyramid() const { return _pyramid; }
 	private:
 		std::vector<uint32_t> _buffer;
 		std::size_t _width;
@@ -24,6 +30,7 @@ namespace AGE
 		std::size_t _mipmapWidth;
 		std::size_t _mipmapHeight;
 		glm::mat4 _mv;
+		BFCDepthPyramid _pyramid;
 		friend class DepthMapHandle;
 	};
 }
\ No newline at end of file
@@ -38,6 +38,12 @@ namespace AGE
 		_map->_mv = mv;
 	}
 
+	void DepthMapHandle::buildPyramid()
+	{
+		AGE_ASSERT(isWritable());
+		_map->_pyramid.buildFromDepthStencil(_map->_buffer.data(), _map->_mipmapWidth, _map->_mipmapHeight, _map->_mv);
+	}
+
 	DepthMapHandle::DepthMapHandle(DepthMapManager *managerPtr, DepthMap *map, std::size_t index, DepthMapManager::Status status)
 		: _manager(managerPtr)
 		, _map(map)
@@ -16,6 +16,8 @@ namespace AGE
 		bool isWritable() const;
 		std::vector<uint32_t> &getWritableBuffer();
 		void setMV(const glm::mat4 &mv);
+		// to call once the buffer and the matrix are written
+		void buildPyramid();
 	private:
 		DepthMapHandle(AGE::DepthMapManager *managerPtr, DepthMap *map, std::size_t index, DepthMapManager::Status status);
 		DepthMapManager *_manager = nullptr;
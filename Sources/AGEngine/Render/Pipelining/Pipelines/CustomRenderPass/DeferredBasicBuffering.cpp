@@ -2,6 +2,7 @@
 #include <Render/Pipelining/Pipelines/CustomRenderPass/DeferredBasicBuffering.hh>
 
 #include <memory>
+#include <algorithm>
 
 #include <Render/Textures/Texture2D.hh>
 #include <Render/OpenGLTask/OpenGLState.hh>
@@ -9,12 +10,13 @@
 
 #include <Render/ProgramResources/Types/Uniform/Mat4.hh>
 #include <Render/ProgramResources/Types/Uniform/Vec1.hh>
-#include <Render/ProgramResources/Types/Uniform/Vec4.hh>
 #include <Render/ProgramResources/Types/Uniform/Sampler/Sampler2D.hh>
+#include <Render/Buffer/MaterialBuffer.hh>
 
 #include <Core/ConfigurationManager.hpp>
 #include <Core/Engine.hh>
 #include <Configuration.hpp>
+#include <Skinning/BoneMatrix.hpp>
 #include <Threads/RenderThread.hpp>
 #include <Threads/ThreadManager.hpp>
 #include <Render/OcclusionTools/DepthMapHandle.hpp>
@@ -115,7 +117,118 @@ namespace AGE
 
 		_positionBuffer = createRenderPassOutput<TextureBuffer>(_maxInstanciedShadowCaster, GL_RGBA32F, _sizeofMatrix, GL_DYNAMIC_DRAW);
 
+		glGenBuffers(2, _depthPbos);
+		_resizeDepthPbos(_frame_buffer.width(), _frame_buffer.height());
 	}
+
+	void DeferredBasicBuffering::_resizeDepthPbos(std::size_t width, std::size_t height)
+	{
+		// orphaned, the pending read back of the old size is dropped
+		for (std::size_t i = 0; i < 2; ++i)
+		{
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, _depthPbos[i]);
+			glBufferData(GL_PIXEL_PACK_BUFFER, GLsizeiptr(width * height * sizeof(uint32_t)), nullptr, GL_STREAM_READ);
+			_depthPboFilled[i] = false;
+		}
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		_depthPboWidth = width;
+		_depthPboHeight = height;
+	}
+
+	void DeferredBasicBuffering::_readBackDepth(const glm::mat4 &viewProj)
+	{
+		SCOPE_profile_gpu_i("Read back depth");
+		SCOPE_profile_cpu_i("RenderTimer", "Read back depth");
+
+		const std::size_t width = _frame_buffer.width();
+		const std::size_t height = _frame_buffer.height();
+		if (width != _depthPboWidth || height != _depthPboHeight)
+		{
+			_resizeDepthPbos(width, height);
+		}
+
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, _depthPbos[_depthPboIndex]);
+		glReadPixels(0, 0, GLsizei(width), GLsizei(height), GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, nullptr);
+		_depthPboMatrices[_depthPboIndex] = viewProj;
+		_depthPboFilled[_depthPboIndex] = true;
+
+		// the other buffer was filled last frame
+		_depthPboIndex = (_depthPboIndex + 1) % 2;
+		if (_depthPboFilled[_depthPboIndex])
+		{
+			_depthPboFilled[_depthPboIndex] = false;
+			auto depthMap = GetRenderThread()->getDepthMapManager().getWritableMap();
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, _depthPbos[_depthPboIndex]);
+			auto pixels = (const uint32_t *)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+			if (pixels && depthMap.isValid())
+			{
+				// each texel of the map keep the farthest depth of the pixels it covers
+				auto &buffer = depthMap.getWritableBuffer();
+				const std::size_t mapWidth = depthMap->getMipmapWidth();
+				const std::size_t mapHeight = depthMap->getMipmapHeight();
+				for (std::size_t y = 0; y < mapHeight; ++y)
+				{
+					const std::size_t fromY = y * height / mapHeight;
+					const std::size_t toY = std::max(fromY + 1, (y + 1) * height / mapHeight);
+					for (std::size_t x = 0; x < mapWidth; ++x)
+					{
+						const std::size_t fromX = x * width / mapWidth;
+						const std::size_t toX = std::max(fromX + 1, (x + 1) * width / mapWidth);
+						uint32_t farthest = 0;
+						for (std::size_t py = fromY; py < toY; ++py)
+						{
+							for (std::size_t px = fromX; px < toX; ++px)
+							{
+								farthest = std::max(farthest, pixels[px + py * width] & 0xFFFFFF00);
+							}
+						}
+						buffer[x + y * mapWidth] = farthest;
+					}
+				}
+				depthMap.setMV(_depthPboMatrices[_depthPboIndex]);
+				depthMap.buildPyramid();
+			}
+			if (pixels)
+			{
+				glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+			}
+		}
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	}
+	DeferredBasicBuffering::BufferingHandles &DeferredBasicBuffering::_getHandles(std::size_t program)
+	{
+		auto &handles = _handles[program];
+		auto &prog = *_programs[program];
+		if (prog.resolveHandles(handles.version))
+		{
+			MaterialBuffer::bindProgram(prog.id());
+			handles.projection = prog.get_resource<Mat4>(StringID("projection_matrix", 0x92b1e336c34a1224));
+			handles.view = prog.get_resource<Mat4>(StringID("view_matrix", 0xd15d560e7965726c));
+			handles.modelMatrices = prog.get_resource<SamplerBuffer>(StringID("model_matrix_tbo", 0x6532aea46fc01c3a));
+			handles.matrixOffset = prog.get_resource<Vec1>(StringID("matrixOffset", 0xb870d9a9a2c195f7));
+			handles.diffuseMap = prog.get_resource<Sampler2D>(StringID("diffuse_map", 0x1930bc220c3b5c20));
+			handles.normalMap = prog.get_resource<Sampler2D>(StringID("normal_map", 0xda3297075023f6d7));
+			handles.bonesMatrices = prog.get_resource<SamplerBuffer>(StringID("bones_matrix_tbo", 0x3a7f8c7debc73024));
+			handles.bonesMatrixSize = prog.get_resource<Vec1>(StringID("bonesMatrixSize", 0x830574b6c5cb2344));
+			handles.bonesOffset = prog.get_resource<Vec1>(StringID("bonesOffset", 0xc8c5f289dcfef0cf));
+		}
+		return handles;
+	}
+
+	void DeferredBasicBuffering::_setMaterial(BufferingHandles &handles, const MaterialInstance *material, const MaterialInstance *&current)
+	{
+		// the commands are sorted by material
+		if (material == current)
+		{
+			return;
+		}
+		current = material;
+		auto &materials = GetRenderThread()->getMaterialBuffer();
+		materials.bind(materials.getSlot(*material));
+		handles.diffuseMap.set(material->diffuseTex);
+		handles.normalMap.set(material->normalTex);
+	}
+
 	void DeferredBasicBuffering::renderPass(const DRBCameraDrawableList &infos)
 	{
 		auto toDraw = infos.cameraMeshs;
@@ -149,10 +262,11 @@ namespace AGE
 			SCOPE_profile_cpu_i("RenderTimer", "Draw occluded objects");
 
 			_programs[PROGRAM_BUFFERING]->use();
-			_programs[PROGRAM_BUFFERING]->get_resource<Mat4>(StringID("projection_matrix", 0x92b1e336c34a1224)).set(infos.cameraInfos.data.projection);
-			_programs[PROGRAM_BUFFERING]->get_resource<Mat4>(StringID("view_matrix", 0xd15d560e7965726c)).set(infos.cameraInfos.view);
-			_programs[PROGRAM_BUFFERING]->get_resource<SamplerBuffer>(StringID("model_matrix_tbo", 0x6532aea46fc01c3a)).set(_positionBuffer);
-			auto matrixOffset = _programs[PROGRAM_BUFFERING]->get_resource<Vec1>(StringID("matrixOffset", 0xb870d9a9a2c195f7));
+			auto &handles = _getHandles(PROGRAM_BUFFERING);
+			handles.projection.set(infos.cameraInfos.data.projection);
+			handles.view.set(infos.cameraInfos.view);
+			handles.modelMatrices.set(_positionBuffer);
+			const MaterialInstance *material = nullptr;
 
 			_positionBuffer->resetOffset();
 
@@ -175,17 +289,11 @@ namespace AGE
 
 				if (painterKey.isValid())
 				{
-					_programs[PROGRAM_BUFFERING]->get_resource<Vec4>     (StringID("diffuse_color", 0x011da378d8e2a2c9)).set(current.material->diffuse);
-					_programs[PROGRAM_BUFFERING]->get_resource<Sampler2D>(StringID("diffuse_map", 0x1930bc220c3b5c20)).set(current.material->diffuseTex);
-					_programs[PROGRAM_BUFFERING]->get_resource<Vec4>     (StringID("specular_color", 0x747083b1ac56a160)).set(current.material->specular);
-					_programs[PROGRAM_BUFFERING]->get_resource<Vec1>     (StringID("shininess_ratio", 0xf147b658a317675f)).set(current.material->shininess);
-					_programs[PROGRAM_BUFFERING]->get_resource<Sampler2D>(StringID("normal_map", 0xda3297075023f6d7)).set(current.material->normalTex);
-					_programs[PROGRAM_BUFFERING]->get_resource<Vec1>     (StringID("scaleUvs", 0xb70d8ad72513d8a7)).set(current.material->scaleUVs);
-
+					_setMaterial(handles, current.material, material);
 
 					painter = _painterManager->get_painter(painterKey);
 					painter->instanciedDrawBegin(_programs[PROGRAM_BUFFERING]);
-					matrixOffset.set(float(current.from));
+					handles.matrixOffset.set(float(current.from));
 					painter->instanciedDraw(GL_TRIANGLES, _programs[PROGRAM_BUFFERING], verticesKey, current.size);
 					painter->instanciedDrawEnd();
 				}
@@ -209,12 +317,15 @@ namespace AGE
 				SCOPE_profile_cpu_i("RenderTimer", "Draw skinned objects");
 
 				_programs[PROGRAM_BUFFERING_SKINNED]->use();
-				_programs[PROGRAM_BUFFERING_SKINNED]->get_resource<Mat4>         (StringID("projection_matrix", 0x92b1e336c34a1224)).set(infos.cameraInfos.data.projection);
-				_programs[PROGRAM_BUFFERING_SKINNED]->get_resource<Mat4>         (StringID("view_matrix", 0xd15d560e7965726c)).set(infos.cameraInfos.view);
-				_programs[PROGRAM_BUFFERING_SKINNED]->get_resource<SamplerBuffer>(StringID("model_matrix_tbo", 0x6532aea46fc01c3a)).set(_positionBuffer);
-				_programs[PROGRAM_BUFFERING_SKINNED]->get_resource<SamplerBuffer>(StringID("bones_matrix_tbo", 0x3a7f8c7debc73024)).set(GetRenderThread()->getBonesTexture());
-				auto matrixOffset = _programs[PROGRAM_BUFFERING_SKINNED]->get_resource<Vec1>(StringID("matrixOffset", 0xb870d9a9a2c195f7));
-				auto bonesOffset = _programs[PROGRAM_BUFFERING_SKINNED]->get_resource<Vec1> (StringID("bonesOffset", 0xc8c5f289dcfef0cf));
+				auto &handles = _getHandles(PROGRAM_BUFFERING_SKINNED);
+				handles.projection.set(infos.cameraInfos.data.projection);
+				handles.view.set(infos.cameraInfos.view);
+				handles.modelMatrices.set(_positionBuffer);
+				handles.bonesMatrices.set(GetRenderThread()->getBonesTexture());
+				handles.bonesMatrixSize.set(float(BoneMatrixTexels));
+				const MaterialInstance *material = nullptr;
+				// start of the bones of this frame in the bones texture
+				const std::size_t bonesBase = GetRenderThread()->getBonesOffset();
 
 				_positionBuffer->resetOffset();
 
@@ -237,16 +348,12 @@ namespace AGE
 
 					if (painterKey.isValid())
 					{
-						_programs[PROGRAM_BUFFERING_SKINNED]->get_resource<Vec4>(StringID("diffuse_color", 0x011da378d8e2a2c9)).set(current.material->diffuse);
-						_programs[PROGRAM_BUFFERING_SKINNED]->get_resource<Sampler2D>(StringID("diffuse_map", 0x1930bc220c3b5c20)).set(current.material->diffuseTex);
-						_programs[PROGRAM_BUFFERING_SKINNED]->get_resource<Vec4>(StringID("specular_color", 0x747083b1ac56a160)).set(current.material->specular);
-						_programs[PROGRAM_BUFFERING_SKINNED]->get_resource<Vec1>(StringID("shininess_ratio", 0xf147b658a317675f)).set(current.material->shininess);
-						_programs[PROGRAM_BUFFERING_SKINNED]->get_resource<Sampler2D>(StringID("normal_map", 0xda3297075023f6d7)).set(current.material->normalTex);
+						_setMaterial(handles, current.material, material);
 
 						painter = _painterManager->get_painter(painterKey);
 						painter->instanciedDrawBegin(_programs[PROGRAM_BUFFERING_SKINNED]);
-						matrixOffset.set(float(current.from));
-						bonesOffset.set(float(current.bonesIndex));
+						handles.matrixOffset.set(float(current.from));
+						handles.bonesOffset.set(float(current.bonesIndex + bonesBase));
 						painter->instanciedDraw(GL_TRIANGLES, _programs[PROGRAM_BUFFERING_SKINNED], verticesKey, current.size);
 						painter->instanciedDrawEnd();
 					}
@@ -259,6 +366,11 @@ namespace AGE
 			toDraw->reset();
 			SkinnedMeshOutput::RecycleOutput(toDraw);
 		}
+
+		if (OcclusionConfig::g_Occlusion_is_enabled)
+		{
+			_readBackDepth(infos.cameraInfos.data.projection * infos.cameraInfos.view);
+		}
 	}
 
 	LFQueue<BasicCommandGeneration::MeshAndMaterialOutput*>* DeferredBasicBuffering::getMeshResultQueue()
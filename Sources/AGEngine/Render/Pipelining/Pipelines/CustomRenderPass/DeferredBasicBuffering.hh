@@ -6,6 +6,7 @@
 #include <Utils/Containers/LFQueue.hpp>
 
 #include <Render/Pipelining/Prepare/MeshBufferingPrepare.hpp>
+#include <Render/Program.hh>
 
 namespace AGE
 {
@@ -15,6 +16,10 @@ namespace AGE
 	class Frustum;
 	class TextureBuffer;
 	class Texture2D;
+	class Mat4;
+	class Vec1;
+	class Sampler2D;
+	class SamplerBuffer;
 
 	class DeferredBasicBuffering : public FrameBufferRender
 	{
@@ -36,11 +41,41 @@ namespace AGE
 		typedef BasicCommandGeneration::MeshAndMaterialOutput MeshOutput;
 		typedef BasicCommandGeneration::SkinnedMeshAndMaterialOutput SkinnedMeshOutput;
 	protected:
+		// resources of a buffering program, resolved once per link
+		struct BufferingHandles
+		{
+			std::size_t version = 0;
+			Program::ResourceHandle<Mat4> projection;
+			Program::ResourceHandle<Mat4> view;
+			Program::ResourceHandle<SamplerBuffer> modelMatrices;
+			Program::ResourceHandle<Vec1> matrixOffset;
+			Program::ResourceHandle<Sampler2D> diffuseMap;
+			Program::ResourceHandle<Sampler2D> normalMap;
+			// skinned program only
+			Program::ResourceHandle<SamplerBuffer> bonesMatrices;
+			Program::ResourceHandle<Vec1> bonesMatrixSize;
+			Program::ResourceHandle<Vec1> bonesOffset;
+		};
+
 		virtual void renderPass(const DRBCameraDrawableList &infos);
+		BufferingHandles &_getHandles(std::size_t program);
+		// binds the material block and textures when the material changes
+		void _setMaterial(BufferingHandles &handles, const MaterialInstance *material, const MaterialInstance *&current);
+		// depth is read back for the occlusion culling of the next frames
+		// in pixel buffers, one frame late so the read does not stall
+		void _readBackDepth(const glm::mat4 &viewProj);
+		// the framebuffer size changed, both buffers are reallocated
+		void _resizeDepthPbos(std::size_t width, std::size_t height);
 		std::shared_ptr<Texture2D> _depth;
 		std::shared_ptr<Texture2D> _occlusionDepth;
 
 		std::vector<uint32_t> _depthPixels;
+		GLuint    _depthPbos[2];
+		glm::mat4 _depthPboMatrices[2];
+		bool      _depthPboFilled[2];
+		std::size_t _depthPboIndex = 0;
+		std::size_t _depthPboWidth = 0;
+		std::size_t _depthPboHeight = 0;
 
 		std::shared_ptr<AGE::TextureBuffer> _positionBuffer = nullptr;
 		static const std::size_t _maxMatrixInstancied = 16384;
@@ -49,5 +84,7 @@ namespace AGE
 
 		LFQueue<BasicCommandGeneration::MeshAndMaterialOutput*>          _cullingResults;
 		LFQueue<BasicCommandGeneration::SkinnedMeshAndMaterialOutput*>   _skinnedCullingResults;
+
+		BufferingHandles _handles[2];
 	};
 }
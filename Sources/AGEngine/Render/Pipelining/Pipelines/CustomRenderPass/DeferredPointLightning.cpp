@@ -82,6 +82,32 @@ namespace AGE
 		_spherePainter = _painterManager->get_painter(spherePainterkey);
 	}
 
+	void DeferredPointLightning::_resolveHandles()
+	{
+		auto &stencil = *_programs[PROGRAM_STENCIL];
+		if (stencil.resolveHandles(_stencilHandles.version))
+		{
+			_stencilHandles.projection = stencil.get_resource<Mat4>(StringID("projection_matrix", 0x92b1e336c34a1224));
+			_stencilHandles.view = stencil.get_resource<Mat4>(StringID("view_matrix", 0xd15d560e7965726c));
+			_stencilHandles.model = stencil.get_resource<Mat4>(StringID("model_matrix", 0x2a41db82e109c802));
+		}
+		auto &lightning = *_programs[PROGRAM_LIGHTNING];
+		if (lightning.resolveHandles(_lightningHandles.version))
+		{
+			_lightningHandles.projection = lightning.get_resource<Mat4>(StringID("projection_matrix", 0x92b1e336c34a1224));
+			_lightningHandles.view = lightning.get_resource<Mat4>(StringID("view_matrix", 0xd15d560e7965726c));
+			_lightningHandles.model = lightning.get_resource<Mat4>(StringID("model_matrix", 0x2a41db82e109c802));
+			_lightningHandles.normalBuffer = lightning.get_resource<Sampler2D>(StringID("normal_buffer", 0x313e2189c71f910d));
+			_lightningHandles.depthBuffer = lightning.get_resource<Sampler2D>(StringID("depth_buffer", 0x2a88a65798cfc925));
+			_lightningHandles.specularBuffer = lightning.get_resource<Sampler2D>(StringID("specular_buffer", 0x0824313afd644f03));
+			_lightningHandles.eyePosition = lightning.get_resource<Vec3>(StringID("eye_pos", 0xe58566afddb7bc1f));
+			_lightningHandles.color = lightning.get_resource<Vec3>(StringID("color_light", 0x7da5b3f55d350b6f));
+			_lightningHandles.ambientColor = lightning.get_resource<Vec3>(StringID("ambient_color", 0x0bd5d46725794843));
+			_lightningHandles.attenuation = lightning.get_resource<Vec3>(StringID("attenuation_light", 0x344423c4b06b660c));
+			_lightningHandles.position = lightning.get_resource<Vec3>(StringID("position_light", 0x514f03a54d8ceae9));
+		}
+	}
+
 	void DeferredPointLightning::renderPass(const DRBCameraDrawableList &infos)
 	{
 		SCOPE_profile_gpu_i("DeferredPointLightning");
@@ -92,27 +118,20 @@ namespace AGE
 		{
 			SCOPE_profile_gpu_i("Overhead pipeline");
 			SCOPE_profile_cpu_i("RenderTimer", "Overhead pipeline");
+			_resolveHandles();
 			_programs[PROGRAM_LIGHTNING]->use();
-			_programs[PROGRAM_LIGHTNING]->get_resource<Mat4>     (StringID("projection_matrix", 0x92b1e336c34a1224)).set(infos.cameraInfos.data.projection);
-			_programs[PROGRAM_LIGHTNING]->get_resource<Mat4>     (StringID("view_matrix", 0xd15d560e7965726c)).set(infos.cameraInfos.view);
-			_programs[PROGRAM_LIGHTNING]->get_resource<Sampler2D>(StringID("normal_buffer", 0x313e2189c71f910d)).set(_normalInput);
-			_programs[PROGRAM_LIGHTNING]->get_resource<Sampler2D>(StringID("depth_buffer", 0x2a88a65798cfc925)).set(_depthInput);
-			_programs[PROGRAM_LIGHTNING]->get_resource<Sampler2D>(StringID("specular_buffer", 0x0824313afd644f03)).set(_specularInput);
-			_programs[PROGRAM_LIGHTNING]->get_resource<Vec3>     (StringID("eye_pos", 0xe58566afddb7bc1f)).set(cameraPosition);
+			_lightningHandles.projection.set(infos.cameraInfos.data.projection);
+			_lightningHandles.view.set(infos.cameraInfos.view);
+			_lightningHandles.normalBuffer.set(_normalInput);
+			_lightningHandles.depthBuffer.set(_depthInput);
+			_lightningHandles.specularBuffer.set(_specularInput);
+			_lightningHandles.eyePosition.set(cameraPosition);
 
 			_programs[PROGRAM_STENCIL]->use();
-			_programs[PROGRAM_STENCIL]->get_resource<Mat4>(StringID("projection_matrix", 0x92b1e336c34a1224)).set(infos.cameraInfos.data.projection);
-			_programs[PROGRAM_STENCIL]->get_resource<Mat4>(StringID("view_matrix", 0xd15d560e7965726c)).set(infos.cameraInfos.view);
+			_stencilHandles.projection.set(infos.cameraInfos.data.projection);
+			_stencilHandles.view.set(infos.cameraInfos.view);
 		}
 
-		auto stencilModelMatrix = _programs[PROGRAM_STENCIL]->get_resource<Mat4>    (StringID("model_matrix", 0x2a41db82e109c802));
-		auto lightningModelMatrix = _programs[PROGRAM_LIGHTNING]->get_resource<Mat4>(StringID("model_matrix", 0x2a41db82e109c802));
-
-		auto colorLightProperty = _programs[PROGRAM_LIGHTNING]->get_resource<Vec3>  (StringID("color_light", 0x7da5b3f55d350b6f));
-		auto ambiantColorProperty = _programs[PROGRAM_LIGHTNING]->get_resource<Vec3>(StringID("ambient_color", 0x0bd5d46725794843));
-		auto attenuationProperty = _programs[PROGRAM_LIGHTNING]->get_resource<Vec3> (StringID("attenuation_light", 0x344423c4b06b660c));
-		auto positionProperty = _programs[PROGRAM_LIGHTNING]->get_resource<Vec3>    (StringID("position_light", 0x514f03a54d8ceae9));
-
 		// Disable blending to clear the color buffer
 		OpenGLState::glDisable(GL_BLEND);
 		OpenGLState::glEnable(GL_CULL_FACE);
@@ -130,9 +149,13 @@ namespace AGE
 		OpenGLState::glClearStencil(0);
 		// Iterate throught each light
 
-		auto &pointList = infos.pointLights;
+		if (infos.pointLights == nullptr)
+		{
+			return;
+		}
+		auto &pointList = infos.pointLights->getCommandOutput().getInfos();
 
-		for (auto &pl : pointList)
+		for (std::size_t i = 0, mi = pointList.size(); i < mi; ++i)
 		{
 			SCOPE_profile_gpu_i("Lightpoints");
 			SCOPE_profile_cpu_i("RenderTimer", "Lightpoints");
@@ -148,7 +171,7 @@ namespace AGE
 
 			// Question for Paul :
 			// This cannot be optimized, doing 2 for loop instead of one ?
-			stencilModelMatrix.set(pl.sphereTransform);
+			_stencilHandles.model.set(pointList.sphereTransform[i]);
 			_spherePainter->uniqueDrawBegin(_programs[PROGRAM_STENCIL]);
 			_spherePainter->uniqueDraw(GL_TRIANGLES, _programs[PROGRAM_STENCIL]/*, pl->globalProperties*/, _sphereVertices);
 			_spherePainter->uniqueDrawEnd();
@@ -159,11 +182,11 @@ namespace AGE
 			OpenGLState::glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
 			OpenGLState::glCullFace(GL_FRONT);
 
-			lightningModelMatrix.set(pl.sphereTransform);
-			colorLightProperty.set(pl.colorLight);
-			ambiantColorProperty.set(pl.ambiantColor);
-			attenuationProperty.set(pl.range);
-			positionProperty.set(pl.position);
+			_lightningHandles.model.set(pointList.sphereTransform[i]);
+			_lightningHandles.color.set(pointList.colorLight[i]);
+			_lightningHandles.ambientColor.set(pointList.ambiantColor[i]);
+			_lightningHandles.attenuation.set(pointList.range[i]);
+			_lightningHandles.position.set(pointList.position[i]);
 			_spherePainter->uniqueDrawBegin(_programs[PROGRAM_LIGHTNING]);
 			_spherePainter->uniqueDraw(GL_TRIANGLES, _programs[PROGRAM_LIGHTNING]/*, pl->globalProperties*/, _sphereVertices);
 			_spherePainter->uniqueDrawEnd();
@@ -2,11 +2,15 @@
 
 #include <Render/Pipelining/Render/FrameBufferRender.hh>
 #include <glm\glm.hpp>
+#include <Render/Program.hh>
 
 namespace AGE
 {
 	class Texture2D;
 	class Program;
+	class Mat4;
+	class Vec3;
+	class Sampler2D;
 
 	class DeferredPointLightning : public FrameBufferRender
 	{
@@ -23,6 +27,35 @@ namespace AGE
 		virtual void renderPass(const DRBCameraDrawableList &infos);
 
 	private:
+		// resources of the programs, resolved once per link
+		struct StencilHandles
+		{
+			std::size_t version = 0;
+			Program::ResourceHandle<Mat4> projection;
+			Program::ResourceHandle<Mat4> view;
+			Program::ResourceHandle<Mat4> model;
+		};
+		struct LightningHandles
+		{
+			std::size_t version = 0;
+			Program::ResourceHandle<Mat4> projection;
+			Program::ResourceHandle<Mat4> view;
+			Program::ResourceHandle<Mat4> model;
+			Program::ResourceHandle<Sampler2D> normalBuffer;
+			Program::ResourceHandle<Sampler2D> depthBuffer;
+			Program::ResourceHandle<Sampler2D> specularBuffer;
+			Program::ResourceHandle<Vec3> eyePosition;
+			Program::ResourceHandle<Vec3> color;
+			Program::ResourceHandle<Vec3> ambientColor;
+			Program::ResourceHandle<Vec3> attenuation;
+			Program::ResourceHandle<Vec3> position;
+		};
+
+		void _resolveHandles();
+
+		StencilHandles _stencilHandles;
+		LightningHandles _lightningHandles;
+
 		std::shared_ptr<Texture2D> _normalInput;
 		std::shared_ptr<Texture2D> _depthInput;
 		std::shared_ptr<Texture2D> _specularInput;
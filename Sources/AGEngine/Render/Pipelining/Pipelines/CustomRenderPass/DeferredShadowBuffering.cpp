@@ -10,6 +10,7 @@
 #include <Core/ConfigurationManager.hpp>
 #include <Core/Engine.hh>
 #include <Configuration.hpp>
+#include <Skinning/BoneMatrix.hpp>
 #include <Threads/RenderThread.hpp>
 #include <Threads/ThreadManager.hpp>
 #include <Render/OcclusionTools/DepthMapHandle.hpp>
@@ -88,6 +89,22 @@ namespace AGE
 	}
 
 
+	DeferredShadowBuffering::ShadowHandles &DeferredShadowBuffering::_getHandles(std::size_t program)
+	{
+		auto &handles = _handles[program];
+		auto &prog = *_programs[program];
+		if (prog.resolveHandles(handles.version))
+		{
+			handles.lightMatrix = prog.get_resource<Mat4>(StringID("light_matrix", 0x9c8229a430a9c8a9));
+			handles.modelMatrices = prog.get_resource<SamplerBuffer>(StringID("model_matrix_tbo", 0x6532aea46fc01c3a));
+			handles.matrixOffset = prog.get_resource<Vec1>(StringID("matrixOffset", 0xb870d9a9a2c195f7));
+			handles.bonesMatrices = prog.get_resource<SamplerBuffer>(StringID("bones_matrix_tbo", 0x3a7f8c7debc73024));
+			handles.bonesMatrixSize = prog.get_resource<Vec1>(StringID("bonesMatrixSize", 0x830574b6c5cb2344));
+			handles.bonesOffset = prog.get_resource<Vec1>(StringID("bonesOffset", 0xc8c5f289dcfef0cf));
+		}
+		return handles;
+	}
+
 	void DeferredShadowBuffering::renderPass(const DRBCameraDrawableList &/*infos*/)
 	{
 		//@PROUT
@@ -105,6 +122,8 @@ namespace AGE
 		OpenGLState::glDepthFunc(GL_LESS);
 
 		_programs[PROGRAM_BUFFERING]->use();
+		auto &handles = _getHandles(PROGRAM_BUFFERING);
+		auto &skinnedHandles = _getHandles(PROGRAM_BUFFERING_SKINNED);
 
 		auto passInfos = _pipeline->getSpotlightRenderInfos();
 
@@ -125,9 +144,8 @@ namespace AGE
 			_frame_buffer.attachment(*depth.get(), GL_DEPTH_STENCIL_ATTACHMENT);
 			glClear(GL_DEPTH_BUFFER_BIT);
 
-			_programs[PROGRAM_BUFFERING]->get_resource<Mat4>(StringID("light_matrix", 0x9c8229a430a9c8a9)).set(spotLightPtr->getCommandOutput()._spotLightMatrix);
-			_programs[PROGRAM_BUFFERING]->get_resource<SamplerBuffer>(StringID("model_matrix_tbo", 0x6532aea46fc01c3a)).set(_positionBuffer);
-			auto matrixOffset = _programs[PROGRAM_BUFFERING]->get_resource<Vec1>(StringID("matrixOffset", 0xb870d9a9a2c195f7));
+			handles.lightMatrix.set(spotLightPtr->getCommandOutput()._spotLightMatrix);
+			handles.modelMatrices.set(_positionBuffer);
 
 			_positionBuffer->resetOffset();
 
@@ -153,7 +171,7 @@ namespace AGE
 				{
 					painter = _painterManager->get_painter(painterKey);
 					painter->instanciedDrawBegin(_programs[PROGRAM_BUFFERING]);
-					matrixOffset.set(float(current.from));
+					handles.matrixOffset.set(float(current.from));
 					painter->instanciedDraw(GL_TRIANGLES, _programs[PROGRAM_BUFFERING], verticesKey, current.size);
 					painter->instanciedDrawEnd();
 				}
@@ -178,11 +196,12 @@ namespace AGE
 			auto depth = ShadowMapCollection::getDepthBuffer(i++, w, h);
 
 			_frame_buffer.attachment(*depth.get(), GL_DEPTH_STENCIL_ATTACHMENT);
-			_programs[PROGRAM_BUFFERING_SKINNED]->get_resource<Mat4>(StringID("light_matrix", 0x9c8229a430a9c8a9)).set(spotLightPtr->getCommandOutput()._spotLightMatrix);
-			_programs[PROGRAM_BUFFERING_SKINNED]->get_resource<SamplerBuffer>(StringID("model_matrix_tbo", 0x6532aea46fc01c3a)).set(_positionBuffer);
-			_programs[PROGRAM_BUFFERING_SKINNED]->get_resource<SamplerBuffer>(StringID("bones_matrix_tbo", 0x3a7f8c7debc73024)).set(GetRenderThread()->getBonesTexture());
-			auto matrixOffset = _programs[PROGRAM_BUFFERING_SKINNED]->get_resource<Vec1>(StringID("matrixOffset", 0xb870d9a9a2c195f7));
-			auto bonesOffset = _programs[PROGRAM_BUFFERING_SKINNED]->get_resource<Vec1>(StringID("bonesOffset", 0xc8c5f289dcfef0cf));
+			skinnedHandles.lightMatrix.set(spotLightPtr->getCommandOutput()._spotLightMatrix);
+			skinnedHandles.modelMatrices.set(_positionBuffer);
+			skinnedHandles.bonesMatrices.set(GetRenderThread()->getBonesTexture());
+			skinnedHandles.bonesMatrixSize.set(float(BoneMatrixTexels));
+			// start of the bones of this frame in the bones texture
+			const std::size_t bonesBase = GetRenderThread()->getBonesOffset();
 
 			_positionBuffer->resetOffset();
 
@@ -208,8 +227,8 @@ namespace AGE
 				{
 					painter = _painterManager->get_painter(painterKey);
 					painter->instanciedDrawBegin(_programs[PROGRAM_BUFFERING_SKINNED]);
-					matrixOffset.set(float(current.from));
-					bonesOffset.set(float(current.bonesIndex));
+					skinnedHandles.matrixOffset.set(float(current.from));
+					skinnedHandles.bonesOffset.set(float(current.bonesIndex + bonesBase));
 					painter->instanciedDraw(GL_TRIANGLES, _programs[PROGRAM_BUFFERING_SKINNED], verticesKey, current.size);
 					painter->instanciedDrawEnd();
 				}
@@ -7,12 +7,16 @@
 #include <concurrentqueue/concurrentqueue.h>
 #include <Utils/Containers/LFQueue.hpp>
 #include <Render\Pipelining\Prepare\MeshBufferingPrepare.hpp>
+#include <Render/Program.hh>
 
 namespace AGE
 {
 	class Texture2D;
 	class TextureBuffer;
 	class IRenderingPipeline;
+	class Mat4;
+	class Vec1;
+	class SamplerBuffer;
 
 	class DeferredShadowBuffering : public FrameBufferRender
 	{
@@ -24,6 +28,22 @@ namespace AGE
 		virtual void renderPass(const DRBCameraDrawableList &infos);
 
 	private:
+		// resources of a shadow program, resolved once per link
+		struct ShadowHandles
+		{
+			std::size_t version = 0;
+			Program::ResourceHandle<Mat4> lightMatrix;
+			Program::ResourceHandle<SamplerBuffer> modelMatrices;
+			Program::ResourceHandle<Vec1> matrixOffset;
+			// skinned program only
+			Program::ResourceHandle<SamplerBuffer> bonesMatrices;
+			Program::ResourceHandle<Vec1> bonesMatrixSize;
+			Program::ResourceHandle<Vec1> bonesOffset;
+		};
+
+		ShadowHandles &_getHandles(std::size_t program);
+
+		ShadowHandles _handles[2];
 		std::shared_ptr<AGE::TextureBuffer> _positionBuffer = nullptr;
 		static const std::size_t _maxMatrixInstancied = 4096;
 		static const std::size_t _sizeofMatrix = sizeof(glm::mat4);
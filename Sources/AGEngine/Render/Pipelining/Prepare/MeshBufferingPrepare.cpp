@@ -5,17 +5,46 @@
 #include <Graphic/DRBMeshData.hpp>
 #include <Graphic/DRBMesh.hpp>
 #include <Graphic/DRBSkinnedMesh.hpp>
+#include <AssetManagement/Instance/MaterialInstance.hh>
+#include <Render/Textures/Texture2D.hh>
+#include <Render/Textures/TextureStreamer.hh>
+
+#include <limits>
 
 namespace AGE
 {	
 	namespace BasicCommandGeneration
 	{
-		bool MeshRawType::Treat(const BFCItem &item, BFCArray<MeshRawType> &result)
+		namespace
 		{
-			DRBMeshData * mesh = ((DRBMesh*)(item.getDrawable()))->getDatas().get();
+			// the textures sampled by the buffering passes keep the mipmaps this size requires
+			void ReportMaterialScreenSize(const MaterialInstance *material, float screenSize, const BFCOutputView &view)
+			{
+				if (material == nullptr || view.viewportHeight <= 0.0f || TextureResidencyConfig::g_residency_is_enabled == false)
+				{
+					return;
+				}
+				const float pixels = screenSize == std::numeric_limits<float>::max() ? screenSize : screenSize * view.viewportHeight;
+				if (material->diffuseTex)
+				{
+					material->diffuseTex->reportScreenSize(pixels);
+				}
+				if (material->normalTex)
+				{
+					material->normalTex->reportScreenSize(pixels);
+				}
+			}
+		}
+
+		bool MeshRawType::Treat(const BFCItem &item, BFCArray<MeshRawType> &result, const BFCOutputView &view)
+		{
+			DRBMesh *drawable = (DRBMesh*)(item.getDrawable());
+			DRBMeshData * mesh = drawable->getDatas().get();
+			const float screenSize = mesh->getScreenSize(view, item.getPosition());
+			ReportMaterialScreenSize(drawable->material, screenSize, view);
 			MeshRawType h;
-			h.vertice = ConcatenateKey(mesh->getPainterKey(), mesh->getVerticesKey());
-			h.material = ((DRBMesh*)(item.getDrawable()))->material;
+			h.vertice = ConcatenateKey(mesh->getPainterKey(), mesh->getLodVerticesKey(mesh->selectLodForSize(view, screenSize)));
+			h.material = drawable->material;
 			h.matrix = mesh->getTransformation();
 			return result.push(h);
 		}
@@ -29,6 +58,14 @@ namespace AGE
 			return a.material < b.material;
 		}
 
+		// material | painter | vertices, like Compare
+		std::uint64_t MeshRawType::SortKey(const MeshRawType &a)
+		{
+			return BFCSortKeyField(BFCSortKeyPointer(a.material), 24, 40)
+				| BFCSortKeyField(a.vertice >> 32, 16, 24)
+				| BFCSortKeyField(a.vertice, 24, 0);
+		}
+
 		MeshRawType MeshRawType::Invalid()
 		{
 			MeshRawType invalid;
@@ -44,11 +81,11 @@ namespace AGE
 
 		//////////////////////////////////////////////////////////////////////////////////
 
-		bool ShadowRawType::Treat(const BFCItem &item, BFCArray<ShadowRawType> &result)
+		bool ShadowRawType::Treat(const BFCItem &item, BFCArray<ShadowRawType> &result, const BFCOutputView &view)
 		{
 			DRBMeshData * mesh = ((DRBMesh*)(item.getDrawable()))->getDatas().get();
 			ShadowRawType h;
-			h.vertice = ConcatenateKey(mesh->getPainterKey(), mesh->getVerticesKey());
+			h.vertice = ConcatenateKey(mesh->getPainterKey(), mesh->getLodVerticesKey(mesh->selectLod(view, item.getPosition())));
 			h.matrix = mesh->getTransformation();
 			return result.push(h);
 		}
@@ -58,6 +95,11 @@ namespace AGE
 			return a.vertice < b.vertice;
 		}
 
+		std::uint64_t ShadowRawType::SortKey(const ShadowRawType &a)
+		{
+			return a.vertice;
+		}
+
 		ShadowRawType ShadowRawType::Invalid()
 		{
 			ShadowRawType invalid;
@@ -72,14 +114,19 @@ namespace AGE
 
 		//////////////////////////////////////////////////////////////////////////////////////
 
-		bool SkinnedMeshRawType::Treat(const BFCItem &item, BFCArray<SkinnedMeshRawType> &result)
+		bool SkinnedMeshRawType::Treat(const BFCItem &item, BFCArray<SkinnedMeshRawType> &result, const BFCOutputView &view)
 		{
-			DRBMeshData * mesh = ((DRBSkinnedMesh*)(item.getDrawable()))->getDatas().get();
+			DRBSkinnedMesh *skinned = (DRBSkinnedMesh*)(item.getDrawable());
+			DRBMeshData * mesh = skinned->getDatas().get();
+			const float screenSize = mesh->getScreenSize(view, item.getPosition());
+			// the animation lod of the next frame depends on it
+			skinned->reportScreenSize(screenSize);
+			ReportMaterialScreenSize(skinned->material, screenSize, view);
 			SkinnedMeshRawType h;
-			h.vertice = ConcatenateKey(mesh->getPainterKey(), mesh->getVerticesKey());
-			h.material = ((DRBMesh*)(item.getDrawable()))->material;
+			h.vertice = ConcatenateKey(mesh->getPainterKey(), mesh->getLodVerticesKey(mesh->selectLodForSize(view, screenSize)));
+			h.material = skinned->material;
 			h.matrix = mesh->getTransformation();
-			h.bonesIndex = ((DRBSkinnedMesh*)(item.getDrawable()))->getSkinningIndex();
+			h.bonesIndex = skinned->getSkinningIndex();
 			return result.push(h);
 		}
 
@@ -96,6 +143,15 @@ namespace AGE
 			return a.material < b.material;
 		}
 
+		// material | bones | painter | vertices, like Compare
+		std::uint64_t SkinnedMeshRawType::SortKey(const SkinnedMeshRawType &a)
+		{
+			return BFCSortKeyField(BFCSortKeyPointer(a.material), 20, 44)
+				| BFCSortKeyField(a.bonesIndex, 20, 24)
+				| BFCSortKeyField(a.vertice >> 32, 8, 16)
+				| BFCSortKeyField(a.vertice, 16, 0);
+		}
+
 		SkinnedMeshRawType SkinnedMeshRawType::Invalid()
 		{
 			SkinnedMeshRawType invalid;
@@ -112,13 +168,17 @@ namespace AGE
 
 		//////////////////////////////////////////////////////////////////////////////////////
 
-		bool SkinnedShadowRawType::Treat(const BFCItem &item, BFCArray<SkinnedShadowRawType> &result)
+		bool SkinnedShadowRawType::Treat(const BFCItem &item, BFCArray<SkinnedShadowRawType> &result, const BFCOutputView &view)
 		{
-			DRBMeshData * mesh = ((DRBSkinnedMesh*)(item.getDrawable()))->getDatas().get();
+			DRBSkinnedMesh *skinned = (DRBSkinnedMesh*)(item.getDrawable());
+			DRBMeshData * mesh = skinned->getDatas().get();
+			const float screenSize = mesh->getScreenSize(view, item.getPosition());
+			// visible shadows keep the animation running
+			skinned->reportScreenSize(screenSize);
 			SkinnedShadowRawType h;
-			h.vertice = ConcatenateKey(mesh->getPainterKey(), mesh->getVerticesKey());
+			h.vertice = ConcatenateKey(mesh->getPainterKey(), mesh->getLodVerticesKey(mesh->selectLodForSize(view, screenSize)));
 			h.matrix = mesh->getTransformation();
-			h.bonesIndex = ((DRBSkinnedMesh*)(item.getDrawable()))->getSkinningIndex();
+			h.bonesIndex = skinned->getSkinningIndex();
 			return result.push(h);
 		}
 
@@ -131,6 +191,14 @@ namespace AGE
 			return a.vertice < b.vertice;
 		}
 
+		// painter | vertices | bones, like Compare
+		std::uint64_t SkinnedShadowRawType::SortKey(const SkinnedShadowRawType &a)
+		{
+			return BFCSortKeyField(a.vertice >> 32, 12, 52)
+				| BFCSortKeyField(a.vertice, 20, 32)
+				| BFCSortKeyField(a.bonesIndex, 32, 0);
+		}
+
 		SkinnedShadowRawType SkinnedShadowRawType::Invalid()
 		{
 			SkinnedShadowRawType invalid;
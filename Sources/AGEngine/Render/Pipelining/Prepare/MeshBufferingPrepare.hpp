@@ -20,8 +20,9 @@ namespace AGE
 	{
 		struct MeshRawType
 		{
-			static bool Treat(const BFCItem &item, BFCArray<MeshRawType> &result);
+			static bool Treat(const BFCItem &item, BFCArray<MeshRawType> &result, const BFCOutputView &view);
 			static bool Compare(const MeshRawType &a, const MeshRawType &b);
+			static std::uint64_t SortKey(const MeshRawType &a);
 			static MeshRawType Invalid();
 			bool operator!=(const MeshRawType &o) const;
 
@@ -31,8 +32,9 @@ namespace AGE
 		};
 		struct ShadowRawType
 		{
-			static bool Treat(const BFCItem &item, BFCArray<ShadowRawType> &result);
+			static bool Treat(const BFCItem &item, BFCArray<ShadowRawType> &result, const BFCOutputView &view);
 			static bool Compare(const ShadowRawType &a, const ShadowRawType &b);
+			static std::uint64_t SortKey(const ShadowRawType &a);
 			static ShadowRawType Invalid();
 			bool operator!=(const ShadowRawType &o) const;
 
@@ -41,8 +43,9 @@ namespace AGE
 		};
 		struct SkinnedMeshRawType
 		{
-			static bool Treat(const BFCItem &item, BFCArray<SkinnedMeshRawType> &result);
+			static bool Treat(const BFCItem &item, BFCArray<SkinnedMeshRawType> &result, const BFCOutputView &view);
 			static bool Compare(const SkinnedMeshRawType &a, const SkinnedMeshRawType &b);
+			static std::uint64_t SortKey(const SkinnedMeshRawType &a);
 			static SkinnedMeshRawType Invalid();
 			bool operator!=(const SkinnedMeshRawType &o) const;
 
@@ -53,8 +56,9 @@ namespace AGE
 		};
 		struct SkinnedShadowRawType
 		{
-			static bool Treat(const BFCItem &item, BFCArray<SkinnedShadowRawType> &result);
+			static bool Treat(const BFCItem &item, BFCArray<SkinnedShadowRawType> &result, const BFCOutputView &view);
 			static bool Compare(const SkinnedShadowRawType &a, const SkinnedShadowRawType &b);
+			static std::uint64_t SortKey(const SkinnedShadowRawType &a);
 			static SkinnedShadowRawType Invalid();
 			bool operator!=(const SkinnedShadowRawType &o) const;
 
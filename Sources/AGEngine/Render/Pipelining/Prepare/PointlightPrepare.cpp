@@ -0,0 +1,57 @@
+#include "PointlightPrepare.hpp"
+
+#include <Graphic/DRBPointLight.hpp>
+
+namespace AGE
+{
+	void PointlightInfos::clear()
+	{
+		range.clear();
+		position.clear();
+		sphereTransform.clear();
+		colorLight.clear();
+		ambiantColor.clear();
+	}
+
+	void PointlightInfos::push(const DRBPointLight &light)
+	{
+		range.push_back(light.getRange());
+		position.push_back(light.getPosition());
+		sphereTransform.push_back(light.getSphereTransform());
+		colorLight.push_back(light.getColorLight());
+		ambiantColor.push_back(light.getAmbiantColor());
+	}
+
+	namespace BasicCommandGeneration
+	{
+		bool PointlightRawType::Treat(const BFCItem &item, BFCArray<PointlightRawType> &result, const BFCOutputView &)
+		{
+			PointlightRawType h;
+			h.light = (const DRBPointLight*)(item.getDrawable());
+			return result.push(h);
+		}
+
+		// lights are culled by several tasks, sorting keep the same order each frame
+		bool PointlightRawType::Compare(const PointlightRawType &a, const PointlightRawType &b)
+		{
+			return a.light < b.light;
+		}
+
+		std::uint64_t PointlightRawType::SortKey(const PointlightRawType &a)
+		{
+			return BFCSortKeyPointer(a.light);
+		}
+
+		PointlightRawType PointlightRawType::Invalid()
+		{
+			PointlightRawType invalid;
+			invalid.light = nullptr;
+			return invalid;
+		}
+
+		bool PointlightRawType::operator!=(const PointlightRawType &o) const
+		{
+			return light != o.light;
+		}
+	}
+}
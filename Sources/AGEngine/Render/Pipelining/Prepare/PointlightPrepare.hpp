@@ -0,0 +1,75 @@
+#pragma once
+
+#include "BFC/BFCOutput.hpp"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace AGE
+{
+	struct DRBPointLight;
+
+	// Visible point lights of a camera, SoA
+	struct PointlightInfos
+	{
+		std::vector<glm::vec3> range;
+		std::vector<glm::vec3> position;
+		std::vector<glm::mat4> sphereTransform;
+		std::vector<glm::vec3> colorLight;
+		std::vector<glm::vec3> ambiantColor;
+
+		inline std::size_t size() const { return position.size(); }
+		inline bool empty() const { return position.empty(); }
+		void clear();
+		void push(const DRBPointLight &light);
+	};
+
+	namespace BasicCommandGeneration
+	{
+		struct PointlightRawType
+		{
+			static bool Treat(const BFCItem &item, BFCArray<PointlightRawType> &result, const BFCOutputView &view);
+			static bool Compare(const PointlightRawType &a, const PointlightRawType &b);
+			static std::uint64_t SortKey(const PointlightRawType &a);
+			static PointlightRawType Invalid();
+			bool operator!=(const PointlightRawType &o) const;
+
+			const DRBPointLight *light;
+		};
+
+		// There is no key, each light is pushed in the SoA infos
+		struct PointlightCommandOutput
+		{
+			void reset()
+			{
+				begin();
+			}
+
+			void begin()
+			{
+				_infos.clear();
+			}
+
+			void end()
+			{
+			}
+
+			void setKeyInfos(const PointlightRawType &)
+			{
+			}
+
+			void setCommandData(const PointlightRawType &infos)
+			{
+				_infos.push(*infos.light);
+			}
+
+			inline const PointlightInfos &getInfos() const { return _infos; }
+		private:
+			PointlightInfos _infos;
+		};
+
+		// as many as the meshes, scenes can have thousands of visible lights
+		typedef BFCOutput<PointlightRawType, 16384, PointlightCommandOutput> PointlightOutput;
+	}
+}
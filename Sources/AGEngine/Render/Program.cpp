@@ -13,11 +13,9 @@ namespace AGE
 		_resources_factory(*this),
 		_name(name),
 		_compiled(false),
-		_id(0)
+		_id(0),
+		_version(0)
 	{
-#ifdef AGE_DEBUG
-		_version = 0;
-#endif
 	}
 
 	Program::~Program()
@@ -41,7 +39,9 @@ namespace AGE
 		_unitsProg(std::move(move._unitsProg)),
 		_resources_factory(*this),
 		_id(move._id),
-		_name(std::move(move._name))
+		_name(std::move(move._name)),
+		_compiled(move._compiled),
+		_version(move._version)
 	{
 		move._id = 0;
 	}
@@ -223,9 +223,7 @@ namespace AGE
 
 		_get_resources();
 		_compiled = true;
-#ifdef AGE_DEBUG
 		++_version;
-#endif
 		return true;
 	}
 
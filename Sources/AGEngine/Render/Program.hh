@@ -29,6 +29,9 @@ namespace AGE
 		class ResourceHandle
 		{
 		public:
+			ResourceHandle()
+			{}
+
 			ResourceHandle(std::shared_ptr<T> ptr)
 				: _ptr(ptr)
 			{}
@@ -73,6 +76,19 @@ namespace AGE
 		bool compile();
 		void destroy();
 		inline bool isCompiled() { return _compiled; }
+		// incremented at each link, the handles resolved before are outdated
+		inline std::size_t getVersion() const { return _version; }
+		// true once per link, to resolve the handles kept by the passes
+		// instead of looking the resources up by name for each draw
+		inline bool resolveHandles(std::size_t &version) const
+		{
+			if (version == _version)
+			{
+				return false;
+			}
+			version = _version;
+			return true;
+		}
 
 	private:
 		void _get_resources();
@@ -85,12 +101,7 @@ namespace AGE
 		GLuint _id;
 		StringID const _name;
 		bool _compiled;
-
-#ifdef AGE_DEBUG
 		std::size_t _version; //used for shader recompilation
-	public:
-		inline std::size_t getVersion() const { return _version; }
-#endif
 	};
 
 	template <typename type_t>
@@ -2,10 +2,14 @@
 #include <glm/glm.hpp>
 #include <Render/Textures/PixelTypesFormats.hh>
 
+#include <algorithm>
+#include <cstring>
+
 namespace AGE
 {
 	Texture2D::Texture2D() :
-		ATexture()
+		ATexture(),
+		_screenSize(0)
 	{
 	}
 
@@ -26,7 +30,8 @@ namespace AGE
 	}
 
 	Texture2D::Texture2D(Texture2D &&move) :
-		ATexture(std::move(move))
+		ATexture(std::move(move)),
+		_screenSize(move._screenSize.load())
 	{
 
 	}
@@ -91,4 +96,50 @@ namespace AGE
 		glGenerateMipmap(GL_TEXTURE_2D);
 	}
 
+	void Texture2D::reportScreenSize(float size)
+	{
+		std::uint32_t bits;
+		std::memcpy(&bits, &size, sizeof(bits));
+		auto current = _screenSize.load(std::memory_order_relaxed);
+		while (current < bits && _screenSize.compare_exchange_weak(current, bits, std::memory_order_relaxed) == false)
+		{
+		}
+	}
+
+	float Texture2D::consumeScreenSize()
+	{
+		const std::uint32_t bits = _screenSize.exchange(0, std::memory_order_relaxed);
+		float size;
+		std::memcpy(&size, &bits, sizeof(size));
+		return size;
+	}
+
+	bool Texture2D::reallocate(GLint width, GLint height, GLint nbr_mip_map, GLint shift)
+	{
+		const GLuint previous = _id;
+		const GLint previousLevels = _nbr_mip_map;
+		_width = width;
+		_height = height;
+		_nbr_mip_map = nbr_mip_map;
+		glGenTextures(1, &_id);
+		glBindTexture(GL_TEXTURE_2D, _id);
+		glTexStorage2D(GL_TEXTURE_2D, _nbr_mip_map, _internal_format, _width, _height);
+		if (previous == GLuint(-1))
+		{
+			return false;
+		}
+		bool copied = false;
+		if (GLEW_ARB_copy_image)
+		{
+			const GLint to = std::min(_nbr_mip_map, previousLevels + shift);
+			for (GLint level = std::max(GLint(0), shift); level < to; ++level)
+			{
+				const glm::uvec2 size = getMipmapSize(level);
+				glCopyImageSubData(previous, GL_TEXTURE_2D, level - shift, 0, 0, 0, _id, GL_TEXTURE_2D, level, 0, 0, 0, GLsizei(size.x), GLsizei(size.y), 1);
+			}
+			copied = true;
+		}
+		glDeleteTextures(1, &previous);
+		return copied;
+	}
 }
\ No newline at end of file
@@ -4,6 +4,8 @@
 # include <utility>
 # include <stdint.h>
 # include <vector>
+# include <atomic>
+# include <cstdint>
 # include <Render/Pipelining/Buffer/AFramebufferStorage.hh>
 
 #include <glm/glm.hpp>
@@ -40,5 +42,21 @@ namespace AGE
 		virtual ITexture const &parameter(GLenum mode, GLint param) const override final;
 		virtual IFramebufferStorage const &attachment(Framebuffer const &framebuffer, GLenum attach) const override final;
 		virtual void generateMipmaps() const override final;
+
+	public:
+		// called concurrently by the culling tasks of the views the texture is seen in,
+		// height in pixels of the meshes it is mapped on
+		void reportScreenSize(float size);
+		// biggest size reported since the last call, 0 if it was not seen
+		float consumeScreenSize();
+		// Replaces the storage by one of nbr_mip_map levels, the level 0 being width x height.
+		// The level i of the old storage is the level i + shift of the new one, the levels both
+		// have are copied on the GPU with ARB_copy_image, returns false when they are lost.
+		// The id changes and the parameters are the default ones, the texture stays bound.
+		bool reallocate(GLint width, GLint height, GLint nbr_mip_map, GLint shift);
+
+	private:
+		// bits of a positive float, they are ordered like the floats
+		std::atomic<std::uint32_t> _screenSize;
 	};
 }
\ No newline at end of file
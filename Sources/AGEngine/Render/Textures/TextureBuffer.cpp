@@ -19,6 +19,11 @@ namespace AGE
 		}
 		if (_bufferHandle != -1)
 		{
+			if (_mapped)
+			{
+				bindBuffer();
+				glUnmapBuffer(GL_TEXTURE_BUFFER);
+			}
 			glDeleteBuffers(1, &_bufferHandle);
 		}
 		if (_buffer)
@@ -44,6 +49,33 @@ namespace AGE
 		return true;
 	}
 
+	bool TextureBuffer::initPersistent(GLsizeiptr count, GLenum internal_format /*GL_R32F */, GLsizeiptr size)
+	{
+		SCOPE_profile_cpu_function("TextureBuffer");
+		AGE_ASSERT(_bufferHandle == -1 && _textureHandle == -1 && _count == 0 && _size == 0 && _buffer == nullptr);
+		if (!GLEW_ARB_buffer_storage)
+		{
+			return false;
+		}
+		_count = count;
+		_size = size;
+
+		const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glGenBuffers(1, &_bufferHandle);
+		bindBuffer();
+		glBufferStorage(GL_TEXTURE_BUFFER, size * count, nullptr, flags);
+		_mapped = glMapBufferRange(GL_TEXTURE_BUFFER, 0, size * count, flags);
+		if (_mapped == nullptr)
+		{
+			return false;
+		}
+		glGenTextures(1, &_textureHandle);
+		bind();
+		glTexBuffer(GL_TEXTURE_BUFFER, internal_format, _bufferHandle);
+		// push and sendBuffer are not available, the memory is written directly
+		return true;
+	}
+
 	void TextureBuffer::resetOffset()
 	{
 		_offset = 0;
@@ -86,6 +118,14 @@ namespace AGE
 		glBufferSubData(GL_TEXTURE_BUFFER, 0, _size * count, data);
 	}
 
+	void TextureBuffer::setRange(GLvoid const *data, GLsizeiptr from, GLsizeiptr count)
+	{
+		SCOPE_profile_cpu_function("TextureBuffer");
+		AGE_ASSERT(from + count <= _count && _mapped == nullptr);
+		bindBuffer();
+		glBufferSubData(GL_TEXTURE_BUFFER, _size * from, _size * count, (const char*)data + _size * from);
+	}
+
 	void TextureBuffer::bindBuffer()
 	{
 		AGE_ASSERT(_bufferHandle != -1);
@@ -11,6 +11,10 @@ namespace AGE
 		TextureBuffer(TextureBuffer &&) = delete;
 		TextureBuffer &operator=(const TextureBuffer &) = delete;
 		bool init(GLsizeiptr count, GLenum internal_format /*GL_R32F */, GLsizeiptr size, GLenum usage /* GL_STATIC_DRAW ...*/);
+		// immutable storage persistently and coherently mapped for writing
+		// false if the driver does not support ARB_buffer_storage
+		bool initPersistent(GLsizeiptr count, GLenum internal_format /*GL_R32F */, GLsizeiptr size);
+		inline void *getMappedMemory() const { return _mapped; }
 		void resetOffset();
 		bool isFull() const;
 		bool isEmpty() const;
@@ -18,6 +22,8 @@ namespace AGE
 		void push(GLvoid const *data);
 		void sendBuffer();
 		void set(GLvoid const *data, GLsizeiptr count);
+		// upload the elements [from, from + count[ of data, data is the start of the whole array
+		void setRange(GLvoid const *data, GLsizeiptr from, GLsizeiptr count);
 		void bindBuffer();
 		void unbindBuffer();
 		void bind();
@@ -29,5 +35,6 @@ namespace AGE
 		GLsizeiptr _size = 0;
 		GLsizeiptr _offset = 0;
 		char* _buffer = nullptr;
+		void *_mapped = nullptr;
 	};
 }
\ No newline at end of file
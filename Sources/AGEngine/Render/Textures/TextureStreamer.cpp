@@ -0,0 +1,515 @@
+#include <Render/Textures/TextureStreamer.hh>
+#include <Utils/OpenGL.hh>
+#include <Render/Textures/Texture2D.hh>
+#include <AssetManagement/OpenGLDDSLoader.hh>
+#include <Threads/Tasks/BasicTasks.hpp>
+#include <Threads/Tasks/ToRenderTasks.hpp>
+#include <TMQ/queue.hpp>
+
+#include <Utils/Profiler.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace AGE
+{
+	bool TextureStreamingConfig::g_streaming_is_enabled = true;
+	std::size_t TextureStreamingConfig::g_upload_budget = 4 * 1024 * 1024;
+	bool TextureResidencyConfig::g_residency_is_enabled = true;
+	std::size_t TextureResidencyConfig::g_residency_budget = 256 * 1024 * 1024;
+	float TextureResidencyConfig::g_residency_bias = 0.0f;
+
+	TextureStreamer::TextureStreamer()
+	{
+		for (std::size_t i = 0; i < BufferNumber; ++i)
+		{
+			_buffers[i] = 0;
+			_bufferSizes[i] = 0;
+		}
+		_stats.textures = 0;
+		_stats.residentBytes = 0;
+		_stats.requiredBytes = 0;
+		_stats.evictedLevels = 0;
+		_stats.evictedBytes = 0;
+		_stats.reloads = 0;
+	}
+
+	TextureStreamer::~TextureStreamer()
+	{
+		for (auto streaming : _streamings)
+		{
+			if (streaming->resident == false)
+			{
+				delete streaming;
+			}
+		}
+		for (auto resident : _residents)
+		{
+			delete resident;
+		}
+	}
+
+	bool TextureStreamer::_compare(const Streaming *a, const Streaming *b)
+	{
+		return a->image->getLevelSize(a->nextLevel - 1) > b->image->getLevelSize(b->nextLevel - 1);
+	}
+
+	bool TextureStreamer::_compareTargets(const Streaming *a, const Streaming *b)
+	{
+		return a->image->getLevelSize(a->targetLevel) < b->image->getLevelSize(b->targetLevel);
+	}
+
+	std::size_t TextureStreamer::_levelForSize(const DDSImage &image, float size)
+	{
+		// one texel per pixel on the height of the mesh, the texture is supposed to be mapped once on it
+		const float texels = float(std::max(image.width, image.height));
+		const float level = std::log2(texels / std::max(size, 1.0f)) + TextureResidencyConfig::g_residency_bias;
+		if (level <= 0.0f)
+		{
+			return 0;
+		}
+		return std::min(std::size_t(level), image.levels - 1);
+	}
+
+	std::size_t TextureStreamer::_levelsSize(const DDSImage &image, std::size_t from)
+	{
+		std::size_t size = 0;
+		for (std::size_t level = from; level < image.levels; ++level)
+		{
+			size += image.getLevelSize(level);
+		}
+		return size;
+	}
+
+	std::size_t TextureStreamer::_pendingSize(const Streaming &streaming) const
+	{
+		std::size_t size = 0;
+		for (std::size_t level = streaming.firstLevel; level < streaming.nextLevel; ++level)
+		{
+			size += streaming.image->getLevelSize(level);
+		}
+		return size;
+	}
+
+	void TextureStreamer::push(const std::shared_ptr<ATexture> &texture, const std::shared_ptr<DDSImage> &image, const std::string &path)
+	{
+		SCOPE_profile_cpu_function("RenderTimer");
+
+		if (path.empty() == false)
+		{
+			for (auto resident : _residents)
+			{
+				if (resident->texture == texture)
+				{
+					_attachImage(*resident, image);
+					return;
+				}
+			}
+		}
+		if (image == nullptr)
+		{
+			return;
+		}
+		if (TextureResidencyConfig::g_residency_is_enabled && path.empty() == false && image->isCubeMap == false && image->hasMipmaps && image->levels > 1)
+		{
+			_pushResident(texture, image, path);
+			return;
+		}
+		OpenGLDDSLoader::initTexture(*texture, *image);
+		// without mipmaps or streaming, everything is uploaded at once, like before
+		const bool stream = TextureStreamingConfig::g_streaming_is_enabled && image->hasMipmaps && image->levels > 1;
+		const std::size_t firstLevel = stream ? image->levels - 1 : 0;
+		for (std::size_t face = 0; face < image->faces; ++face)
+		{
+			for (std::size_t level = firstLevel; level < image->levels; ++level)
+			{
+				auto &mipmap = image->getMipmap(face, level);
+				OpenGLDDSLoader::uploadMipmap(*texture, *image, mipmap, image->data.data() + mipmap.offset);
+			}
+		}
+		if (stream == false)
+		{
+			if (image->hasMipmaps == false)
+				texture->generateMipmaps();
+			texture->unbind();
+			return;
+		}
+		// the smallest level is always there to sample
+		texture->parameter(GL_TEXTURE_BASE_LEVEL, GLint(firstLevel));
+		texture->unbind();
+
+		Streaming *streaming = new Streaming;
+		streaming->texture = texture;
+		streaming->image = image;
+		streaming->nextLevel = firstLevel;
+		for (std::size_t level = 0; level < firstLevel; ++level)
+		{
+			_pendingBytes += image->getLevelSize(level);
+		}
+		_streamings.push_back(streaming);
+		std::push_heap(_streamings.begin(), _streamings.end(), &TextureStreamer::_compare);
+	}
+
+	void TextureStreamer::_pushResident(const std::shared_ptr<ATexture> &texture, const std::shared_ptr<DDSImage> &image, const std::string &path)
+	{
+		// all the levels are streamed like the ones of the other textures,
+		// the residency drops the ones the views do not need
+		OpenGLDDSLoader::initTexture(*texture, *image);
+		const std::size_t smallest = image->levels - 1;
+		const std::size_t firstUploaded = TextureStreamingConfig::g_streaming_is_enabled ? smallest : 0;
+		for (std::size_t level = firstUploaded; level < image->levels; ++level)
+		{
+			auto &mipmap = image->getMipmap(0, level);
+			OpenGLDDSLoader::uploadMipmap(*texture, *image, mipmap, image->data.data() + mipmap.offset);
+		}
+		texture->parameter(GL_TEXTURE_BASE_LEVEL, GLint(firstUploaded));
+		texture->unbind();
+
+		Streaming *resident = new Streaming;
+		resident->texture = texture;
+		resident->image = image;
+		resident->nextLevel = firstUploaded;
+		resident->firstLevel = 0;
+		resident->resident = true;
+		resident->path = path;
+		resident->requiredLevel = 0;
+		resident->lastSeenFrame = _frame;
+		resident->targetLevel = 0;
+		_residents.push_back(resident);
+		if (resident->nextLevel > resident->firstLevel)
+		{
+			_pendingBytes += _pendingSize(*resident);
+			_streamings.push_back(resident);
+			std::push_heap(_streamings.begin(), _streamings.end(), &TextureStreamer::_compare);
+		}
+		else
+		{
+			_releasePixels(*resident);
+		}
+	}
+
+	void TextureStreamer::_reload(Streaming &resident)
+	{
+		if (resident.reloading || resident.path.empty())
+		{
+			return;
+		}
+		resident.reloading = true;
+		++_stats.reloads;
+		const std::shared_ptr<ATexture> texture = resident.texture;
+		const std::string path = resident.path;
+		TMQ::TaskManager::emplaceSharedTask<Tasks::Basic::VoidFunction>([texture, path]()
+		{
+			SCOPE_profile_cpu_i("AssetsLoad", "ReloadTexture");
+			// pushed even if it failed, so the texture stops waiting for it
+			std::shared_ptr<DDSImage> image = OpenGLDDSLoader::parseDDSFile(OldFile(path));
+			TMQ::TaskManager::emplaceRenderTask<Tasks::StreamTexture>(texture, image, path);
+		});
+	}
+
+	void TextureStreamer::_attachImage(Streaming &resident, const std::shared_ptr<DDSImage> &image)
+	{
+		resident.reloading = false;
+		const DDSImage &current = *resident.image;
+		if (image == nullptr || image->levels != current.levels || image->width != current.width
+			|| image->height != current.height || image->sizedFormat != current.sizedFormat)
+		{
+			// the file is gone or changed, the texture keeps the levels it has
+			resident.path.clear();
+			return;
+		}
+		resident.image = image;
+	}
+
+	void TextureStreamer::_releasePixels(Streaming &resident)
+	{
+		std::vector<char>().swap(resident.image->data);
+	}
+
+	void TextureStreamer::_updateResidency()
+	{
+		SCOPE_profile_cpu_function("RenderTimer");
+
+		const bool enabled = TextureResidencyConfig::g_residency_is_enabled;
+		const std::size_t budget = TextureResidencyConfig::g_residency_budget;
+		std::size_t total = 0;
+		std::size_t required = 0;
+		for (auto resident : _residents)
+		{
+			const DDSImage &image = *resident->image;
+			const float size = static_cast<Texture2D &>(*resident->texture).consumeScreenSize();
+			if (size > 0.0f)
+			{
+				resident->requiredLevel = _levelForSize(image, size);
+				resident->lastSeenFrame = _frame;
+			}
+			if (enabled == false)
+			{
+				resident->targetLevel = 0;
+				required += _levelsSize(image, 0);
+			}
+			else if (resident->lastSeenFrame == _frame)
+			{
+				// the levels already there are kept while they fit in the budget
+				resident->targetLevel = std::min(resident->firstLevel, resident->requiredLevel);
+				required += _levelsSize(image, resident->requiredLevel);
+			}
+			else
+			{
+				resident->targetLevel = resident->firstLevel;
+				required += image.getLevelSize(image.levels - 1);
+			}
+			total += _levelsSize(image, resident->targetLevel);
+		}
+
+		if (enabled && total > budget)
+		{
+			// the levels the views do not require, the textures seen the least recently first
+			_evictionOrder = _residents;
+			std::sort(_evictionOrder.begin(), _evictionOrder.end(), [](const Streaming *a, const Streaming *b)
+			{
+				return a->lastSeenFrame < b->lastSeenFrame;
+			});
+			for (auto resident : _evictionOrder)
+			{
+				const DDSImage &image = *resident->image;
+				const std::size_t needed = resident->lastSeenFrame == _frame ? resident->requiredLevel : image.levels - 1;
+				while (total > budget && resident->targetLevel < needed)
+				{
+					total -= image.getLevelSize(resident->targetLevel++);
+				}
+				if (total <= budget)
+				{
+					break;
+				}
+			}
+			// still too much, the biggest levels of the textures on screen
+			_evictionOrder.clear();
+			for (auto resident : _residents)
+			{
+				if (total > budget && resident->targetLevel + 1 < resident->image->levels)
+				{
+					_evictionOrder.push_back(resident);
+				}
+			}
+			std::make_heap(_evictionOrder.begin(), _evictionOrder.end(), &TextureStreamer::_compareTargets);
+			while (total > budget && _evictionOrder.empty() == false)
+			{
+				std::pop_heap(_evictionOrder.begin(), _evictionOrder.end(), &TextureStreamer::_compareTargets);
+				Streaming *resident = _evictionOrder.back();
+				total -= resident->image->getLevelSize(resident->targetLevel++);
+				if (resident->targetLevel + 1 < resident->image->levels)
+				{
+					std::push_heap(_evictionOrder.begin(), _evictionOrder.end(), &TextureStreamer::_compareTargets);
+				}
+				else
+				{
+					_evictionOrder.pop_back();
+				}
+			}
+		}
+
+		bool changed = false;
+		for (auto resident : _residents)
+		{
+			const DDSImage &image = *resident->image;
+			// the levels added are uploaded from the pixels, and all of them without the GPU copy
+			const bool needsPixels = resident->targetLevel < resident->firstLevel || GLEW_ARB_copy_image == false;
+			if (resident->targetLevel != resident->firstLevel && needsPixels && image.data.empty())
+			{
+				// the storage changes once the file is read again
+				_reload(*resident);
+				total += _levelsSize(image, resident->firstLevel);
+				total -= _levelsSize(image, resident->targetLevel);
+				resident->targetLevel = resident->firstLevel;
+			}
+			if (resident->targetLevel != resident->firstLevel)
+			{
+				_reallocate(*resident, resident->targetLevel);
+				changed = true;
+			}
+			if (resident->nextLevel == resident->firstLevel && resident->image->data.empty() == false)
+			{
+				_releasePixels(*resident);
+			}
+		}
+		if (changed)
+		{
+			// the resident textures are queued again with their new levels
+			_streamings.erase(std::remove_if(_streamings.begin(), _streamings.end(), [](const Streaming *streaming)
+			{
+				return streaming->resident;
+			}), _streamings.end());
+			for (auto resident : _residents)
+			{
+				if (resident->nextLevel > resident->firstLevel)
+				{
+					_streamings.push_back(resident);
+				}
+			}
+			std::make_heap(_streamings.begin(), _streamings.end(), &TextureStreamer::_compare);
+		}
+		_stats.textures = _residents.size();
+		_stats.residentBytes = total;
+		_stats.requiredBytes = required;
+	}
+
+	void TextureStreamer::_reallocate(Streaming &resident, std::size_t level)
+	{
+		Texture2D &texture = static_cast<Texture2D &>(*resident.texture);
+		const DDSImage &image = *resident.image;
+		_pendingBytes -= _pendingSize(resident);
+		if (level > resident.firstLevel)
+		{
+			_stats.evictedLevels += level - resident.firstLevel;
+			_stats.evictedBytes += _levelsSize(image, resident.firstLevel) - _levelsSize(image, level);
+		}
+
+		// the storage can not lose or gain levels, a smaller or a bigger one replaces it
+		auto &top = image.getMipmap(0, level);
+		const bool copied = texture.reallocate(top.width, top.height, GLint(image.levels - level), GLint(resident.firstLevel) - GLint(level));
+		resident.nextLevel = std::max(resident.nextLevel, level);
+		resident.firstLevel = level;
+		if (copied == false)
+		{
+			for (std::size_t uploaded = resident.nextLevel; uploaded < image.levels; ++uploaded)
+			{
+				auto &mipmap = image.getMipmap(0, uploaded);
+				OpenGLDDSLoader::uploadMipmap(texture, image, mipmap, image.data.data() + mipmap.offset, level);
+			}
+		}
+		OpenGLDDSLoader::setParameters(texture, image, level);
+		// the levels added are streamed like the ones of a new texture
+		texture.parameter(GL_TEXTURE_BASE_LEVEL, GLint(resident.nextLevel - level));
+		texture.unbind();
+		_pendingBytes += _pendingSize(resident);
+	}
+
+	void TextureStreamer::update()
+	{
+		++_frame;
+		if (_residents.empty() == false)
+		{
+			_updateResidency();
+		}
+		if (_streamings.empty())
+		{
+			return;
+		}
+		SCOPE_profile_cpu_function("RenderTimer");
+
+		// the smallest levels of all the textures first
+		_batch.clear();
+		std::size_t batchSize = 0;
+		while (_streamings.empty() == false)
+		{
+			Streaming *streaming = _streamings.front();
+			const std::size_t levelSize = streaming->image->getLevelSize(streaming->nextLevel - 1);
+			if (_batch.empty() == false && batchSize + levelSize > TextureStreamingConfig::g_upload_budget)
+			{
+				break;
+			}
+			std::pop_heap(_streamings.begin(), _streamings.end(), &TextureStreamer::_compare);
+			_streamings.pop_back();
+			_batch.push_back(streaming);
+			batchSize += levelSize;
+		}
+
+		// the buffer is orphaned, the driver does not wait for the uploads still reading it
+		const std::size_t index = _currentBuffer;
+		_currentBuffer = (_currentBuffer + 1) % BufferNumber;
+		if (_buffers[index] == 0)
+		{
+			glGenBuffers(1, &_buffers[index]);
+		}
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _buffers[index]);
+		_bufferSizes[index] = std::max(_bufferSizes[index], batchSize);
+		glBufferData(GL_PIXEL_UNPACK_BUFFER, GLsizeiptr(_bufferSizes[index]), nullptr, GL_STREAM_DRAW);
+		char *mapped = static_cast<char *>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, GLsizeiptr(batchSize), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+		if (mapped == nullptr)
+		{
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+			for (auto streaming : _batch)
+			{
+				_streamings.push_back(streaming);
+				std::push_heap(_streamings.begin(), _streamings.end(), &TextureStreamer::_compare);
+			}
+			return;
+		}
+		std::size_t offset = 0;
+		for (auto streaming : _batch)
+		{
+			const DDSImage &image = *streaming->image;
+			for (std::size_t face = 0; face < image.faces; ++face)
+			{
+				auto &mipmap = image.getMipmap(face, streaming->nextLevel - 1);
+				std::memcpy(mapped + offset, image.data.data() + mipmap.offset, mipmap.size);
+				offset += mipmap.size;
+			}
+		}
+		glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+		offset = 0;
+		for (auto streaming : _batch)
+		{
+			const DDSImage &image = *streaming->image;
+			const std::size_t level = --streaming->nextLevel;
+			streaming->texture->bind();
+			for (std::size_t face = 0; face < image.faces; ++face)
+			{
+				auto &mipmap = image.getMipmap(face, level);
+				OpenGLDDSLoader::uploadMipmap(*streaming->texture, image, mipmap, reinterpret_cast<GLvoid const *>(offset), streaming->firstLevel);
+				offset += mipmap.size;
+			}
+			streaming->texture->parameter(GL_TEXTURE_BASE_LEVEL, GLint(level - streaming->firstLevel));
+			streaming->texture->unbind();
+			_pendingBytes -= image.getLevelSize(level);
+			if (streaming->nextLevel == streaming->firstLevel)
+			{
+				// done, the file data is released with it, the resident ones keep the mipmaps for the residency
+				if (streaming->resident == false)
+				{
+					delete streaming;
+				}
+				else
+				{
+					_releasePixels(*streaming);
+				}
+			}
+			else
+			{
+				_streamings.push_back(streaming);
+				std::push_heap(_streamings.begin(), _streamings.end(), &TextureStreamer::_compare);
+			}
+		}
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	}
+
+	void TextureStreamer::release()
+	{
+		for (auto streaming : _streamings)
+		{
+			if (streaming->resident == false)
+			{
+				delete streaming;
+			}
+		}
+		_streamings.clear();
+		for (auto resident : _residents)
+		{
+			delete resident;
+		}
+		_residents.clear();
+		_pendingBytes = 0;
+		for (std::size_t i = 0; i < BufferNumber; ++i)
+		{
+			if (_buffers[i] != 0)
+			{
+				glDeleteBuffers(1, &_buffers[i]);
+			}
+			_buffers[i] = 0;
+			_bufferSizes[i] = 0;
+		}
+	}
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace AGE
+{
+	class ATexture;
+	struct DDSImage;
+
+	class TextureStreamingConfig
+	{
+	public:
+		// The textures are uploaded level by level, the smallest first, under a budget per frame
+		static bool g_streaming_is_enabled;
+		// Bytes uploaded per frame, at least one level is uploaded per frame
+		static std::size_t g_upload_budget;
+	};
+
+	class TextureResidencyConfig
+	{
+	public:
+		// The material textures only keep the mipmaps the meshes they are mapped on need on screen,
+		// disabled, they grow back to all their levels
+		static bool g_residency_is_enabled;
+		// Bytes of the levels allocated for the material textures,
+		// the textures seen the least recently lose their levels first
+		static std::size_t g_residency_budget;
+		// Added to the level the screen size requires, positive to save memory
+		static float g_residency_bias;
+	};
+
+	// Uploads the parsed DDS files through a ring of pixel unpack buffers
+	// The sampled levels of a texture are restricted to the uploaded ones,
+	// so it refines progressively. Render thread only.
+	// The textures pushed with their file are resident: their storage only holds the levels
+	// their screen size requires, reallocated when it changes, under the residency budget.
+	// Their pixels are released once uploaded, the evicted levels are read again from the file by a worker.
+	class TextureStreamer
+	{
+	public:
+		static const std::size_t BufferNumber = 3;
+
+		// written once per frame by the render thread, readable from any thread
+		struct ResidencyStats
+		{
+			std::atomic<std::size_t> textures;
+			// allocated for the resident textures
+			std::atomic<std::size_t> residentBytes;
+			// what the views require, can be above the budget
+			std::atomic<std::size_t> requiredBytes;
+			// since the start
+			std::atomic<std::size_t> evictedLevels;
+			std::atomic<std::size_t> evictedBytes;
+			std::atomic<std::size_t> reloads;
+		};
+
+		TextureStreamer();
+		~TextureStreamer();
+		TextureStreamer(const TextureStreamer &) = delete;
+		TextureStreamer &operator=(const TextureStreamer &) = delete;
+
+		// allocates the texture storage and uploads its smallest level
+		// path is the file of a mipmapped 2D texture whose levels follow its screen size, empty otherwise
+		// pushed again with a resident texture, the image is the one read for its evicted levels
+		void push(const std::shared_ptr<ATexture> &texture, const std::shared_ptr<DDSImage> &image, const std::string &path = std::string());
+		// uploads the pending levels under the budget, once per frame
+		void update();
+		void release();
+
+		inline std::size_t getPendingBytes() const { return _pendingBytes; }
+		inline std::size_t getPendingTextures() const { return _streamings.size(); }
+		inline const ResidencyStats &getResidencyStats() const { return _stats; }
+	private:
+		struct Streaming
+		{
+			std::shared_ptr<ATexture> texture;
+			// the pixels of the resident ones are released once uploaded, the mipmaps stay
+			std::shared_ptr<DDSImage> image;
+			// the levels [0, nextLevel[ are not uploaded yet
+			std::size_t nextLevel;
+			// the level 0 of the storage is this level of the image,
+			// the levels [firstLevel, nextLevel[ are allocated and not uploaded yet
+			std::size_t firstLevel = 0;
+			bool resident = false;
+			// read again when levels without pixels are needed, empty if it can't be
+			std::string path;
+			bool reloading = false;
+			// finest level the views required the last time the texture was seen
+			std::size_t requiredLevel = 0;
+			std::size_t lastSeenFrame = 0;
+			// first level of the storage once the residency is updated
+			std::size_t targetLevel = 0;
+		};
+
+		// size of the next level of the streaming, the heap top is the smallest one
+		static bool _compare(const Streaming *a, const Streaming *b);
+		// size of the level of the resident target, the heap top is the biggest one
+		static bool _compareTargets(const Streaming *a, const Streaming *b);
+		static std::size_t _levelForSize(const DDSImage &image, float size);
+		// bytes of the levels [from, levels[ of the image
+		static std::size_t _levelsSize(const DDSImage &image, std::size_t from);
+		std::size_t _pendingSize(const Streaming &streaming) const;
+
+		void _pushResident(const std::shared_ptr<ATexture> &texture, const std::shared_ptr<DDSImage> &image, const std::string &path);
+		// the file is parsed by a worker and pushed back to the render thread
+		void _reload(Streaming &resident);
+		void _attachImage(Streaming &resident, const std::shared_ptr<DDSImage> &image);
+		static void _releasePixels(Streaming &resident);
+		// picks the levels of the resident textures and reallocates the ones that changed
+		void _updateResidency();
+		void _reallocate(Streaming &resident, std::size_t level);
+
+		std::vector<Streaming*> _streamings;
+		std::vector<Streaming*> _batch;
+		// owned, they are in _streamings too while they have levels to upload
+		std::vector<Streaming*> _residents;
+		std::vector<Streaming*> _evictionOrder;
+		ResidencyStats _stats;
+		std::size_t _frame = 0;
+		// GLuint, the header is included by the render thread one
+		unsigned int _buffers[BufferNumber];
+		std::size_t _bufferSizes[BufferNumber];
+		std::size_t _currentBuffer = 0;
+		std::size_t _pendingBytes = 0;
+	};
+}
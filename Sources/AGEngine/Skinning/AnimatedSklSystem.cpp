@@ -13,6 +13,8 @@
 
 #include <ComponentsCore/MeshRenderer.hh>
 
+#include <Threads/MainThread.hpp>
+
 namespace AGE
 {
 	AnimatedSklSystem::AnimatedSklSystem(AScene *scene)
@@ -40,9 +42,23 @@ namespace AGE
 
 		auto animationManager = _scene->getInstance<AnimationManager>();
 		AGE_ASSERT(animationManager != nullptr);
-		animationManager->update(hackTime);
 
 		auto &collection = _filter.getCollection();
+		if (GetMainThread()->isRenderFrame())
+		{
+			// the animation lod uses the sizes of the meshes in the last culling
+			for (auto &e : collection)
+			{
+				auto animation = e->getComponent<AnimatedSklComponent>()->getAnimation();
+				if (animation)
+				{
+					animation->reportScreenSize(e->getComponent<MeshRenderer>()->consumeSkinnedScreenSize());
+				}
+			}
+		}
+
+		animationManager->update(hackTime);
+
 		for (auto &e : collection)
 		{
 			auto skelCpt = e->getComponent<AnimatedSklComponent>();
@@ -7,74 +7,288 @@
 #include <glm/gtx/matrix_interpolation.hpp>
 #include <Utils/Serialization/SerializationArchives.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
 
 namespace AGE{
 
-	void AnimationChannel::findKeyIndex(float t, glm::uvec3 &keys, glm::uvec3 &nextKeys)
+	float AnimationConfig::g_bake_sample_rate = 0.0f;
+	bool AnimationConfig::g_compression_is_enabled = true;
+	AnimationCompressionSettings AnimationConfig::g_compression_settings;
+	bool AnimationConfig::g_lod_is_enabled = true;
+	float AnimationConfig::g_lod_screen_sizes[3] = { 0.1f, 0.04f, 0.016f };
+	bool AnimationConfig::g_lod_freeze_offscreen = true;
+	std::size_t AnimationConfig::g_instances_per_task = 16;
+
+	namespace
 	{
-		if (scale.size() <= 1)
+		template <typename T>
+		inline float KeyTime(const AGE::Vector<AnimationKey<T>> &track, std::size_t index)
 		{
-			keys.x = 0;
-			nextKeys.x = 0;
+			return track[index].time;
 		}
-		else
+
+		inline float KeyTime(const AGE::Vector<float> &times, std::size_t index)
+		{
+			return times[index];
+		}
+
+		// index of the last key with time <= t, clamped in the track
+		template <typename Track>
+		void FindTrackKey(const Track &track, float t, unsigned int &key, unsigned int &nextKey)
 		{
-			for (unsigned int i = 0; i < scale.size() - 1; i++)
+			const unsigned int size = static_cast<unsigned int>(track.size());
+			if (size <= 1)
+			{
+				key = 0;
+				nextKey = 0;
+				return;
+			}
+
+			const unsigned int last = size - 1;
+			// most of the time we are in the same interval or in the next one
+			if (key < last && KeyTime(track, key) <= t)
+			{
+				if (t < KeyTime(track, key + 1))
+				{
+					nextKey = key + 1;
+					return;
+				}
+				if (key + 1 < last && t < KeyTime(track, key + 2))
+				{
+					++key;
+					nextKey = key + 1;
+					return;
+				}
+			}
+
+			// first key with time > t
+			unsigned int from = 0;
+			unsigned int count = size;
+			while (count > 0)
 			{
-				if (t < scale[i + 1].time) {
-					keys.x = i;
-					nextKeys.x = i + 1;
-					break;
+				unsigned int half = count / 2;
+				if (KeyTime(track, from + half) <= t)
+				{
+					from += half + 1;
+					count -= half + 1;
 				}
+				else
+				{
+					count = half;
+				}
+			}
+
+			if (from == 0)
+			{
+				key = 0;
+				nextKey = 0;
+			}
+			else if (from == size)
+			{
+				key = last;
+				nextKey = last;
+			}
+			else
+			{
+				nextKey = from;
+				key = from - 1;
 			}
 		}
 
-		if (rotation.size() <= 1)
+		template <typename T>
+		inline float KeyFactor(const AGE::Vector<AnimationKey<T>> &track, float t, unsigned int key, unsigned int nextKey)
 		{
-			keys.y = 0;
-			nextKeys.y = 0;
+			if (key == nextKey || track[key].deltaTime <= 0.0f)
+			{
+				return 0.0f;
+			}
+			return glm::clamp((t - track[key].time) / track[key].deltaTime, 0.0f, 1.0f);
 		}
-		else
+
+		inline float KeyFactor(const AGE::Vector<float> &times, float t, unsigned int key, unsigned int nextKey)
 		{
-			for (unsigned int i = 0; i < rotation.size() - 1; i++)
+			if (key == nextKey || times[nextKey] <= times[key])
 			{
-				if (t < rotation[i + 1].time) {
-					keys.y = i;
-					nextKeys.y = i + 1;
-					break;
-				}
+				return 0.0f;
+			}
+			return glm::clamp((t - times[key]) / (times[nextKey] - times[key]), 0.0f, 1.0f);
+		}
+
+		template <typename Archive>
+		struct IsSavingArchive { static const bool value = false; };
+		template <> struct IsSavingArchive<cereal::PortableBinaryOutputArchive> { static const bool value = true; };
+		template <> struct IsSavingArchive<cereal::JSONOutputArchive> { static const bool value = true; };
+		template <> struct IsSavingArchive<cereal::XMLOutputArchive> { static const bool value = true; };
+		template <> struct IsSavingArchive<cereal::BinaryOutputArchive> { static const bool value = true; };
+
+		// keys of the reduced track, within the compression tolerance of the original ones
+		template <typename Track, typename T>
+		void DecompressTrack(const Track &track, AGE::Vector<AnimationKey<T>> &keys)
+		{
+			keys.resize(track.size());
+			for (std::size_t i = 0; i < track.size(); ++i)
+			{
+				keys[i].value = track.value(i);
+				keys[i].time = track.times[i];
+				keys[i].deltaTime = i + 1 < track.size() ? track.times[i + 1] - track.times[i] : 0.0f;
 			}
 		}
+	}
+
+	void AnimationChannel::findKeyIndex(float t, glm::uvec3 &keys, glm::uvec3 &nextKeys) const
+	{
+		FindTrackKey(scale, t, keys.x, nextKeys.x);
+		FindTrackKey(rotation, t, keys.y, nextKeys.y);
+		FindTrackKey(translation, t, keys.z, nextKeys.z);
+	}
+
+	void AnimationChannel::_sample(float t, glm::uvec3 &cursor, glm::vec3 &s, glm::quat &r, glm::vec3 &tr) const
+	{
+		if (compressed)
+		{
+			_sampleCompressed(t, cursor, s, r, tr);
+			return;
+		}
+
+		glm::uvec3 nextKey;
+		findKeyIndex(t, cursor, nextKey);
+
+		tr = glm::mix(translation[cursor.z].value, translation[nextKey.z].value, KeyFactor(translation, t, cursor.z, nextKey.z));
+		s = glm::mix(scale[cursor.x].value, scale[nextKey.x].value, KeyFactor(scale, t, cursor.x, nextKey.x));
+		r = glm::normalize(glm::slerp(rotation[cursor.y].value, rotation[nextKey.y].value, KeyFactor(rotation, t, cursor.y, nextKey.y)));
+	}
 
-		if (translation.size() <= 1)
+	// keys are decompressed on the fly, only the two surrounding keys are read
+	void AnimationChannel::_sampleCompressed(float t, glm::uvec3 &cursor, glm::vec3 &s, glm::quat &r, glm::vec3 &tr) const
+	{
+		glm::uvec3 nextKey;
+		FindTrackKey(compressedScale.times, t, cursor.x, nextKey.x);
+		FindTrackKey(compressedRotation.times, t, cursor.y, nextKey.y);
+		FindTrackKey(compressedTranslation.times, t, cursor.z, nextKey.z);
+
+		tr = glm::mix(compressedTranslation.value(cursor.z), compressedTranslation.value(nextKey.z), KeyFactor(compressedTranslation.times, t, cursor.z, nextKey.z));
+		s = glm::mix(compressedScale.value(cursor.x), compressedScale.value(nextKey.x), KeyFactor(compressedScale.times, t, cursor.x, nextKey.x));
+		r = glm::normalize(glm::slerp(compressedRotation.value(cursor.y), compressedRotation.value(nextKey.y), KeyFactor(compressedRotation.times, t, cursor.y, nextKey.y)));
+	}
+
+	void AnimationChannel::_sampleBaked(float t, glm::vec3 &s, glm::quat &r, glm::vec3 &tr) const
+	{
+		const float position = std::max(t * bakedSampleRate, 0.0f);
+		const std::size_t last = baked.size() - 1;
+		std::size_t index = std::min(static_cast<std::size_t>(position), last);
+		std::size_t next = std::min(index + 1, last);
+		const float factor = glm::clamp(position - static_cast<float>(index), 0.0f, 1.0f);
+
+		const auto &a = baked[index];
+		const auto &b = baked[next];
+		tr = glm::mix(a.translation, b.translation, factor);
+		s = glm::mix(a.scale, b.scale, factor);
+		r = glm::normalize(glm::slerp(a.rotation, b.rotation, factor));
+	}
+
+	void AnimationChannel::getInterpolatedTransform(float t, glm::mat4 &res) const
+	{
+		glm::uvec3 cursor(0);
+		getInterpolatedTransform(t, res, cursor);
+	}
+
+	void AnimationChannel::getInterpolatedTransform(float t, glm::mat4 &res, glm::uvec3 &cursor) const
+	{
+		glm::vec3 s, tr;
+		glm::quat r;
+		if (isBaked())
 		{
-			keys.z = 0;
-			nextKeys.z = 0;
+			_sampleBaked(t, s, r, tr);
 		}
 		else
 		{
-			for (unsigned int i = 0; i < translation.size() - 1; i++)
-			{
-				if (t < translation[i + 1].time) {
-					keys.z = i;
-					nextKeys.z = i + 1;
-					break;
-				}
-			}
+			_sample(t, cursor, s, r, tr);
+		}
+
+		res = glm::translate(glm::mat4(1), tr);
+		res = glm::scale(res, s);
+		res *= glm::mat4_cast(r);
+	}
+
+	void AnimationChannel::bake(float duration, float sampleRate)
+	{
+		baked.clear();
+		bakedSampleRate = 0.0f;
+		if (sampleRate <= 0.0f || duration <= 0.0f || _hasKeys() == false)
+		{
+			return;
+		}
+
+		const std::size_t sampleNumber = static_cast<std::size_t>(std::ceil(duration * sampleRate)) + 1;
+		baked.resize(sampleNumber);
+		glm::uvec3 cursor(0);
+		for (std::size_t i = 0; i < sampleNumber; ++i)
+		{
+			auto &key = baked[i];
+			_sample(static_cast<float>(i) / sampleRate, cursor, key.scale, key.rotation, key.translation);
 		}
+		bakedSampleRate = sampleRate;
 	}
 
-	void AnimationChannel::getInterpolatedTransform(float t, glm::mat4 &res)
+	void AnimationChannel::compress(const AnimationCompressionSettings &settings)
 	{
-		glm::uvec3 key = glm::uvec3(static_cast<unsigned int>(t));
-		glm::uvec3 nextKey = glm::uvec3(key.x + 1);
+		if (compressed || _hasKeys() == false)
+		{
+			return;
+		}
+		compressedScale.compress(scale, settings.scaleTolerance);
+		compressedRotation.compress(rotation, settings.rotationTolerance);
+		compressedTranslation.compress(translation, settings.translationTolerance);
+		compressed = true;
+		_releaseKeys();
+	}
+
+	void AnimationChannel::_releaseKeys()
+	{
+		AGE::Vector<AnimationKey<glm::vec3>>().swap(scale);
+		AGE::Vector<AnimationKey<glm::quat>>().swap(rotation);
+		AGE::Vector<AnimationKey<glm::vec3>>().swap(translation);
+	}
+
+	void AnimationChannel::_beginSerialize(bool saving)
+	{
+		if (compressed && saving)
+		{
+			// the raw keys are released, the reduced ones are saved in the same format
+			DecompressTrack(compressedScale, scale);
+			DecompressTrack(compressedRotation, rotation);
+			DecompressTrack(compressedTranslation, translation);
+		}
+	}
 
-		findKeyIndex(t, key, nextKey);
+	void AnimationChannel::_endSerialize(bool saving)
+	{
+		if (compressed == false)
+		{
+			return;
+		}
+		if (saving)
+		{
+			_releaseKeys();
+			return;
+		}
+		// loaded keys replace the compressed tracks
+		compressedScale = CompressedVec3Track();
+		compressedRotation = CompressedQuatTrack();
+		compressedTranslation = CompressedVec3Track();
+		compressed = false;
+	}
 
-		res = glm::translate(glm::mat4(1), glm::mix(translation[key.z].value, translation[nextKey.z].value, (t - translation[key.z].time) / translation[key.z].deltaTime));
-		res = glm::scale(res, glm::mix(scale[key.x].value, scale[nextKey.x].value, (t - scale[key.x].time) / scale[key.x].deltaTime));
-		res *= glm::mat4_cast(glm::normalize(glm::slerp(rotation[key.y].value, rotation[nextKey.y].value, (t - rotation[key.y].time) / rotation[key.y].deltaTime)));
+	bool AnimationChannel::_hasKeys() const
+	{
+		if (compressed)
+		{
+			return !compressedScale.empty() && !compressedRotation.empty() && !compressedTranslation.empty();
+		}
+		return !scale.empty() && !rotation.empty() && !translation.empty();
 	}
 }
 
-SERIALIZATION_SERIALIZE_METHOD_DEFINITION(AGE::AnimationChannel, *"*/ ar(cereal::make_nvp(MACRO_STR(bone), boneIndex)); ar(cereal::make_nvp(MACRO_STR(scale), scale)); ar(cereal::make_nvp(MACRO_STR(rotation), rotation)); ar(cereal::make_nvp(MACRO_STR(translation), translation)); /*"*);
+SERIALIZATION_SERIALIZE_METHOD_DEFINITION(AGE::AnimationChannel, *"*/ const bool saving = IsSavingArchive<std::decay<decltype(ar)>::type>::value; _beginSerialize(saving); ar(cereal::make_nvp(MACRO_STR(bone), boneIndex)); ar(cereal::make_nvp(MACRO_STR(scale), scale)); ar(cereal::make_nvp(MACRO_STR(rotation), rotation)); ar(cereal::make_nvp(MACRO_STR(translation), translation)); _endSerialize(saving); /*"*);
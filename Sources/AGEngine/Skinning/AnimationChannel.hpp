@@ -4,11 +4,40 @@
 #include <Utils/Serialization/SerializationMacros.hpp>
 #include <glm/fwd.hpp>
 #include "AnimationKey.hpp"
+#include "AnimationCompression.hpp"
 
 SERIALIZATION_ARCHIVE_FORWARD_DECLARATION();
 
 namespace AGE
 {
+	class AnimationConfig
+	{
+	public:
+		// Samples per animation tick of the baked tracks, 0 disable baking
+		// Used when animations are loaded
+		static float g_bake_sample_rate;
+		// Compress the tracks when animations are loaded
+		static bool g_compression_is_enabled;
+		static AnimationCompressionSettings g_compression_settings;
+		// Animation lod, small instances are updated less often
+		// and interpolated between two poses the other frames
+		static bool g_lod_is_enabled;
+		// Screen sizes under which instances are updated every 2, 4 and 8 frames
+		static float g_lod_screen_sizes[3];
+		// Instances not visible in the last culling keep their pose, otherwise they are updated every 8 frames
+		static bool g_lod_freeze_offscreen;
+		// Number of instances updated by each skinning task
+		static std::size_t g_instances_per_task;
+	};
+
+	// Uniformly resampled key, all the components at the same time
+	struct AnimationBakedKey
+	{
+		glm::vec3 scale;
+		glm::quat rotation;
+		glm::vec3 translation;
+	};
+
 	struct AnimationChannel
 	{
 		std::uint32_t boneIndex;
@@ -16,9 +45,41 @@ namespace AGE
 		AGE::Vector<AnimationKey<glm::quat>> rotation;
 		AGE::Vector<AnimationKey<glm::vec3>> translation;
 
-		void findKeyIndex(float t, glm::uvec3 &keys, glm::uvec3 &nextKeys);
-		void getInterpolatedTransform(float t, glm::mat4 &res);
+		// not serialized, filled by bake()
+		AGE::Vector<AnimationBakedKey> baked;
+		float bakedSampleRate = 0.0f;
+
+		// not serialized, filled by compress()
+		// uncompressed tracks are released, a compressed channel saves its reduced keys instead
+		CompressedVec3Track compressedScale;
+		CompressedQuatTrack compressedRotation;
+		CompressedVec3Track compressedTranslation;
+		bool compressed = false;
+
+		// keys is the cursor of the previous call, the search start from it
+		// and fallback on a binary search when time jumped
+		void findKeyIndex(float t, glm::uvec3 &keys, glm::uvec3 &nextKeys) const;
+		void getInterpolatedTransform(float t, glm::mat4 &res) const;
+		// cursor is kept by the caller between frames
+		void getInterpolatedTransform(float t, glm::mat4 &res, glm::uvec3 &cursor) const;
+
+		// resample the keys to have O(1) sampling
+		void bake(float duration, float sampleRate);
+		inline bool isBaked() const { return baked.empty() == false; }
+
+		void compress(const AnimationCompressionSettings &settings);
+		inline bool isCompressed() const { return compressed; }
 
 		SERIALIZATION_SERIALIZE_METHOD_DECLARATION();
+	private:
+		void _sample(float t, glm::uvec3 &cursor, glm::vec3 &s, glm::quat &r, glm::vec3 &tr) const;
+		void _sampleBaked(float t, glm::vec3 &s, glm::quat &r, glm::vec3 &tr) const;
+		void _sampleCompressed(float t, glm::uvec3 &cursor, glm::vec3 &s, glm::quat &r, glm::vec3 &tr) const;
+		bool _hasKeys() const;
+		void _releaseKeys();
+		// around the serialization of the keys, the raw ones of a compressed channel
+		// only exist while it is saved
+		void _beginSerialize(bool saving);
+		void _endSerialize(bool saving);
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,175 @@
+#include "AnimationCompression.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace AGE
+{
+	namespace
+	{
+		const float g_quatComponentRange = 0.70710678f; // 1 / sqrt(2)
+		const float g_quatQuantization = 32767.0f;
+		// avoid O(n^2) key reduction on long static tracks
+		const std::size_t g_maxReducedSegment = 256;
+
+		inline float InterpolationFactor(float from, float to, float t)
+		{
+			return to > from ? (t - from) / (to - from) : 0.0f;
+		}
+
+		inline float Vec3Error(const AnimationKey<glm::vec3> &a, const AnimationKey<glm::vec3> &b, const AnimationKey<glm::vec3> &k)
+		{
+			return glm::length(glm::mix(a.value, b.value, InterpolationFactor(a.time, b.time, k.time)) - k.value);
+		}
+
+		inline float QuatError(const AnimationKey<glm::quat> &a, const AnimationKey<glm::quat> &b, const AnimationKey<glm::quat> &k)
+		{
+			glm::quat interpolated = glm::normalize(glm::slerp(a.value, b.value, InterpolationFactor(a.time, b.time, k.time)));
+			float d = std::min(std::abs(glm::dot(interpolated, k.value)), 1.0f);
+			return 2.0f * std::acos(d);
+		}
+
+		// indices of the keys to keep, first and last are always kept
+		// except for constant tracks reduced to one key
+		template <typename T, typename ErrorFn>
+		void ReduceKeys(const AGE::Vector<AnimationKey<T>> &keys, float tolerance, ErrorFn error, std::vector<std::size_t> &result)
+		{
+			result.clear();
+			if (keys.empty())
+			{
+				return;
+			}
+			result.push_back(0);
+			const std::size_t last = keys.size() - 1;
+			if (last == 0)
+			{
+				return;
+			}
+
+			std::size_t from = 0;
+			for (std::size_t to = 2; to <= last; ++to)
+			{
+				bool fit = to - from <= g_maxReducedSegment;
+				for (std::size_t i = from + 1; fit && i < to; ++i)
+				{
+					fit = error(keys[from], keys[to], keys[i]) <= tolerance;
+				}
+				if (fit == false)
+				{
+					from = to - 1;
+					result.push_back(from);
+				}
+			}
+			result.push_back(last);
+
+			// constant track
+			if (result.size() == 2 && error(keys[0], keys[0], keys[last]) <= tolerance)
+			{
+				result.pop_back();
+			}
+		}
+
+		inline std::uint16_t QuantizeUnit(float value, float max)
+		{
+			return std::uint16_t(glm::clamp(value, 0.0f, 1.0f) * max + 0.5f);
+		}
+	}
+
+	CompressedQuat CompressedQuat::Compress(const glm::quat &quat)
+	{
+		glm::quat q = glm::normalize(quat);
+		float c[4] = { q.x, q.y, q.z, q.w };
+
+		std::uint16_t largest = 0;
+		for (std::uint16_t i = 1; i < 4; ++i)
+		{
+			if (std::abs(c[i]) > std::abs(c[largest]))
+			{
+				largest = i;
+			}
+		}
+		// q and -q are the same rotation, the dropped component is positive
+		const float sign = c[largest] < 0.0f ? -1.0f : 1.0f;
+
+		CompressedQuat result;
+		std::size_t j = 0;
+		for (std::uint16_t i = 0; i < 4; ++i)
+		{
+			if (i == largest)
+			{
+				continue;
+			}
+			float unit = (c[i] * sign / g_quatComponentRange + 1.0f) * 0.5f;
+			result.data[j++] = QuantizeUnit(unit, g_quatQuantization);
+		}
+		result.data[0] |= std::uint16_t((largest & 1) << 15);
+		result.data[1] |= std::uint16_t((largest >> 1) << 15);
+		return result;
+	}
+
+	glm::quat CompressedQuat::decompress() const
+	{
+		const std::uint16_t largest = ((data[0] >> 15) & 1) | (((data[1] >> 15) & 1) << 1);
+		float c[4];
+		float sum = 0.0f;
+		std::size_t j = 0;
+		for (std::uint16_t i = 0; i < 4; ++i)
+		{
+			if (i == largest)
+			{
+				continue;
+			}
+			float unit = float(data[j++] & 0x7FFF) / g_quatQuantization;
+			c[i] = (unit * 2.0f - 1.0f) * g_quatComponentRange;
+			sum += c[i] * c[i];
+		}
+		c[largest] = std::sqrt(std::max(0.0f, 1.0f - sum));
+		return glm::quat(c[3], c[0], c[1], c[2]);
+	}
+
+	void CompressedVec3Track::compress(const AGE::Vector<AnimationKey<glm::vec3>> &keys, float tolerance)
+	{
+		std::vector<std::size_t> kept;
+		ReduceKeys(keys, tolerance, Vec3Error, kept);
+
+		times.resize(kept.size());
+		values.resize(kept.size());
+		if (kept.empty())
+		{
+			return;
+		}
+
+		glm::vec3 max = keys[kept[0]].value;
+		min = max;
+		for (auto k : kept)
+		{
+			min = glm::min(min, keys[k].value);
+			max = glm::max(max, keys[k].value);
+		}
+		extent = max - min;
+
+		for (std::size_t i = 0; i < kept.size(); ++i)
+		{
+			const auto &key = keys[kept[i]];
+			times[i] = key.time;
+			for (int c = 0; c < 3; ++c)
+			{
+				values[i].data[c] = extent[c] > 0.0f ? QuantizeUnit((key.value[c] - min[c]) / extent[c], 65535.0f) : 0;
+			}
+		}
+	}
+
+	void CompressedQuatTrack::compress(const AGE::Vector<AnimationKey<glm::quat>> &keys, float tolerance)
+	{
+		std::vector<std::size_t> kept;
+		ReduceKeys(keys, tolerance, QuatError, kept);
+
+		times.resize(kept.size());
+		values.resize(kept.size());
+		for (std::size_t i = 0; i < kept.size(); ++i)
+		{
+			times[i] = keys[kept[i]].time;
+			values[i] = CompressedQuat::Compress(keys[kept[i]].value);
+		}
+	}
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+
+#include <Utils/Containers/Vector.hpp>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "AnimationKey.hpp"
+
+namespace AGE
+{
+	struct AnimationCompressionSettings
+	{
+		// max distance between the original and the reduced track
+		float translationTolerance = 0.001f;
+		float scaleTolerance = 0.001f;
+		// max angle in radians
+		float rotationTolerance = 0.001f;
+	};
+
+	// Smallest three quaternion on 48 bits
+	// the largest component is dropped and rebuilt from the three others,
+	// stored on 15 bits each, the 2 bits index of the dropped one
+	// is in the high bits of data[0] and data[1]
+	struct CompressedQuat
+	{
+		std::uint16_t data[3];
+
+		static CompressedQuat Compress(const glm::quat &q);
+		glm::quat decompress() const;
+	};
+
+	// vec3 quantized on 16 bits per component in the track range
+	struct CompressedVec3
+	{
+		std::uint16_t data[3];
+	};
+
+	struct CompressedVec3Track
+	{
+		glm::vec3 min = glm::vec3(0);
+		glm::vec3 extent = glm::vec3(0);
+		AGE::Vector<float> times;
+		AGE::Vector<CompressedVec3> values;
+
+		inline std::size_t size() const { return times.size(); }
+		inline bool empty() const { return times.empty(); }
+		inline glm::vec3 value(std::size_t index) const
+		{
+			const auto &v = values[index].data;
+			return min + extent * (glm::vec3(float(v[0]), float(v[1]), float(v[2])) / 65535.0f);
+		}
+		// drop the keys which can be interpolated and quantize the others
+		void compress(const AGE::Vector<AnimationKey<glm::vec3>> &keys, float tolerance);
+	};
+
+	struct CompressedQuatTrack
+	{
+		AGE::Vector<float> times;
+		AGE::Vector<CompressedQuat> values;
+
+		inline std::size_t size() const { return times.size(); }
+		inline bool empty() const { return times.empty(); }
+		inline glm::quat value(std::size_t index) const { return values[index].decompress(); }
+		void compress(const AGE::Vector<AnimationKey<glm::quat>> &keys, float tolerance);
+	};
+}
@@ -1,6 +1,7 @@
 #include "AnimationManager.hpp"
 
 #include <Skinning/Skeleton.hpp>
+#include <Skinning/AnimationChannel.hpp>
 
 #include <Utils/Profiler.hpp>
 #include <Utils/Debug.hpp>
@@ -9,14 +10,112 @@
 #include <Threads/Tasks/BasicTasks.hpp>
 #include <Threads/ThreadManager.hpp>
 #include <Threads/MainThread.hpp>
+#include <Threads/RenderThread.hpp>
 
 #include <TMQ/Queue.hpp>
 
+#include <algorithm>
+
 // pour le hack deguelasse de l'upload bones
 #include <Threads\Tasks\ToRenderTasks.hpp>
 
 namespace AGE
 {
+	namespace
+	{
+		// not updated at all
+		const std::size_t g_animationLodFrozen = std::size_t(-1);
+
+		// 0 is updated every frame, n every 2^n frames
+		std::size_t AnimationLodLevel(float screenSize)
+		{
+			if (AnimationConfig::g_lod_is_enabled == false)
+			{
+				return 0;
+			}
+			if (screenSize <= 0.0f)
+			{
+				return AnimationConfig::g_lod_freeze_offscreen ? g_animationLodFrozen : 3;
+			}
+			std::size_t level = 0;
+			while (level < 3 && screenSize < AnimationConfig::g_lod_screen_sizes[level])
+			{
+				++level;
+			}
+			return level;
+		}
+
+		void LerpBones(const BoneMatrix *from, const BoneMatrix *to, float alpha, BoneMatrix *result, std::size_t number)
+		{
+			const float *a = reinterpret_cast<const float*>(from);
+			const float *b = reinterpret_cast<const float*>(to);
+			float *r = reinterpret_cast<float*>(result);
+			const std::size_t count = number * (sizeof(BoneMatrix) / sizeof(float));
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				r[i] = a[i] + (b[i] - a[i]) * alpha;
+			}
+		}
+
+		void UpdateInstance(AnimationInstance &instance, float time, float frameTime, std::size_t frame, std::size_t stagger)
+		{
+			const Skeleton &skeleton = *instance.skeleton;
+			BoneMatrix *output = instance.getTransformations();
+			const std::size_t boneNumber = instance.getTransformationBufferSize();
+			const std::size_t level = AnimationLodLevel(instance._screenSize);
+			instance._screenSize = 0.0f;
+			instance._dirty = true;
+
+			if (level == 0)
+			{
+				instance._lodPoseNumber = 0;
+				instance.update(time);
+				skeleton.updateSkinning(instance, output);
+				return;
+			}
+
+			auto &poses = instance._lodPoses;
+			auto &frames = instance._lodFrames;
+			// first throttled frame, or the poses are too old : start from the current one
+			// frozen instances keep their pose as long as they are frozen
+			if (instance._lodPoseNumber == 0 || (level != g_animationLodFrozen && frame > frames[1]))
+			{
+				instance.update(time);
+				skeleton.updateSkinning(instance, output);
+				poses[1].assign(output, output + boneNumber);
+				frames[1] = frame;
+				instance._lodPoseNumber = 1;
+			}
+			else if (level == g_animationLodFrozen)
+			{
+				// the buffers are reused, it still has to be written
+				std::copy(poses[1].begin(), poses[1].end(), output);
+				instance._dirty = false;
+				return;
+			}
+			if (level == g_animationLodFrozen)
+			{
+				return;
+			}
+			if (frame == frames[1])
+			{
+				// the newest pose is reached, evaluate the next one in advance
+				// the first one is staggered so instances entering the lod together do not update on the same frames
+				const std::size_t period = std::size_t(1) << level;
+				const std::size_t target = frame + (instance._lodPoseNumber == 1 ? 1 + stagger % period : period);
+				std::swap(poses[0], poses[1]);
+				std::swap(frames[0], frames[1]);
+				poses[1].resize(boneNumber);
+				instance.update(time + frameTime * float(target - frame));
+				skeleton.updateSkinning(instance, poses[1].data());
+				frames[1] = target;
+				instance._lodPoseNumber = 2;
+			}
+			const float alpha = float(frame - frames[0]) / float(frames[1] - frames[0]);
+			LerpBones(poses[0].data(), poses[1].data(), alpha, output, boneNumber);
+		}
+	}
+
 	AnimationManager::AnimationManager()
 	{
 		_currentBonesBufferIndex = 0;
@@ -55,6 +154,7 @@ namespace AGE
 		}
 		res = std::make_shared<AnimationInstance>(skeleton, animation);
 		_bonesBufferSize += res->getTransformationBufferSize();
+		_layoutChanged = true;
 		_animations[skeleton].push_back(res);
 		res->_isShared = shared;
 		res->_instanceCounter++;
@@ -74,6 +174,7 @@ namespace AGE
 		{
 			_bonesBufferSize -= animation->getTransformationBufferSize();
 			_animations[skeleton].remove(animation);
+			_layoutChanged = true;
 		}
 	}
 
@@ -84,57 +185,112 @@ namespace AGE
 			return;
 		std::lock_guard<std::mutex> lock(_mutex); //dirty lock not definitive, to test purpose
 
-		std::atomic_int16_t counter = 0;
-		int taskNumber = 0;
-		auto &transformationBuffer = _bonesBuffers[_currentBonesBufferIndex];
-		std::size_t index = 0;
+		std::size_t instanceNumber = 0;
+		for (auto &s : _animations)
+		{
+			instanceNumber += s.second.size();
+		}
+		if (instanceNumber == 0)
+		{
+			return;
+		}
 
-		if (transformationBuffer.size() < _bonesBufferSize)
+		// the skinning is written directly in the bones stream when a region is free
+		// and copied from the bones buffers otherwise
+		std::size_t region = BonesStream::InvalidRegion;
+		BoneMatrix *bones = GetRenderThread()->getBonesStream().acquire(_bonesBufferSize, region);
+		auto &transformationBuffer = _bonesBuffers[_currentBonesBufferIndex];
+		if (bones == nullptr)
 		{
-			transformationBuffer.resize(_bonesBufferSize);
+			if (transformationBuffer.size() < _bonesBufferSize)
+			{
+				transformationBuffer.resize(_bonesBufferSize);
+			}
+			bones = transformationBuffer.data();
 		}
 
+		std::size_t index = 0;
 		for (auto &s : _animations)
 		{
 			for (auto &a : s.second)
 			{
 				std::size_t indexCpy = index;
 				index += a->_tranformationBufferSize;
-				AGE_ASSERT(index <= transformationBuffer.size());
-				a->_tranformationBuffer = &transformationBuffer[indexCpy];
+				AGE_ASSERT(index <= _bonesBufferSize);
+				a->_tranformationBuffer = bones + indexCpy;
 				a->_transformationIndex = indexCpy;
 			}
 		}
+		const bool layoutChanged = _layoutChanged;
+		_layoutChanged = false;
+
+		// the throttled instances evaluate their poses some frames in advance
+		const float frameTime = time > _lastTime ? time - _lastTime : 0.0f;
+		const std::size_t frame = ++_frame;
+		_lastTime = time;
 
 		{
 			SCOPE_profile_cpu_i("Animations", "Pushing skinning tasks");
+
+			_skinningGraph.reset();
+			_skinningInstances.clear();
 			for (auto &s : _animations)
 			{
 				for (auto &a : s.second)
 				{
-					auto skeleton = s.first;
-					TMQ::TaskManager::emplaceSharedTask<Tasks::Basic::VoidFunction>([a, skeleton, &counter, time](){
-						a->update(time);
-						skeleton->updateSkinning(a);
-						counter.fetch_add(1);
-					});
-					++taskNumber;
+					_skinningInstances.push_back(a.get());
 				}
 			}
-		}
-		{
-			SCOPE_profile_cpu_i("Animations", "Stealing skinning tasks");
-			while (counter.load() < taskNumber)
-			{
-				while (CurrentMainThread()->tryToStealTasks())
+
+			auto bonesBuffer = &_bonesBuffers[_currentBonesBufferIndex];
+			auto dirty = &_dirtyRanges[_currentBonesBufferIndex];
+			auto upload = _skinningGraph.addJob([this, region, bonesBuffer, dirty, layoutChanged](){
+				if (region != BonesStream::InvalidRegion)
+				{
+					GetRenderThread()->getBonesStream().submit(region);
+					TMQ::TaskManager::emplaceRenderTask<AGE::Tasks::UploadBonesToGPU>(region);
+					return;
+				}
+				// neighbour dirty instances are merged in one range
+				dirty->clear();
+				for (auto a : _skinningInstances)
 				{
+					if (a->_dirty == false)
+					{
+						continue;
+					}
+					if (dirty->empty() == false && dirty->back().first + dirty->back().second == a->_transformationIndex)
+					{
+						dirty->back().second += a->_tranformationBufferSize;
+					}
+					else
+					{
+						dirty->push_back(std::make_pair(a->_transformationIndex, a->_tranformationBufferSize));
+					}
 				}
+				TMQ::TaskManager::emplaceRenderTask<AGE::Tasks::UploadBonesToGPU>(bonesBuffer, dirty, layoutChanged);
+			});
+
+			// the instances are locked by _mutex until the jobs are done
+			auto instances = _skinningInstances.data();
+			const std::size_t batchSize = std::max(AnimationConfig::g_instances_per_task, std::size_t(1));
+			for (std::size_t from = 0; from < _skinningInstances.size(); from += batchSize)
+			{
+				const std::size_t to = std::min(from + batchSize, _skinningInstances.size());
+				auto skinning = _skinningGraph.addJob([instances, from, to, time, frameTime, frame](){
+					for (std::size_t i = from; i < to; ++i)
+					{
+						UpdateInstance(*instances[i], time, frameTime, frame, i);
+					}
+				});
+				_skinningGraph.addDependency(skinning, upload);
 			}
+			_skinningGraph.launch();
 		}
-		if (taskNumber > 0)
 		{
-			TMQ::TaskManager::emplaceRenderTask<AGE::Tasks::UploadBonesToGPU>(&_bonesBuffers[_currentBonesBufferIndex]);
-			_currentBonesBufferIndex = (_currentBonesBufferIndex + 1) % 16;
+			SCOPE_profile_cpu_i("Animations", "Waiting skinning tasks");
+			_skinningGraph.wait();
 		}
+		_currentBonesBufferIndex = (_currentBonesBufferIndex + 1) % 16;
 	}
 }
\ No newline at end of file
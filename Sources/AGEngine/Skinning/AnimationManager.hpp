@@ -7,6 +7,7 @@
 
 #include <Utils/Dependency.hpp>
 #include <Utils/Containers/Vector.hpp>
+#include <Threads/TaskScheduler.hpp>
 #include <AssetManagement/Instance/AnimationInstance.hh>
 
 namespace AGE
@@ -27,8 +28,19 @@ namespace AGE
 	private:
 		std::mutex _mutex;
 		std::map<std::shared_ptr<Skeleton>, std::list<std::shared_ptr<AnimationInstance>>> _animations;
-		std::vector<glm::mat4> _bonesBuffers[16];
+		// used when the bones stream of the render thread is not available
+		std::vector<BoneMatrix> _bonesBuffers[16];
+		std::vector<std::pair<std::size_t, std::size_t>> _dirtyRanges[16];
+		// instances added or removed, everything have to be uploaded
+		bool         _layoutChanged = true;
 		std::uint8_t _currentBonesBufferIndex;
 		std::size_t  _bonesBufferSize = 0;
+		// skinning jobs -> bones upload
+		TaskGraph    _skinningGraph;
+		// instances updated this frame, split in batches between the skinning jobs
+		std::vector<AnimationInstance*> _skinningInstances;
+		// render frames updated, the animation lod works in frames
+		std::size_t  _frame = 0;
+		float        _lastTime = 0.0f;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <Configuration.hpp>
+#include <glm/glm.hpp>
+
+namespace AGE
+{
+#ifdef AGE_BONES_3X4
+	// Transposed skinning matrix without its last row, which is always (0, 0, 0, 1)
+	// 3 texels per bone in the bones texture buffer instead of 4
+	struct BoneMatrix
+	{
+		glm::vec4 rows[3];
+	};
+#else
+	typedef glm::mat4 BoneMatrix;
+#endif
+
+	// texels read by the skinned shaders for each bone (bonesMatrixSize uniform)
+	static const std::size_t BoneMatrixTexels = sizeof(BoneMatrix) / sizeof(glm::vec4);
+}
@@ -0,0 +1,68 @@
+#include "BonesStream.hpp"
+
+#include <Utils/Debug.hpp>
+
+namespace AGE
+{
+	BonesStream::BonesStream()
+	{
+		_memory = nullptr;
+		for (auto &e : _states)
+		{
+			e = Free;
+		}
+	}
+
+	void BonesStream::init(BoneMatrix *memory, std::size_t regionCapacity)
+	{
+		AGE_ASSERT(isReady() == false);
+		_regionCapacity = regionCapacity;
+		_memory.store(memory, std::memory_order_release);
+	}
+
+	BoneMatrix *BonesStream::acquire(std::size_t count, std::size_t &region)
+	{
+		region = InvalidRegion;
+		auto memory = _memory.load(std::memory_order_acquire);
+		if (memory == nullptr || count > _regionCapacity)
+		{
+			return nullptr;
+		}
+		// regions are used in order, the next one is the oldest
+		for (std::size_t i = 0; i < RegionNumber; ++i)
+		{
+			const std::size_t r = (_next + i) % RegionNumber;
+			std::uint8_t expected = Free;
+			if (_states[r].compare_exchange_strong(expected, Writing, std::memory_order_acquire))
+			{
+				_next = (r + 1) % RegionNumber;
+				region = r;
+				return memory + getRegionOffset(r);
+			}
+		}
+		return nullptr;
+	}
+
+	void BonesStream::submit(std::size_t region)
+	{
+		AGE_ASSERT(region < RegionNumber && _states[region] == Writing);
+		_states[region].store(Submitted, std::memory_order_release);
+	}
+
+	void BonesStream::setInFlight(std::size_t region)
+	{
+		AGE_ASSERT(region < RegionNumber && _states[region] == Submitted);
+		_states[region].store(InFlight, std::memory_order_relaxed);
+	}
+
+	void BonesStream::release(std::size_t region)
+	{
+		AGE_ASSERT(region < RegionNumber && _states[region] == InFlight);
+		_states[region].store(Free, std::memory_order_release);
+	}
+
+	bool BonesStream::isInFlight(std::size_t region) const
+	{
+		return _states[region].load(std::memory_order_relaxed) == InFlight;
+	}
+}
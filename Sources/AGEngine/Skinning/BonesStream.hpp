@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "BoneMatrix.hpp"
+
+namespace AGE
+{
+	// Ring of bones palettes shared by the skinning (main thread) and the render thread
+	// The skinning writes directly in a free region, the render thread draws with it and
+	// gives it back once the GPU is done with it, so nothing is copied.
+	// It does not know about OpenGL, the memory comes from the render side
+	// (a persistently mapped buffer) or from anything else when there is no GPU.
+	class BonesStream
+	{
+	public:
+		static const std::size_t RegionNumber = 3;
+		static const std::size_t InvalidRegion = std::size_t(-1);
+
+		BonesStream();
+		BonesStream(const BonesStream &) = delete;
+		BonesStream &operator=(const BonesStream &) = delete;
+
+		// memory have to hold RegionNumber * regionCapacity bones and outlive the stream
+		void init(BoneMatrix *memory, std::size_t regionCapacity);
+		inline bool isReady() const { return _memory.load(std::memory_order_acquire) != nullptr; }
+		inline std::size_t getRegionCapacity() const { return _regionCapacity; }
+		// in bones from the start of the memory
+		inline std::size_t getRegionOffset(std::size_t region) const { return region * _regionCapacity; }
+
+		// main thread
+		// nullptr if the stream is not ready, too small or if the GPU still uses all the regions
+		BoneMatrix *acquire(std::size_t count, std::size_t &region);
+		// the skinning is written, the render thread can use it
+		void submit(std::size_t region);
+
+		// render thread
+		// the draws using the region are submitted, it is released when the GPU is done
+		void setInFlight(std::size_t region);
+		void release(std::size_t region);
+		bool isInFlight(std::size_t region) const;
+
+	private:
+		enum RegionState : std::uint8_t
+		{
+			Free = 0,
+			Writing,
+			Submitted,
+			InFlight
+		};
+
+		std::atomic<BoneMatrix*> _memory;
+		std::size_t _regionCapacity = 0;
+		std::atomic<std::uint8_t> _states[RegionNumber];
+		// next region tried by acquire, main thread only
+		std::size_t _next = 0;
+	};
+}
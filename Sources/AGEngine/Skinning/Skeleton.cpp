@@ -1,13 +1,80 @@
 #include "Skeleton.hpp"
+#include "BoneMatrix.hpp"
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
 #include <AssetManagement/Instance/AnimationInstance.hh>
 #include <Utils/Profiler.hpp>
+#include <Utils/Debug.hpp>
+
+// SSE is always available on x64
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1) || defined(__SSE__)
+# include <xmmintrin.h>
+# define AGE_SKINNING_SSE
+#endif
 
 using namespace AGE;
 
+namespace
+{
+#if defined(AGE_SKINNING_SSE)
+	// result can be a or b
+	inline void g_skinningMultiply(const glm::mat4 &a, const glm::mat4 &b, glm::mat4 &result)
+	{
+		const __m128 a0 = _mm_loadu_ps(&a[0][0]);
+		const __m128 a1 = _mm_loadu_ps(&a[1][0]);
+		const __m128 a2 = _mm_loadu_ps(&a[2][0]);
+		const __m128 a3 = _mm_loadu_ps(&a[3][0]);
+		__m128 columns[4];
+		for (int i = 0; i < 4; ++i)
+		{
+			const __m128 c = _mm_loadu_ps(&b[i][0]);
+			columns[i] = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(a0, _mm_shuffle_ps(c, c, _MM_SHUFFLE(0, 0, 0, 0))), _mm_mul_ps(a1, _mm_shuffle_ps(c, c, _MM_SHUFFLE(1, 1, 1, 1))))
+				, _mm_add_ps(_mm_mul_ps(a2, _mm_shuffle_ps(c, c, _MM_SHUFFLE(2, 2, 2, 2))), _mm_mul_ps(a3, _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 3, 3)))));
+		}
+		for (int i = 0; i < 4; ++i)
+		{
+			_mm_storeu_ps(&result[i][0], columns[i]);
+		}
+	}
+
+	inline void g_skinningStore(const glm::mat4 &m, BoneMatrix &result)
+	{
+#ifdef AGE_BONES_3X4
+		__m128 c0 = _mm_loadu_ps(&m[0][0]);
+		__m128 c1 = _mm_loadu_ps(&m[1][0]);
+		__m128 c2 = _mm_loadu_ps(&m[2][0]);
+		__m128 c3 = _mm_loadu_ps(&m[3][0]);
+		_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+		_mm_storeu_ps(&result.rows[0][0], c0);
+		_mm_storeu_ps(&result.rows[1][0], c1);
+		_mm_storeu_ps(&result.rows[2][0], c2);
+#else
+		result = m;
+#endif
+	}
+#else
+	inline void g_skinningMultiply(const glm::mat4 &a, const glm::mat4 &b, glm::mat4 &result)
+	{
+		result = a * b;
+	}
+
+	inline void g_skinningStore(const glm::mat4 &m, BoneMatrix &result)
+	{
+#ifdef AGE_BONES_3X4
+		for (int i = 0; i < 3; ++i)
+		{
+			result.rows[i] = glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]);
+		}
+#else
+		result = m;
+#endif
+	}
+#endif
+}
+
 Skeleton::Skeleton(const char *_path /*= nullptr*/)
 : name("noname")
 , firstBone(0)
@@ -15,34 +82,112 @@ Skeleton::Skeleton(const char *_path /*= nullptr*/)
 , path(path)
 {}
 
-void Skeleton::updateSkinning(std::shared_ptr<AnimationInstance> animInstance)
+void Skeleton::bake()
 {
 	SCOPE_profile_cpu_function("Animations");
 
-	readNodeHierarchy(this->firstBone, animInstance);
+	_order.clear();
+	_parents.clear();
+	_offsets.clear();
+	if (bones.empty())
+	{
+		return;
+	}
+	_order.reserve(bones.size());
+	_parents.reserve(bones.size());
+
+	// position in _order of each bone
+	AGE::Vector<std::int32_t> positions(bones.size(), -1);
+	auto addHierarchy = [&](std::uint32_t root, std::int32_t parent)
+	{
+		std::size_t from = _order.size();
+		positions[root] = std::int32_t(_order.size());
+		_order.push_back(root);
+		_parents.push_back(parent);
+		// breadth first, children are appended after their parent
+		for (std::size_t i = from; i < _order.size(); ++i)
+		{
+			for (auto child : bones[_order[i]].children)
+			{
+				AGE_ASSERT(child < bones.size());
+				// bad children lists are fixed below from the parent indices
+				if (child >= bones.size() || positions[child] != -1)
+				{
+					continue;
+				}
+				positions[child] = std::int32_t(_order.size());
+				_order.push_back(child);
+				_parents.push_back(std::int32_t(i));
+			}
+		}
+	};
+
+	if (firstBone < bones.size())
+	{
+		addHierarchy(firstBone, -1);
+	}
+	// bones out of the main hierarchy are treated as roots
+	for (std::uint32_t i = 0; i < bones.size(); ++i)
+	{
+		if (positions[i] == -1 && (bones[i].parent == std::uint32_t(-1) || bones[i].parent >= bones.size()))
+		{
+			addHierarchy(i, -1);
+		}
+	}
+	// bones missing from the children of their parent are placed
+	// after it, every bone must have its skinning matrix written
+	bool added = true;
+	while (added && _order.size() < bones.size())
+	{
+		added = false;
+		for (std::uint32_t i = 0; i < bones.size(); ++i)
+		{
+			const std::uint32_t parent = bones[i].parent;
+			if (positions[i] == -1 && parent < bones.size() && positions[parent] != -1)
+			{
+				addHierarchy(i, positions[parent]);
+				added = true;
+			}
+		}
+	}
+	// what is left is a parent cycle
+	for (std::uint32_t i = 0; i < bones.size(); ++i)
+	{
+		if (positions[i] == -1)
+		{
+			addHierarchy(i, -1);
+		}
+	}
+	AGE_ASSERT(_order.size() == bones.size());
 
-	auto transformations = animInstance->getTransformations();
-	for (std::size_t i = 0; i < bones.size(); ++i)
+	_offsets.resize(_order.size());
+	for (std::size_t i = 0; i < _order.size(); ++i)
 	{
-		transformations[i] *= bones[i].offset;
+		_offsets[i] = bones[_order[i]].offset;
 	}
 }
 
-void Skeleton::readNodeHierarchy(
-	unsigned int boneID
-	, std::shared_ptr<AnimationInstance> animInstance)
+void Skeleton::updateSkinning(AnimationInstance &animInstance, BoneMatrix *transformations) const
 {
-	auto &animation = *(animInstance.get());
-	auto &bone = bones[boneID];
+	SCOPE_profile_cpu_function("Animations");
+	AGE_ASSERT(isBaked());
 
-	glm::mat4 nodeT = animation.bindPoses[boneID];
-	if (boneID == firstBone)
-		animation.getTransformations()[boneID] = nodeT;
-	else
-		animation.getTransformations()[boneID] = animation.getTransformations()[bone.parent] * nodeT;
+	auto &globals = animInstance.globalPoses;
+	globals.resize(_order.size());
+	const auto &locals = animInstance.bindPoses;
 
-	for (unsigned int i = 0; i < bones[boneID].children.size(); ++i)
+	// local -> global -> skinning in one pass, parents are already computed
+	for (std::size_t i = 0; i < _order.size(); ++i)
 	{
-		readNodeHierarchy(bones[boneID].children[i], animInstance);
+		const std::uint32_t bone = _order[i];
+		const std::int32_t parent = _parents[i];
+		if (parent < 0)
+			globals[i] = locals[bone];
+		else
+			g_skinningMultiply(globals[parent], locals[bone], globals[i]);
+
+		glm::mat4 skinning;
+		g_skinningMultiply(globals[i], _offsets[i], skinning);
+		g_skinningStore(skinning, transformations[bone]);
 	}
 }
@@ -4,6 +4,7 @@
 #include <glm/glm.hpp>
 
 #include "Bone.hpp"
+#include "BoneMatrix.hpp"
 
 
 #include <Utils/Serialization/MatrixSerialization.hpp>
@@ -27,10 +28,20 @@ namespace AGE
 		glm::mat4 inverseGlobal;
 		std::map<std::string, std::uint32_t> bonesReferences;
 		const std::string path;
-		void updateSkinning(std::shared_ptr<AnimationInstance> animInstance);
+
+		// Build the flat layout used by updateSkinning, to call once the bones are loaded
+		void bake();
+		inline bool isBaked() const { return _order.size() == bones.size() && bones.empty() == false; }
+		// evaluate the skinning matrices of the current pose of the instance in transformations
+		void updateSkinning(AnimationInstance &animInstance, BoneMatrix *transformations) const;
 
 	private:
-		void readNodeHierarchy(unsigned int boneID, std::shared_ptr<AnimationInstance> animInstance);
+		// bones in topological order, a parent is always before its children
+		AGE::Vector<std::uint32_t> _order;
+		// position of the parent of each bone in _order, -1 for roots
+		AGE::Vector<std::int32_t> _parents;
+		// offsets in topological order
+		AGE::Vector<glm::mat4> _offsets;
 	};
 
 	template <class Archive>
@@ -28,6 +28,9 @@ namespace AGE
 	bool CharacterControllerSystem::initialize()
 	{
 		_filter.requireComponent<CharacterController>();
+		writeComponent<CharacterController>();
+		writeResource(SystemResource::Links);
+		writeResource(SystemResource::Physics);
 		return (true);
 	}
 
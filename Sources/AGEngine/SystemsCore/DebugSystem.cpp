@@ -9,6 +9,7 @@
 #include <Threads/MainThread.hpp>
 #include <Threads/ThreadManager.hpp>
 #include <Threads/Tasks/BasicTasks.hpp>
+#include <TMQ/queue.hpp>
 
 #include "LiveMemTracer/LiveMemTracer.hpp"
 
@@ -95,6 +96,25 @@ namespace AGE
 			_scene->getInstance<ConfigurationManager>()->setValue<size_t>(std::string("frameCap"), frameCap);
 		}
 
+		if (ImGui::CollapsingHeader("Task frame arenas"))
+		{
+			TMQ::FrameArenaStats stats;
+			for (std::size_t i = 0; i < TMQ::TaskManager::GetFrameArenaNumber(); ++i)
+			{
+				if (TMQ::TaskManager::GetFrameArenaStats(i, stats) == false)
+				{
+					continue;
+				}
+				ImGui::Text("Arena %i : %i / %i kb (max %i kb) - heap fallbacks %i - delayed resets %i"
+					, int(i)
+					, int(stats.lastFrameUsage / 1024)
+					, int(stats.frameCapacity / 1024)
+					, int(stats.highWaterMark / 1024)
+					, int(stats.heapFallbacks)
+					, int(stats.delayedResets));
+			}
+		}
+
 #endif
 	}
 
@@ -32,32 +32,32 @@ namespace AGE
 	void FreeFlyCamera::mainUpdate(float time)
 	{
 		const float verticalAngleLimit = glm::pi<float>();
-		size_t camIndex = 0;
 
-		if (_cameras.getCollection().size() < _cameraAngles.size())
-			_cameraAngles.resize(_cameras.getCollection().size());
+		// the angles are kept by the entities, the collection order changes when one is removed
 		for (auto &cam : _cameras.getCollection())
 		{
 			auto &camLink = cam->getLink();
+			auto freeFly = cam->getComponent<FreeFlyComponent>();
 
-			if (camIndex == _cameraAngles.size())
+			if (freeFly->hasAngles == false)
 			{
 				glm::quat camRotation = camLink.getOrientation();
-				_cameraAngles.emplace_back(glm::vec2(glm::eulerAngles(camRotation)));
+				freeFly->angles = glm::vec2(glm::eulerAngles(camRotation));
+				freeFly->hasAngles = true;
 			}
+			glm::vec2 &angles = freeFly->angles;
 
 			bool moved = false;
-			moved |= _handleKeyboard(time, camLink, camIndex);
-			moved |= _handleMouse(time, camLink, camIndex);
-			moved |= _handleController(time, camLink, camIndex);
+			moved |= _handleKeyboard(time, camLink, angles);
+			moved |= _handleMouse(time, camLink, angles);
+			moved |= _handleController(time, camLink, angles);
 
 			if (moved)
 			{
-				_cameraAngles[camIndex].x = glm::clamp(_cameraAngles[camIndex].x, -verticalAngleLimit, verticalAngleLimit);
-				glm::quat finalOrientation = glm::quat(glm::vec3(_cameraAngles[camIndex], 0));
+				angles.x = glm::clamp(angles.x, -verticalAngleLimit, verticalAngleLimit);
+				glm::quat finalOrientation = glm::quat(glm::vec3(angles, 0));
 				camLink.setOrientation(finalOrientation);
 			}
-			++camIndex;
 		}
 	}
 
@@ -66,7 +66,7 @@ namespace AGE
 
 	}
 
-	bool FreeFlyCamera::_handleKeyboard(float time, Link &camLink, size_t camIdx)
+	bool FreeFlyCamera::_handleKeyboard(float time, Link &camLink, glm::vec2 &angles)
 	{
 		float camTranslationSpeed = 5.0f;
 		float maxAcceleration = 10.0f;
@@ -104,28 +104,28 @@ namespace AGE
 		// rotations
 		if (inputs->getPhysicalKeyPressed(AgeKeys::AGE_UP))
 		{
-			_cameraAngles[camIdx].x += camRotationSpeed * time;
+			angles.x += camRotationSpeed * time;
 			moved = true;
 		}
 		if (inputs->getPhysicalKeyPressed(AgeKeys::AGE_DOWN))
 		{
-			_cameraAngles[camIdx].x -= camRotationSpeed * time;
+			angles.x -= camRotationSpeed * time;
 			moved = true;
 		}
 		if (inputs->getPhysicalKeyPressed(AgeKeys::AGE_RIGHT))
 		{
-			_cameraAngles[camIdx].y -= camRotationSpeed * time;
+			angles.y -= camRotationSpeed * time;
 			moved = true;
 		}
 		if (inputs->getPhysicalKeyPressed(AgeKeys::AGE_LEFT))
 		{
-			_cameraAngles[camIdx].y += camRotationSpeed * time;
+			angles.y += camRotationSpeed * time;
 			moved = true;
 		}
 		return moved;
 	}
 
-	bool FreeFlyCamera::_handleMouse(float time, Link &camLink, size_t camIdx)
+	bool FreeFlyCamera::_handleMouse(float time, Link &camLink, glm::vec2 &angles)
 	{
 		float camMouseRotationSpeed = 0.0005f;
 		Input *inputs = _scene->getInstance<Input>();
@@ -143,14 +143,14 @@ namespace AGE
 		// If clicked, handle the rotation with the mouse
 		if (inputs->getMouseButtonPressed(AgeMouseButtons::AGE_MOUSE_RIGHT))
 		{
-			_cameraAngles[camIdx].y -= (float)inputs->getMouseDelta().x * camMouseRotationSpeed;
-			_cameraAngles[camIdx].x -= (float)inputs->getMouseDelta().y * camMouseRotationSpeed;
+			angles.y -= (float)inputs->getMouseDelta().x * camMouseRotationSpeed;
+			angles.x -= (float)inputs->getMouseDelta().y * camMouseRotationSpeed;
 			moved = true;
 		}
 		return moved;
 	}
 
-	bool FreeFlyCamera::_handleController(float time, Link &camLink, size_t camIdx)
+	bool FreeFlyCamera::_handleController(float time, Link &camLink, glm::vec2 &angles)
 	{
 		float camTranslationSpeed = 5.0f;
 		float maxAcceleration = 10.0f;
@@ -180,12 +180,12 @@ namespace AGE
 			// Handle rotations
 			if (glm::abs(controller.getAxis(AgeJoystickAxis::AGE_JOYSTICK_AXIS_RIGHTX)) > 0.3)
 			{
-				_cameraAngles[camIdx].y -= controller.getAxis(AgeJoystickAxis::AGE_JOYSTICK_AXIS_RIGHTX) * camRotationSpeed * time;
+				angles.y -= controller.getAxis(AgeJoystickAxis::AGE_JOYSTICK_AXIS_RIGHTX) * camRotationSpeed * time;
 				moved = true;
 			}
 			if (glm::abs(controller.getAxis(AgeJoystickAxis::AGE_JOYSTICK_AXIS_RIGHTY)) > 0.3)
 			{
-				_cameraAngles[camIdx].x -= controller.getAxis(AgeJoystickAxis::AGE_JOYSTICK_AXIS_RIGHTY) * camRotationSpeed * time;
+				angles.x -= controller.getAxis(AgeJoystickAxis::AGE_JOYSTICK_AXIS_RIGHTY) * camRotationSpeed * time;
 				moved = true;
 			}
 		}
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <limits>
 
 #include <SystemsCore/PhysicsSystem.hpp>
@@ -14,12 +15,25 @@
 
 namespace AGE
 {
+	bool PhysicsConfig::g_fixed_timestep_is_enabled = true;
+	bool PhysicsConfig::g_async_simulation_is_enabled = true;
+
 	// Constructors
 	PhysicsSystem::PhysicsSystem(AScene *scene, Physics::EngineType physicsEngineType, AssetsManager *assetManager, bool activateSimulation /* true */)
 		: System(scene), PluginManager("CreateInterface", "DestroyInterface"), assetManager(assetManager), entityFilter(scene), _activateSimulation(activateSimulation)
 	{
 		_name = "PhysicsSystem";
 		entityFilter.requireComponent<Private::PhysicsData>();
+		onEntityRemoved = [this](Entity entity)
+		{
+			auto found = std::find(movingBodies.begin(), movingBodies.end(), entity);
+			if (found != movingBodies.end())
+			{
+				*found = movingBodies.back();
+				movingBodies.pop_back();
+			}
+		};
+		entityFilter.setOnRemove(onEntityRemoved);
 		if (physicsEngineType == Physics::EngineType::Null)
 		{
 			physics = new Physics::NullPhysics;
@@ -77,6 +91,10 @@ namespace AGE
 	void PhysicsSystem::finalize(void)
 	{
 		assert(physics != nullptr && "System already finalized");
+		if (_activateSimulation && physics->getWorld()->isSimulating())
+		{
+			fetchSimulation();
+		}
 		Singleton<Logger>::getInstance()->log(Logger::Level::Normal, "Finalizing PhysicsSystem with plugin '", Physics::GetPluginNameForEngine(physics->getPluginType()), "'.");
 		const Physics::EngineType engineType = physics->getPluginType();
 		// Set Dependency to the fallback plugin (physics disabled) --> Needed if a RigidBody is added while no PhysicsSystem exists
@@ -96,66 +114,229 @@ namespace AGE
 		return true;
 	}
 
-	void PhysicsSystem::updateBegin(float elapsedTime)
+	void PhysicsSystem::fetchSimulation(void)
 	{
-		SCOPE_profile_cpu_function("Physic");
+		SCOPE_profile_cpu_i("Physic", "Fetch results");
+		Physics::WorldInterface *world = physics->getWorld();
+		const bool simulated = world->isSimulating();
+		world->endUpdate();
+		if (simulated)
+		{
+			storeSimulatedPoses();
+		}
+		world->updateDebugInformation();
+	}
 
-		if (_activateSimulation)
+	bool PhysicsSystem::storeSimulatedPose(const Entity &entity)
+	{
+		RigidBody *rigidBody = entity->getComponent<RigidBody>();
+		if (rigidBody == nullptr || rigidBody->isKinematic() || rigidBody->syncStamp == syncStamp)
 		{
-			RigidBody *rigidBody = nullptr;
-			Collider *collider = nullptr;
-			Link *link = nullptr;
-			for (const Entity &entity : entityFilter.getCollection())
+			return false;
+		}
+		rigidBody->syncStamp = syncStamp;
+		// the previous pose is one step before the gathered one
+		if (rigidBody->lastStepStamp == lastStepStamp)
+		{
+			rigidBody->previousPosition = rigidBody->lastStepPosition;
+			rigidBody->previousRotation = rigidBody->lastStepRotation;
+		}
+		else
+		{
+			rigidBody->previousPosition = rigidBody->currentPosition;
+			rigidBody->previousRotation = rigidBody->currentRotation;
+		}
+		rigidBody->currentPosition = rigidBody->getPosition();
+		rigidBody->currentRotation = rigidBody->getRotation();
+		if (rigidBody->hasSimulatedPose == false)
+		{
+			rigidBody->previousPosition = rigidBody->currentPosition;
+			rigidBody->previousRotation = rigidBody->currentRotation;
+			rigidBody->hasSimulatedPose = true;
+		}
+		return true;
+	}
+
+	void PhysicsSystem::storeSimulatedPoses(void)
+	{
+		Physics::WorldInterface *world = physics->getWorld();
+		if (world->getStepCount() == 0)
+		{
+			// nothing moved, the moving bodies keep being interpolated
+			return;
+		}
+		++syncStamp;
+		nextMovingBodies.clear();
+		if (world->reportsActiveBodies())
+		{
+			// the sleeping bodies are not read
+			for (Physics::Private::GenericData *data : world->getActiveBodies())
 			{
-				link = entity.getLinkPtr();
-				rigidBody = entity->getComponent<RigidBody>();
-				if (rigidBody != nullptr && rigidBody->isKinematic() == false)
+				if (storeSimulatedPose(data->entity))
 				{
-					//rigidBody->setPosition(posFromMat4(link->getGlobalTransform()));
-					// physx n'a pas l'air d'aimer ca
-					//rigidBody->setRotation(glm::quat_cast(link->getGlobalTransform()));
-					rigidBody->setPosition(link->getPosition());
-					rigidBody->setRotation(link->getOrientation());
+					nextMovingBodies.push_back(data->entity);
 				}
-				else if (rigidBody == nullptr)
+			}
+		}
+		else
+		{
+			for (const Entity &entity : entityFilter.getCollection())
+			{
+				if (storeSimulatedPose(entity))
 				{
-					collider = entity->getComponent<Collider>();
-					//collider->setPosition(posFromMat4(link->getGlobalTransform()));
-					collider->setPosition(link->getPosition());
-					// physx n'a pas l'air d'aimer ca
-					//collider->setRotation(glm::quat_cast(link->getGlobalTransform()));
-					collider->setRotation(link->getOrientation());
+					nextMovingBodies.push_back(entity);
 				}
 			}
 		}
+		// the bodies that just fell asleep are written one last time at their final pose
+		RigidBody *rigidBody = nullptr;
+		for (const Entity &entity : movingBodies)
+		{
+			rigidBody = entity->getComponent<RigidBody>();
+			if (rigidBody != nullptr && rigidBody->syncStamp != syncStamp
+				&& (rigidBody->previousPosition != rigidBody->currentPosition || rigidBody->previousRotation != rigidBody->currentRotation))
+			{
+				rigidBody->syncStamp = syncStamp;
+				rigidBody->previousPosition = rigidBody->currentPosition;
+				rigidBody->previousRotation = rigidBody->currentRotation;
+				nextMovingBodies.push_back(entity);
+			}
+		}
+		std::swap(movingBodies, nextMovingBodies);
 	}
 
-	void PhysicsSystem::mainUpdate(float elapsedTime)
+	void PhysicsSystem::storeLastStepPoses(void)
+	{
+		Physics::WorldInterface *world = physics->getWorld();
+		if (world->reportsActiveBodies())
+		{
+			// the bodies not moved by the first steps keep their current pose as previous pose
+			for (Physics::Private::GenericData *data : world->getActiveBodies())
+			{
+				storeLastStepPose(data->entity);
+			}
+		}
+		else
+		{
+			for (const Entity &entity : entityFilter.getCollection())
+			{
+				storeLastStepPose(entity);
+			}
+		}
+	}
+
+	void PhysicsSystem::storeLastStepPose(const Entity &entity)
+	{
+		RigidBody *rigidBody = entity->getComponent<RigidBody>();
+		if (rigidBody == nullptr || rigidBody->isKinematic() || rigidBody->lastStepStamp == lastStepStamp)
+		{
+			return;
+		}
+		rigidBody->lastStepStamp = lastStepStamp;
+		rigidBody->lastStepPosition = rigidBody->getPosition();
+		rigidBody->lastStepRotation = rigidBody->getRotation();
+	}
+
+	void PhysicsSystem::pushUserTransforms(void)
+	{
+		RigidBody *rigidBody = nullptr;
+		Collider *collider = nullptr;
+		Link *link = nullptr;
+		for (const Entity &entity : entityFilter.getCollection())
+		{
+			link = entity.getLinkPtr();
+			// the PhysicsSystem writes the links without flagging them, only the user can
+			if (link->isUserModified() == false)
+			{
+				continue;
+			}
+			rigidBody = entity->getComponent<RigidBody>();
+			if (rigidBody != nullptr && rigidBody->isKinematic() == false)
+			{
+				//rigidBody->setPosition(posFromMat4(link->getGlobalTransform()));
+				// physx n'a pas l'air d'aimer ca
+				//rigidBody->setRotation(glm::quat_cast(link->getGlobalTransform()));
+				rigidBody->setPosition(link->getPosition());
+				rigidBody->setRotation(link->getOrientation());
+				// teleported, nothing to interpolate
+				rigidBody->previousPosition = rigidBody->currentPosition = link->getPosition();
+				rigidBody->previousRotation = rigidBody->currentRotation = link->getOrientation();
+				rigidBody->hasSimulatedPose = true;
+				link->setUserModified(false);
+			}
+			else if (rigidBody == nullptr)
+			{
+				collider = entity->getComponent<Collider>();
+				//collider->setPosition(posFromMat4(link->getGlobalTransform()));
+				collider->setPosition(link->getPosition());
+				// physx n'a pas l'air d'aimer ca
+				//collider->setRotation(glm::quat_cast(link->getGlobalTransform()));
+				collider->setRotation(link->getOrientation());
+				link->setUserModified(false);
+			}
+		}
+	}
+
+	void PhysicsSystem::updateBegin(float elapsedTime)
 	{
 		SCOPE_profile_cpu_function("Physic");
 
 		if (_activateSimulation)
 		{
-			physics->getWorld()->update(elapsedTime);
+			Physics::WorldInterface *world = physics->getWorld();
+			// the step started at the last frame
+			if (world->isSimulating() || PhysicsConfig::g_async_simulation_is_enabled)
+			{
+				fetchSimulation();
+			}
+			pushUserTransforms();
+			if (PhysicsConfig::g_fixed_timestep_is_enabled)
+			{
+				world->enableFixedTimestep();
+			}
+			else
+			{
+				world->disableFixedTimestep();
+			}
+			world->beginUpdate(elapsedTime);
+			++lastStepStamp;
+			if (world->getStepCount() > 1)
+			{
+				// the steps but the last one are done, only the last one is interpolated
+				storeLastStepPoses();
+			}
+			world->simulateLastStep();
+			if (PhysicsConfig::g_async_simulation_is_enabled == false)
+			{
+				fetchSimulation();
+			}
 		}
 	}
 
+	void PhysicsSystem::mainUpdate(float elapsedTime)
+	{
+		SCOPE_profile_cpu_function("Physic");
+	}
+
 	void PhysicsSystem::updateEnd(float elapsedTime)
 	{
 		SCOPE_profile_cpu_function("Physic");
 
 		if (_activateSimulation)
 		{
+			// the bodies can be simulating, only the stored poses are read
+			// the factor is the one of the gathered steps, not of the steps started by this frame
+			const float factor = physics->getWorld()->getInterpolationFactor();
 			RigidBody *rigidBody = nullptr;
 			Link *link = nullptr;
-			for (const Entity &entity : entityFilter.getCollection())
+			for (const Entity &entity : movingBodies)
 			{
-				link = entity.getLinkPtr();
 				rigidBody = entity->getComponent<RigidBody>();
 				if (rigidBody != nullptr && rigidBody->isKinematic() == false)
 				{
-					link->setPosition(rigidBody->getPosition());
-					link->setOrientation(rigidBody->getRotation());
+					link = entity.getLinkPtr();
+					link->internalSetPosition(glm::mix(rigidBody->previousPosition, rigidBody->currentPosition, factor), true);
+					link->internalSetOrientation(glm::slerp(rigidBody->previousRotation, rigidBody->currentRotation, factor), true);
 				}
 			}
 		}
@@ -12,6 +12,17 @@
 
 namespace AGE
 {
+	class PhysicsConfig
+	{
+	public:
+		// Simulate in fixed steps of 1 / target FPS of the world
+		// the transforms of the links are interpolated between the two last steps
+		static bool g_fixed_timestep_is_enabled;
+		// The last step of the frame runs while the other systems update,
+		// its results are fetched at the beginning of the next frame
+		static bool g_async_simulation_is_enabled;
+	};
+
 	class PhysicsSystem final : public System<PhysicsSystem>, public PluginManager<Physics::PhysicsInterface>
 	{
 	public:
@@ -43,6 +54,30 @@ namespace AGE
 
 		const bool _activateSimulation;
 
+		// Bodies moved by the last steps, their links are interpolated
+		std::vector<Entity> movingBodies;
+
+		std::vector<Entity> nextMovingBodies;
+
+		std::size_t syncStamp = 0;
+
+		std::size_t lastStepStamp = 0;
+
+		std::function<void(Entity)> onEntityRemoved;
+
+		// Methods
+		void fetchSimulation(void);
+
+		void storeSimulatedPoses(void);
+
+		bool storeSimulatedPose(const Entity &entity);
+
+		void storeLastStepPoses(void);
+
+		void storeLastStepPose(const Entity &entity);
+
+		void pushUserTransforms(void);
+
 		// Inherited Methods
 		bool initialize(void) override final;
 
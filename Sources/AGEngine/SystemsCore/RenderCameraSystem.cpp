@@ -7,6 +7,7 @@
 
 #include <Core/Engine.hh>
 #include <Core/AScene.hh>
+#include <Context/IRenderContext.hh>
 
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -68,7 +69,6 @@ namespace AGE
 		_spotLights.requireComponent<SpotLightComponent>();
 		_directionnalLights.requireComponent<DirectionalLightComponent>();
 		_pointLights.requireComponent<PointLightComponent>();
-		_spotCounter = 0;
 		return (true);
 	}
 
@@ -77,100 +77,18 @@ namespace AGE
 		_drawDebugLines = activated;
 	}
 
-	void occlusionCulling(std::list<std::shared_ptr<DRBData>> &list, bool drawDebugLines)
-	{
-		SCOPE_profile_cpu_function("Camera system");
-
-		auto depthMap = GetRenderThread()->getDepthMapManager().getReadableMap();
-		//for (auto &e : cameraList->meshs)
-		//{
-		//	readableDepthMap->testBox()
-		//}
-
-		if (depthMap.isValid() == false)
-		{
-			return;
-		}
-
-		auto j = list.begin();
-		while (j != std::end(list))
-		{
-			auto &d = *j;
-			auto mesh = std::static_pointer_cast<DRBMeshData>(d);
-			if (mesh->hadRenderMode(AGE_OCCLUDER) || mesh->hadRenderMode(AGE_SKINNED))
-			{
-				++j;
-				continue;
-			}
-			auto BB = mesh->getAABB();
-
-
-			glm::vec2 minPoint = glm::vec2(1);
-			glm::vec2 maxPoint = glm::vec2(-1);
-
-			float minZ = std::numeric_limits<float>::max();
-
-			for (std::size_t i = 0; i < 8; ++i)
-			{
-				auto point = depthMap->getMV() * d->getTransformation() * glm::vec4(BB.getCornerPoint(i), 1.0f);
-				point /= point.w;
-
-				if (point.x < -1)
-				{
-					point.x = -1;
-				}
-				if (point.y < -1)
-				{
-					point.y = -1;
-				}
-				if (point.x > 1)
-				{
-					point.x = 1;
-				}
-				if (point.y > 1)
-				{
-					point.y = 1;
-				}
-
-				minPoint.x = std::min(minPoint.x, point.x);
-				minPoint.y = std::min(minPoint.y, point.y);
-				maxPoint.x = std::max(maxPoint.x, point.x);
-				maxPoint.y = std::max(maxPoint.y, point.y);
-
-				point.z = (point.z + 1.0f) * 0.5f;
-				minZ = std::min(minZ, point.z);
-			}
-
-			glm::uvec2 screenMin(((minPoint + glm::vec2(1)) / glm::vec2(2)) * glm::vec2(depthMap->getMipmapWidth(), depthMap->getMipmapHeight()));
-			glm::uvec2 screenMax(((maxPoint + glm::vec2(1)) / glm::vec2(2)) * glm::vec2(depthMap->getMipmapWidth(), depthMap->getMipmapHeight()));
-
-			if (minZ < 0)
-			{
-				minZ = 0;
-			}
-
-			if (depthMap->testBox((uint32_t)(minZ * (1 << 24)), screenMin, screenMax) == false)
-			{
-				list.erase(j++);
-				continue;
-			}
-			if (drawDebugLines)
-			{
-				//TMQ::TaskManager::emplaceRenderTask<AGE::Commands::ToRender::Draw2DQuad>(glm::vec2(minPoint.x, minPoint.y), glm::vec2(minPoint.x, maxPoint.y), glm::vec2(maxPoint.x, maxPoint.y), glm::vec2(maxPoint.x, minPoint.y), glm::vec3(0, 1, 0));
-			}
-			++j;
-		}
-	}
-
 	void RenderCameraSystem::mainUpdate(float time)
 	{
 		SCOPE_profile_cpu_function("Camera system");
 
-		AGE_ASSERT(_spotCounter == 0);
+		AGE_ASSERT(_spotCounter.isDone());
 		AGE_ASSERT(_camerasDrawLists.size() == 0);
 		AGE_ASSERT(_frustumCullers.empty());
+		AGE_ASSERT(_occlusionCullers.empty());
 
 		_scene->getBfcLinkTracker()->reset();
+		_scene->getBfcBlockManagerFactory()->updateBlocks();
+		++_frame;
 
 		// check if the render thread does not already have stuff to draw
 		if (GetMainThread()->isRenderFrame() == false)
@@ -243,12 +161,30 @@ namespace AGE
 				meshOutput->getCommandOutput()._spotLightMatrix = spotViewProj;
 				skinnedOutput->getCommandOutput()._spotLightMatrix = spotViewProj;
 
+				// shadow lods are chosen from the spot point of view,
+				// without hysteresis : spots are culled concurrently
+				BFCOutputView spotView;
+				spotView.position = spot->getPosition();
+				spotView.projectionScale = spot->getShadowProjectionScale();
+				meshOutput->setView(spotView);
+				skinnedOutput->setView(spotView);
+
 				spotCuller.addOutput(BFCCullableType::CullableMesh, meshOutput);
 				spotCuller.addOutput(BFCCullableType::CullableSkinnedMesh, skinnedOutput);
+				spotCuller.setVisibilityCache(_getVisibilityCache(_spotCaches, spotEntity, spotViewProj));
 				spotCuller.cull(bf, &_spotCounter);
 			}
 		}
 
+		// the depth of the last frames is kept readable until the culling tasks are done
+		// it's the depth seen by the first camera, other cameras only use frustum culling
+		auto depthMap = GetRenderThread()->getDepthMapManager().getReadableMap();
+		const BFCDepthPyramid *depthPyramid = nullptr;
+		if (OcclusionConfig::g_Occlusion_is_enabled && depthMap.isValid())
+		{
+			depthPyramid = &depthMap->getPyramid();
+		}
+
 		for (auto &cameraEntity : _cameras.getCollection())
 		{
 			SCOPE_profile_cpu_i("Camera system", "Cull for cam");
@@ -256,8 +192,6 @@ namespace AGE
 			Frustum cameraFrustum;
 			auto camera = cameraEntity->getComponent<CameraComponent>();
 
-			std::atomic_size_t counter = 0;
-
 			auto cameraList = std::make_shared<DRBCameraDrawableList>();
 			cameraList->spotlightsOutput = spotLightOutput;
 			cameraList->cameraInfos.data = camera->getData();
@@ -266,18 +200,16 @@ namespace AGE
 
 			cameraFrustum.setMatrix(camera->getProjection() * cameraList->cameraInfos.view);
 
-			LFList<BFCItem> pointLightListToCull;
-			std::size_t pointLightBlocksToCullNumber = _scene->getBfcBlockManagerFactory()->getBlockNumberToCull(BFCCullableType::CullablePointLight);
-			counter = pointLightBlocksToCullNumber;
-
 			BFCBlockManagerFactory *bf = _scene->getBfcBlockManagerFactory();
+
+			//We create a culler, with the culling rules "Frustum" then "Occlusion"
+			_occlusionCullers.emplace_back();
+			auto &cameraCuller = _occlusionCullers.back();
+			const BFCDepthPyramid *cameraPyramid = cameraEntity == firstCameraEntity ? depthPyramid : nullptr;
+			cameraCuller.prepareForCulling(cameraFrustum, cameraPyramid);
+
 			if (DeferredBasicBuffering::instance)
 			{
-				//We create a culler, with the culling rule "Frustum"
-				_frustumCullers.emplace_back();
-				auto &cameraCuller = _frustumCullers.back();
-				//We pass infos for frustum culling
-				cameraCuller.prepareForCulling(cameraFrustum);
 				//We get an output of a specific type
 				//here it's for mesh for basic buffering pass
 				auto meshOutput = DeferredBasicBuffering::MeshOutput::GetNewOutput();
@@ -290,63 +222,48 @@ namespace AGE
 				auto skinnedMeshResultQueue = DeferredBasicBuffering::instance->getSkinnedMeshResultQueue();
 				meshOutput->setResultQueue(meshResultQueue);
 				skinnedMeshOutput->setResultQueue(skinnedMeshResultQueue);
+				BFCOutputView cameraView;
+				cameraView.position = glm::vec3(cameraEntity->getLink().getGlobalTransform()[3]);
+				cameraView.projectionScale = camera->getProjection()[1][1];
+				cameraView.viewportHeight = float(_scene->getInstance<IRenderContext>()->getScreenSize().y);
+				// only one camera can keep the lod states
+				cameraView.slot = cameraEntity == firstCameraEntity ? DRBMeshData::CameraLodSlot : BFCOutputView::NoSlot;
+				meshOutput->setView(cameraView);
+				skinnedMeshOutput->setView(cameraView);
 				cameraCuller.addOutput(BFCCullableType::CullableMesh, meshOutput);
 				cameraCuller.addOutput(BFCCullableType::CullableSkinnedMesh, skinnedMeshOutput);
-				_cameraCounters.emplace_back(0);
-				cameraCuller.cull(bf, &_cameraCounters.back());
 			}
 
-			{
-				SCOPE_profile_cpu_i("Camera system", "Cull for pointlights");
-
-				for (std::size_t i = 0; i < pointLightBlocksToCullNumber; ++i)
-				{
-					BFCBlockManagerFactory *bf = _scene->getBfcBlockManagerFactory();
-					bf->cullOnBlock(BFCCullableType::CullablePointLight, pointLightListToCull, cameraFrustum, i, 1);
-				}
-			}
+			// point lights are culled by the same tasks,
+			// the output fill the SoA infos read by the light passes
+			auto pointLightOutput = BasicCommandGeneration::PointlightOutput::GetNewOutput();
+			cameraList->pointLights = pointLightOutput;
+			cameraCuller.addOutput(BFCCullableType::CullablePointLight, pointLightOutput);
 
+			// occlusion depend on moving occluders, results can't be kept between frames
+			if (cameraPyramid == nullptr)
 			{
-				SCOPE_profile_cpu_i("Camera system", "Copy LFList to std");
-
-				while (pointLightListToCull.getSize() > 0)
-				{
-					cameraList->pointLights.push_back(PointlightInfos());
-					auto pl = (DRBPointLight*)pointLightListToCull.pop()->getDrawable();
-					cameraList->pointLights.back().range = pl->getRange();
-					cameraList->pointLights.back().sphereTransform = pl->getSphereTransform();
-					cameraList->pointLights.back().position = pl->getPosition();
-					cameraList->pointLights.back().colorLight = pl->getColorLight();
-					cameraList->pointLights.back().ambiantColor = pl->getAmbiantColor();
-				}
+				cameraCuller.setVisibilityCache(_getVisibilityCache(_cameraCaches, cameraEntity, camera->getProjection() * cameraList->cameraInfos.view));
 			}
-			//if (OcclusionConfig::g_Occlusion_is_enabled)
-			//{
-			//	occlusionCulling(cameraList->meshs, _drawDebugLines);
-			//}
+			_cameraCounters.emplace_back();
+			cameraCuller.cull(bf, &_cameraCounters.back());
 
 		}
 
 		///////////////////////////////
-		/// BLOCKING WAIT FOR SPOTS
+		/// WAIT FOR SPOTS AND CAMERAS CULLING
+		/// other tasks are executed while waiting
 		{
 			SCOPE_profile_cpu_i("Camera system", "Cull for spots wait");
-			while (_spotCounter.load() > 0)
-			{
-				while (CurrentMainThread()->tryToStealTasks())
-				{
-				}
-			}
+			WaitForCounter(_spotCounter);
 		}
-		auto counterIt = _cameraCounters.begin();
-		while (_cameraCounters.empty() == false)
 		{
-			if (counterIt->load() == 0)
+			SCOPE_profile_cpu_i("Camera system", "Cull for cameras wait");
+			for (auto &counter : _cameraCounters)
 			{
-				counterIt = _cameraCounters.erase(counterIt);
-				continue;
+				WaitForCounter(counter);
 			}
-			CurrentMainThread()->tryToStealTasks();
+			_cameraCounters.clear();
 		}
 		for (auto &e : _camerasDrawLists)
 		{
@@ -354,6 +271,34 @@ namespace AGE
 		}
 		_camerasDrawLists.clear();
 		_frustumCullers.clear();
+		_occlusionCullers.clear();
+		_releaseUnusedCaches(_spotCaches);
+		_releaseUnusedCaches(_cameraCaches);
+	}
+
+	BFCVisibilityCache *RenderCameraSystem::_getVisibilityCache(std::unordered_map<ENTITY_ID, VisibilityCache> &caches, const Entity &entity, const glm::mat4 &viewProj)
+	{
+		auto &entry = caches[entity.getId()];
+		// the entity id can have been reused, but results only depend on the view
+		// and on the blocks versions so they stay valid
+		entry.frame = _frame;
+		entry.cache.prepare(viewProj);
+		return &entry.cache;
+	}
+
+	void RenderCameraSystem::_releaseUnusedCaches(std::unordered_map<ENTITY_ID, VisibilityCache> &caches)
+	{
+		for (auto it = caches.begin(); it != caches.end();)
+		{
+			if (it->second.frame != _frame)
+			{
+				it = caches.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
 	}
 
 }
\ No newline at end of file
@@ -4,6 +4,11 @@
 #include <Core/EntityFilter.hpp>
 #include <BFC/BFCCuller.hpp>
 #include <BFC/BFCFrustumCuller.hpp>
+#include <BFC/BFCOcclusionCuller.hpp>
+#include <Threads/TaskScheduler.hpp>
+#include <BFC/BFCVisibilityCache.hpp>
+
+#include <unordered_map>
 
 namespace AGE
 {
@@ -25,10 +30,24 @@ namespace AGE
 		bool         _drawDebugLines;
 		bool         _cullingEnabled;
 
-		std::atomic_uint64_t _spotCounter;
+		TaskCounter _spotCounter;
 		std::vector<std::shared_ptr<DRBCameraDrawableList>> _camerasDrawLists;
-		std::list<std::atomic_size_t> _cameraCounters;
+		std::list<TaskCounter> _cameraCounters;
 		std::list<BFCCuller<BFCFrustumCuller>> _frustumCullers;
+		std::list<BFCCuller<BFCOcclusionCuller>> _occlusionCullers;
+
+		// culling results of static blocks, kept between frames per light and camera
+		struct VisibilityCache
+		{
+			BFCVisibilityCache cache;
+			std::size_t        frame = 0;
+		};
+		std::unordered_map<ENTITY_ID, VisibilityCache> _spotCaches;
+		std::unordered_map<ENTITY_ID, VisibilityCache> _cameraCaches;
+		std::size_t                                    _frame = 0;
+
+		BFCVisibilityCache *_getVisibilityCache(std::unordered_map<ENTITY_ID, VisibilityCache> &caches, const Entity &entity, const glm::mat4 &viewProj);
+		void _releaseUnusedCaches(std::unordered_map<ENTITY_ID, VisibilityCache> &caches);
 
 		virtual bool initialize();
 		virtual void mainUpdate(float time);
@@ -36,10 +36,17 @@ namespace AGE
 			return true;
 		}
 		inline std::size_t         pushChunk(const T *data, std::size_t size)
+		{
+			std::size_t offset;
+			return pushChunk(data, size, offset);
+		}
+		// offset is the index of the first pushed element
+		inline std::size_t         pushChunk(const T *data, std::size_t size, std::size_t &offset)
 		{
 			std::size_t index = _index.fetch_add(size);
 			std::size_t availableSize = size;
 
+			offset = index;
 			if (index >= _capacity)
 			{
 				_index = _capacity;
@@ -36,5 +36,9 @@ namespace AGE
 		bool checkCollision(Sphere const &sphere) const;
 		bool checkCollision(glm::vec4 const &sphere) const;
 		bool checkCollision(Frustum const &frustum) const;
+
+		// used by SIMD cullers which test planes by themselves
+		inline const Plane &getPlane(int i) const { return _planes[i]; }
+		static const int PlaneNumber = PLANE_END;
 	};
 }
\ No newline at end of file
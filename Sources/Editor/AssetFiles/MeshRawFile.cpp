@@ -104,6 +104,11 @@ namespace AGE
 				ImGui::Checkbox("Texture coordinates", &dataset->uvs);
 				ImGui::Checkbox("Tangents", &dataset->tangents);
 				ImGui::Checkbox("BiTangents", &dataset->biTangents);
+				ImGui::Checkbox("Generate LODs", &dataset->generateLods);
+				if (dataset->generateLods)
+				{
+					ImGui::SliderInt("LOD number", &dataset->lodNumber, 1, 5);
+				}
 			}
 			ImGui::Separator();
 
@@ -60,6 +60,8 @@ namespace AGE
 		bool uvs = true;
 		bool tangents = true;
 		bool biTangents = true;
+		bool generateLods = true;
+		int lodNumber = 3;
 
 		//Physic Options
 		bool convex = true;
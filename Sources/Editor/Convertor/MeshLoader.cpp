@@ -5,6 +5,7 @@
 #include <map>
 #include <Skinning/Skeleton.hpp>
 #include <AssetManagement/Data/MeshData.hh>
+#include <AssetManagement/Data/MeshLod.hpp>
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include "ConvertorStatusManager.hpp"
@@ -211,6 +212,17 @@ namespace AGE
 				}
 			}
 		}
+
+		// after normalization, cells are relative to the final bounding boxes
+		if (cookingTask->dataSet->generateLods)
+		{
+			MeshLodSettings lodSettings;
+			lodSettings.lodNumber = std::size_t(glm::max(cookingTask->dataSet->lodNumber, 0));
+			for (auto &e : cookingTask->mesh->subMeshs)
+			{
+				GenerateMeshLods(e, lodSettings);
+			}
+		}
 		Singleton<AGE::AE::ConvertorStatusManager>::getInstance()->PopTask(tid);
 		return true;
 	}
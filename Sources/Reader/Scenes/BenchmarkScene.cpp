@@ -57,6 +57,8 @@
 #include <EngineCoreTestConfiguration.hpp>
 
 #include <Skinning/Skeleton.hpp>
+#include <Skinning/AnimationChannel.hpp>
+#include <Render/Textures/TextureStreamer.hh>
 #include <Utils/MatrixConversion.hpp>
 
 #include <SystemsCore/FreeFlyCamera.hh>
@@ -69,11 +71,50 @@
 #include <Graphic/BFCCullableTypes.hpp>
 #include <BFC/BFCBlockManagerFactory.hpp>
 #include <BFC/BFCLinkTracker.hpp>
+#include <BFC/BFCFrustumCuller.hpp>
+#include <BFC/BFCCullingOptions.hpp>
+#include <Graphic/MeshLodOptions.hpp>
+
+#include <Utils/Frustum.hh>
+
+#include <chrono>
 
 #include <glm/gtc/random.hpp>
 
 namespace AGE
 {
+	// Cull all the mesh blocks on the main thread with the given mode
+	// and return the average time in milliseconds
+	static float benchmarkFrustumCulling(BFCBlockManagerFactory *factory, bool simd, std::size_t &culledNumber)
+	{
+		static const std::size_t iterations = 100;
+
+		Frustum frustum;
+		frustum.setMatrix(glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f)
+			* glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+
+		BFCFrustumCuller culler;
+		std::vector<IBFCOutput*> noOutput;
+		auto blockNumber = factory->getBlockNumberToCull(BFCCullableType::CullableMesh);
+
+		culledNumber = 0;
+		auto start = std::chrono::high_resolution_clock::now();
+		for (std::size_t i = 0; i < iterations; ++i)
+		{
+			for (std::size_t block = 0; block < blockNumber; ++block)
+			{
+				culler.reset();
+				culler.prepareForCulling(frustum);
+				culler.setSimdEnabled(simd);
+				factory->cullOnBlock(BFCCullableType::CullableMesh, &culler, block, 1, noOutput);
+				culledNumber += culler.getArray().size();
+			}
+		}
+		auto stop = std::chrono::high_resolution_clock::now();
+		culledNumber /= iterations;
+		return float(std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count()) / float(iterations) / 1000.0f;
+	}
+
 	BenchmarkScene::BenchmarkScene(AGE::Engine *engine)
 		: AScene(engine)
 	{
@@ -209,7 +250,6 @@ namespace AGE
 
 			EngineCoreTestConfiguration::saveConfigurations();
 			clearAllEntities();
-			getSystem<FreeFlyCamera>()->hackClear();
 
 			auto sceneFileName = EngineCoreTestConfiguration::getSelectedScenePath();
 
@@ -251,6 +291,8 @@ namespace AGE
 		static bool physicsDebug = false;
 		bool lastValue = physicsDebug;
 		ImGui::Checkbox("Physics Debug", &physicsDebug);
+		ImGui::Checkbox("Physics fixed timestep", &AGE::PhysicsConfig::g_fixed_timestep_is_enabled);
+		ImGui::Checkbox("Async physics", &AGE::PhysicsConfig::g_async_simulation_is_enabled);
 		if (physicsDebug != lastValue)
 		{
 			if (physicsDebug)
@@ -265,6 +307,49 @@ namespace AGE
 
 		ImGui::Checkbox("Occlusion culling", &AGE::OcclusionConfig::g_Occlusion_is_enabled);
 		ImGui::Checkbox("Enable culling", &getSystem<RenderCameraSystem>()->enableCulling());
+		ImGui::Checkbox("SIMD frustum culling", &AGE::BFCCullingConfig::g_SIMD_is_enabled);
+		ImGui::Checkbox("BFC radix sort keys", &AGE::BFCCullingConfig::g_sort_keys_is_enabled);
+		ImGui::Checkbox("BFC block bounds", &AGE::BFCCullingConfig::g_block_bounds_is_enabled);
+		ImGui::Checkbox("BFC spatial blocks", &AGE::BFCCullingConfig::g_spatial_blocks_is_enabled);
+		ImGui::Checkbox("BFC static partition", &AGE::BFCCullingConfig::g_static_partition_is_enabled);
+		ImGui::Checkbox("BFC visibility cache", &AGE::BFCCullingConfig::g_visibility_cache_is_enabled);
+		ImGui::Checkbox("Mesh LOD", &AGE::MeshLodConfig::g_lod_is_enabled);
+		if (AGE::MeshLodConfig::g_lod_is_enabled)
+		{
+			ImGui::SliderFloat("LOD bias", &AGE::MeshLodConfig::g_lod_bias, 0.1f, 4.0f);
+		}
+		ImGui::Checkbox("Animation LOD", &AGE::AnimationConfig::g_lod_is_enabled);
+		if (AGE::AnimationConfig::g_lod_is_enabled)
+		{
+			ImGui::Checkbox("Freeze offscreen animations", &AGE::AnimationConfig::g_lod_freeze_offscreen);
+		}
+		ImGui::Checkbox("Parallel systems update", &AGE::SystemsConfig::g_parallel_update_is_enabled);
+		ImGui::Checkbox("Texture streaming", &AGE::TextureStreamingConfig::g_streaming_is_enabled);
+		ImGui::Checkbox("Texture residency", &AGE::TextureResidencyConfig::g_residency_is_enabled);
+		if (AGE::TextureResidencyConfig::g_residency_is_enabled)
+		{
+			static int residencyBudget = int(AGE::TextureResidencyConfig::g_residency_budget / (1024 * 1024));
+			if (ImGui::SliderInt("Residency budget (MB)", &residencyBudget, 16, 2048))
+			{
+				AGE::TextureResidencyConfig::g_residency_budget = std::size_t(residencyBudget) * 1024 * 1024;
+			}
+			ImGui::SliderFloat("Residency bias", &AGE::TextureResidencyConfig::g_residency_bias, -2.0f, 4.0f);
+			auto &stats = AGE::GetRenderThread()->getTextureStreamer().getResidencyStats();
+			ImGui::Text("%i textures, %i MB resident, %i MB required", int(stats.textures), int(stats.residentBytes / (1024 * 1024)), int(stats.requiredBytes / (1024 * 1024)));
+			ImGui::Text("%i levels evicted (%i MB), %i files read again", int(stats.evictedLevels), int(stats.evictedBytes / (1024 * 1024)), int(stats.reloads));
+		}
+
+		static float perItemCullingTime = 0.0f;
+		static float simdCullingTime = 0.0f;
+		static std::size_t perItemCulled = 0;
+		static std::size_t simdCulled = 0;
+		if (ImGui::Button("Benchmark frustum culling"))
+		{
+			perItemCullingTime = benchmarkFrustumCulling(getBfcBlockManagerFactory(), false, perItemCulled);
+			simdCullingTime = benchmarkFrustumCulling(getBfcBlockManagerFactory(), true, simdCulled);
+		}
+		ImGui::Text("Per item : %f ms (%i visible)", perItemCullingTime, int(perItemCulled));
+		ImGui::Text("SIMD     : %f ms (%i visible)", simdCullingTime, int(simdCulled));
 #endif
 
 		if (rain && _chunkCounter >= _maxChunk)
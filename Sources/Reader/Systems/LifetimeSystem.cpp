@@ -23,20 +23,29 @@ namespace AGE
 
 	void LifetimeSystem::mainUpdate(float time)
 	{
-		auto scene = _scene;
-		EntityFilter::Lock lock(_filter);
+		// can run on a worker, destruction is done in updateSynchronized
 		auto &collection = _filter.getCollection();
 		for (auto &e : collection)
 		{
 			e->getComponent<Lifetime>()->_t -= time;
 			if (e->getComponent<Lifetime>()->_t <= 0.0f)
-				scene->destroy(e);
+				_expired.push_back(e);
 		}
 	}
 
+	void LifetimeSystem::updateSynchronized(float time)
+	{
+		for (auto &e : _expired)
+		{
+			_scene->destroy(e);
+		}
+		_expired.clear();
+	}
+
 	bool LifetimeSystem::initialize()
 	{
 		_filter.requireComponent<Lifetime>();
+		writeComponent<Lifetime>();
 		return true;
 	}
 }
\ No newline at end of file
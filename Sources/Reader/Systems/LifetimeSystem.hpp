@@ -1,6 +1,7 @@
 #pragma once
 
 #include <System/System.h>
+#include <vector>
 
 namespace AGE
 {
@@ -11,9 +12,11 @@ namespace AGE
 		virtual ~LifetimeSystem();
 	private:
 		EntityFilter _filter;
+		std::vector<Entity> _expired;
 		virtual void updateBegin(float time);
 		virtual void updateEnd(float time);
 		virtual void mainUpdate(float time);
+		virtual void updateSynchronized(float time);
 		virtual bool initialize();
 	};
 }
\ No newline at end of file
@@ -26,6 +26,21 @@ namespace AGE
 
 	void RotationSystem::mainUpdate(float time)
 	{
+#ifdef AGE_CHUNK_STORAGE
+		const ComponentType rotationType = Component<RotationComponent>::getTypeId();
+		_filter.forEachChunk([&](const EntityChunk &chunk)
+		{
+			auto entities = chunk.getEntities();
+			auto rotations = chunk.getComponents(rotationType);
+			for (std::size_t i = 0, mi = chunk.size(); i < mi; ++i)
+			{
+				auto rotation = static_cast<RotationComponent*>(rotations[i]);
+				auto &link = entities[i]->getLink();
+				auto res = glm::rotate(link.getOrientation(), glm::radians(time * rotation->_speed), rotation->_angles);
+				link.setOrientation(res);
+			}
+		});
+#else
 		auto &collection = _filter.getCollection();
 		for (auto &e : collection)
 		{
@@ -35,11 +50,14 @@ namespace AGE
 			auto res = glm::rotate(quaternion, glm::radians(time * e->getComponent<RotationComponent>()->_speed), rotation);
 			e->getLink().setOrientation(res);
 		}
+#endif
 	}
 
 	bool RotationSystem::initialize()
 	{
 		_filter.requireComponent<RotationComponent>();
+		readComponent<RotationComponent>();
+		writeResource(SystemResource::Links);
 		return true;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include "Tests.hpp"
+
+#include <BFC/BFCDepthPyramid.hpp>
+
+#include <cmath>
+#include <vector>
+
+namespace AGE
+{
+	namespace Tests
+	{
+		void BFCDepthPyramidTests()
+		{
+			// each level keeps the farthest depth of the 2x2 texels under it
+			{
+				const float depths[16] = {
+					0.1f, 0.2f, 0.3f, 0.3f,
+					0.4f, 0.1f, 0.3f, 0.9f,
+					0.5f, 0.5f, 0.2f, 0.2f,
+					0.5f, 0.6f, 0.2f, 0.2f };
+				BFCDepthPyramid pyramid;
+				pyramid.build(depths, 4, 4, glm::mat4(1));
+				AGE_TEST_CHECK(pyramid.isValid());
+				AGE_TEST_CHECK(pyramid.getLevelNumber() == 3);
+				const auto &level = pyramid.getLevel(1);
+				AGE_TEST_CHECK(level.width == 2 && level.height == 2);
+				AGE_TEST_CHECK(level.depths[0] == 0.4f);
+				AGE_TEST_CHECK(level.depths[1] == 0.9f);
+				AGE_TEST_CHECK(level.depths[2] == 0.6f);
+				AGE_TEST_CHECK(level.depths[3] == 0.2f);
+				AGE_TEST_CHECK(pyramid.getLevel(2).depths[0] == 0.9f);
+			}
+
+			// odd sizes are rounded up, the last texel covers the last source texel
+			{
+				std::vector<float> depths(5 * 3, 0.5f);
+				depths[14] = 0.75f;
+				BFCDepthPyramid pyramid;
+				pyramid.build(depths.data(), 5, 3, glm::mat4(1));
+				AGE_TEST_CHECK(pyramid.getLevelNumber() == 4);
+				const auto &level = pyramid.getLevel(1);
+				AGE_TEST_CHECK(level.width == 3 && level.height == 2);
+				AGE_TEST_CHECK(level.depths[5] == 0.75f);
+				AGE_TEST_CHECK(level.depths[0] == 0.5f);
+				const auto &last = pyramid.getLevel(3);
+				AGE_TEST_CHECK(last.width == 1 && last.height == 1);
+				AGE_TEST_CHECK(last.depths[0] == 0.75f);
+			}
+
+			// depth stencil read backs, the stencil byte is ignored
+			{
+				const std::uint32_t pixels[4] = { 0xFFFFFF00u, 0x00000000u, 0x80000012u, 0xFFFFFFFFu };
+				BFCDepthPyramid pyramid;
+				pyramid.buildFromDepthStencil(pixels, 2, 2, glm::mat4(1));
+				const auto &level = pyramid.getLevel(0);
+				AGE_TEST_CHECK(level.depths[0] == 1.0f);
+				AGE_TEST_CHECK(level.depths[1] == 0.0f);
+				AGE_TEST_CHECK(std::abs(level.depths[2] - 0.5f) < 0.0001f);
+				AGE_TEST_CHECK(level.depths[3] == 1.0f);
+			}
+
+			// empty pyramids never occlude
+			{
+				BFCDepthPyramid pyramid;
+				AGE_TEST_CHECK(pyramid.isValid() == false);
+				AGE_TEST_CHECK(pyramid.isOccluded(glm::vec2(0.0f), glm::vec2(1.0f), 0.5f) == false);
+				const float depth = 0.5f;
+				pyramid.build(&depth, 0, 0, glm::mat4(1));
+				AGE_TEST_CHECK(pyramid.isValid() == false);
+			}
+
+			// wall at 0.5 on the whole screen
+			{
+				const std::size_t size = 64;
+				std::vector<float> depths(size * size, 0.5f);
+				BFCDepthPyramid pyramid;
+				pyramid.build(depths.data(), size, size, glm::mat4(1));
+
+				const glm::vec2 min(0.25f);
+				const glm::vec2 max(0.75f);
+				AGE_TEST_CHECK(pyramid.isOccluded(min, max, 0.6f));
+				AGE_TEST_CHECK(pyramid.isOccluded(min, max, 0.4f) == false);
+				// same depth is visible
+				AGE_TEST_CHECK(pyramid.isOccluded(min, max, 0.5f) == false);
+				AGE_TEST_CHECK(pyramid.isOccluded(min, max, 0.0f) == false);
+				// rects are clamped to the screen
+				AGE_TEST_CHECK(pyramid.isOccluded(glm::vec2(-1.0f), glm::vec2(2.0f), 0.6f));
+
+				// a hole under the rect keeps it visible, even tested on a coarse level
+				depths[(size / 2) * size + size / 2] = 1.0f;
+				pyramid.build(depths.data(), size, size, glm::mat4(1));
+				AGE_TEST_CHECK(pyramid.isOccluded(min, max, 0.6f) == false);
+				// but not outside of it
+				AGE_TEST_CHECK(pyramid.isOccluded(glm::vec2(0.0f), glm::vec2(0.2f), 0.6f));
+				AGE_TEST_CHECK(pyramid.isOccluded(glm::vec2(0.8f), glm::vec2(1.0f), 0.6f));
+			}
+		}
+	}
+}
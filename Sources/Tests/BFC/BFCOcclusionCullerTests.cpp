@@ -0,0 +1,97 @@
+#include "Tests.hpp"
+
+#include <BFC/BFCOcclusionCuller.hpp>
+#include <BFC/BFCCullableObject.hpp>
+#include <BFC/BFCCullingOptions.hpp>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace AGE
+{
+	namespace Tests
+	{
+		namespace
+		{
+			// window depth of a point on the view axis
+			float WindowDepth(const glm::mat4 &viewProj, float z)
+			{
+				const glm::vec4 clip = viewProj * glm::vec4(0.0f, 0.0f, z, 1.0f);
+				return clip.z / clip.w * 0.5f + 0.5f;
+			}
+
+			BFCBlockBounds Bounds(const glm::vec3 &min, const glm::vec3 &max)
+			{
+				BFCBlockBounds bounds;
+				bounds.min = min;
+				bounds.max = max;
+				return bounds;
+			}
+
+			bool IsItemVisible(BFCOcclusionCuller &culler, BFCCullableObject &drawable, const glm::vec4 &sphere)
+			{
+				BFCItem item;
+				item.setDrawable(&drawable);
+				item.setPosition(sphere);
+				culler.reset();
+				culler.cullItem(item);
+				return culler.getArray().size() == 1;
+			}
+		}
+
+		void BFCOcclusionCullerTests()
+		{
+			// camera at the origin looking down -z, wall on the whole screen at z = -10
+			// at z = -20 the screen goes from -20 to 20
+			const glm::mat4 viewProj = glm::perspective(glm::radians(90.0f), 1.0f, 1.0f, 100.0f);
+			Frustum frustum;
+			frustum.setMatrix(viewProj);
+
+			const std::size_t size = 64;
+			std::vector<float> depths(size * size, WindowDepth(viewProj, -10.0f));
+			BFCDepthPyramid wall;
+			wall.build(depths.data(), size, size, viewProj);
+
+			// cullers embed their result arrays, too big for the stack
+			std::unique_ptr<BFCOcclusionCuller> culler(new BFCOcclusionCuller());
+
+			// block bounds
+			{
+				culler->prepareForCulling(frustum, &wall);
+				AGE_TEST_CHECK(culler->testBounds(Bounds(glm::vec3(-1, -1, -21), glm::vec3(1, 1, -19))) == BFCBoundsTest::Outside);
+				AGE_TEST_CHECK(culler->testBounds(Bounds(glm::vec3(-1, -1, -6), glm::vec3(1, 1, -4))) != BFCBoundsTest::Outside);
+				// crossing the wall
+				AGE_TEST_CHECK(culler->testBounds(Bounds(glm::vec3(-1, -1, -15), glm::vec3(1, 1, -5))) != BFCBoundsTest::Outside);
+				// the depth buffer knows nothing outside of the screen
+				AGE_TEST_CHECK(culler->testBounds(Bounds(glm::vec3(-100, -1, -21), glm::vec3(100, 1, -19))) != BFCBoundsTest::Outside);
+				// behind the camera
+				AGE_TEST_CHECK(culler->testBounds(Bounds(glm::vec3(-1, -1, 4), glm::vec3(1, 1, 6))) == BFCBoundsTest::Outside);
+
+				// without pyramid it is only frustum culling
+				culler->prepareForCulling(frustum, nullptr);
+				AGE_TEST_CHECK(culler->testBounds(Bounds(glm::vec3(-1, -1, -21), glm::vec3(1, 1, -19))) != BFCBoundsTest::Outside);
+			}
+
+			// items, with the scalar and the SIMD paths
+			BFCCullableObject drawable(CullableTypeID(0));
+			const bool simdWasEnabled = BFCCullingConfig::g_SIMD_is_enabled;
+			for (int simd = 0; simd < 2; ++simd)
+			{
+				BFCCullingConfig::g_SIMD_is_enabled = simd != 0;
+				culler->prepareForCulling(frustum, &wall);
+
+				AGE_TEST_CHECK(IsItemVisible(*culler, drawable, glm::vec4(0, 0, -20, 1)) == false);
+				AGE_TEST_CHECK(IsItemVisible(*culler, drawable, glm::vec4(0, 0, -5, 1)));
+				// the center is hidden but the bounds cross the wall
+				AGE_TEST_CHECK(IsItemVisible(*culler, drawable, glm::vec4(0, 0, -20, 12)));
+				// partly out of the screen
+				AGE_TEST_CHECK(IsItemVisible(*culler, drawable, glm::vec4(25, 0, -20, 6)));
+				// out of the frustum
+				AGE_TEST_CHECK(IsItemVisible(*culler, drawable, glm::vec4(0, 0, 10, 1)) == false);
+			}
+			BFCCullingConfig::g_SIMD_is_enabled = simdWasEnabled;
+		}
+	}
+}
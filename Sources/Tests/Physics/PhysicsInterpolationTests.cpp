@@ -0,0 +1,142 @@
+#include "Tests.hpp"
+
+#include <Physics/WorldInterface.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace AGE
+{
+	namespace Tests
+	{
+		namespace
+		{
+			// One body moving along x at 1 unit per second, the last step of an update
+			// only moves it when the results are fetched, like an asynchronous plugin
+			class MovingBodyWorld final : public Physics::WorldInterface
+			{
+			public:
+				MovingBodyWorld(void)
+					: WorldInterface(nullptr)
+				{
+					return;
+				}
+
+				~MovingBodyWorld(void) = default;
+
+				float position = 0.0f;
+
+				void setGravity(const glm::vec3 &) override final {}
+				glm::vec3 getGravity(void) const override final { return glm::vec3(0.0f); }
+				void enableCollisionBetweenGroups(Physics::FilterGroup, Physics::FilterGroup) override final {}
+				void disableCollisionBetweenGroups(Physics::FilterGroup, Physics::FilterGroup) override final {}
+				Physics::MaterialInterface *createMaterial(const std::string &) override final { return nullptr; }
+				void destroyMaterial(Physics::MaterialInterface *) override final {}
+				Physics::CharacterControllerInterface *createCharacterController() override final { return nullptr; }
+				void destroyCharacterController(Physics::CharacterControllerInterface *) override final {}
+				void fillDebugInformation(DebugDrawManager *) override final {}
+
+			private:
+				float pendingStep = 0.0f;
+
+				Physics::RaycasterInterface *createRaycaster(void) override final { return nullptr; }
+				Physics::RigidBodyInterface *createRigidBody(Physics::Private::GenericData *) override final { return nullptr; }
+				void destroyRigidBody(Physics::RigidBodyInterface *) override final {}
+				Physics::ColliderInterface *createCollider(Physics::ColliderType, const std::string &, Physics::Private::GenericData *) override final { return nullptr; }
+				void destroyCollider(Physics::ColliderInterface *) override final {}
+
+				void simulate(float stepSize) override final
+				{
+					position += stepSize;
+				}
+
+				void simulateAsync(float stepSize) override final
+				{
+					pendingStep = stepSize;
+				}
+
+				void fetchResults(void) override final
+				{
+					position += pendingStep;
+					pendingStep = 0.0f;
+				}
+			};
+
+			// Poses kept by the PhysicsSystem for the body
+			struct InterpolatedBody
+			{
+				float previous = 0.0f;
+				float current = 0.0f;
+				float lastStep = 0.0f;
+				bool hasLastStep = false;
+			};
+
+			void Fetch(MovingBodyWorld &world, InterpolatedBody &body)
+			{
+				const bool simulated = world.isSimulating();
+				world.endUpdate();
+				if (simulated)
+				{
+					body.previous = body.hasLastStep ? body.lastStep : body.current;
+					body.current = world.position;
+				}
+			}
+
+			// Same sequence as the PhysicsSystem, returns the position written in the link
+			float Frame(MovingBodyWorld &world, InterpolatedBody &body, float elapsedTime, bool async)
+			{
+				if (async)
+				{
+					Fetch(world, body);
+				}
+				world.beginUpdate(elapsedTime);
+				body.hasLastStep = world.getStepCount() > 1;
+				if (body.hasLastStep)
+				{
+					body.lastStep = world.position;
+				}
+				world.simulateLastStep();
+				if (!async)
+				{
+					Fetch(world, body);
+				}
+				return body.previous + (body.current - body.previous) * world.getInterpolationFactor();
+			}
+
+			void CheckMixedFrameRates(bool async)
+			{
+				// render faster and slower than the 60 Hz physics, with an empty frame
+				const float frameTimes[] = { 1.0f / 144.0f, 1.0f / 30.0f, 1.0f / 60.0f, 1.0f / 200.0f, 1.0f / 45.0f, 0.0f, 1.0f / 90.0f, 1.0f / 24.0f };
+				const std::size_t frameTimesNumber = sizeof(frameTimes) / sizeof(*frameTimes);
+				MovingBodyWorld world;
+				world.setTargetFPS(60);
+				world.enableFixedTimestep();
+				const float stepSize = 1.0f / 60.0f;
+				InterpolatedBody body;
+				float rendered = 0.0f;
+				double frameTime = 0.0;
+				double lastFrameTime = 0.0;
+				for (std::size_t frame = 0; frame < 400; ++frame)
+				{
+					const float elapsedTime = frameTimes[frame % frameTimesNumber];
+					lastFrameTime = frameTime;
+					frameTime += elapsedTime;
+					const float position = Frame(world, body, elapsedTime, async);
+					AGE_TEST_CHECK(position >= rendered);
+					// one step late, and one frame more when the step runs asynchronously
+					const double expected = std::max((async ? lastFrameTime : frameTime) - static_cast<double>(stepSize), 0.0);
+					AGE_TEST_CHECK(std::abs(static_cast<double>(position) - expected) < 1e-3);
+					// the gathered poses are the ones of the simulated time
+					AGE_TEST_CHECK(std::abs(static_cast<double>(body.current) - world.getSimulatedTime()) < 1e-3);
+					rendered = position;
+				}
+			}
+		}
+
+		void PhysicsInterpolationTests()
+		{
+			CheckMixedFrameRates(false);
+			CheckMixedFrameRates(true);
+		}
+	}
+}
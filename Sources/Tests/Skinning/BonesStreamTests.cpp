@@ -0,0 +1,98 @@
+#include "Tests.hpp"
+
+#include <Skinning/BonesStream.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace AGE
+{
+	namespace Tests
+	{
+		namespace
+		{
+			// one frame of the ring : the skinning writes the region, the render thread draws it
+			void SubmitAndDraw(BonesStream &stream, std::size_t region)
+			{
+				stream.submit(region);
+				stream.setInFlight(region);
+			}
+		}
+
+		void BonesStreamTests()
+		{
+			const std::size_t capacity = 16;
+			std::vector<BoneMatrix> memory(BonesStream::RegionNumber * capacity);
+			std::unique_ptr<BonesStream> stream(new BonesStream());
+			std::size_t region = 0;
+
+			// no memory yet
+			AGE_TEST_CHECK(stream->isReady() == false);
+			AGE_TEST_CHECK(stream->acquire(1, region) == nullptr);
+			AGE_TEST_CHECK(region == BonesStream::InvalidRegion);
+
+			stream->init(memory.data(), capacity);
+			AGE_TEST_CHECK(stream->isReady());
+			AGE_TEST_CHECK(stream->getRegionCapacity() == capacity);
+
+			// too big for a region
+			AGE_TEST_CHECK(stream->acquire(capacity + 1, region) == nullptr);
+			AGE_TEST_CHECK(region == BonesStream::InvalidRegion);
+
+			// Free -> Writing -> Submitted -> InFlight, the regions are used in order
+			std::size_t regions[BonesStream::RegionNumber];
+			for (std::size_t i = 0; i < BonesStream::RegionNumber; ++i)
+			{
+				BoneMatrix *bones = stream->acquire(capacity, regions[i]);
+				AGE_TEST_CHECK(regions[i] == i);
+				AGE_TEST_CHECK(bones == memory.data() + stream->getRegionOffset(i));
+				AGE_TEST_CHECK(stream->isInFlight(regions[i]) == false);
+				SubmitAndDraw(*stream, regions[i]);
+				AGE_TEST_CHECK(stream->isInFlight(regions[i]));
+			}
+
+			// the GPU uses every region
+			AGE_TEST_CHECK(stream->acquire(1, region) == nullptr);
+			AGE_TEST_CHECK(region == BonesStream::InvalidRegion);
+
+			// a region written but not submitted is not free either
+			stream->release(regions[0]);
+			AGE_TEST_CHECK(stream->isInFlight(regions[0]) == false);
+			AGE_TEST_CHECK(stream->acquire(1, region) == memory.data());
+			AGE_TEST_CHECK(region == 0);
+			AGE_TEST_CHECK(stream->acquire(1, region) == nullptr);
+			// nor one submitted but not drawn yet
+			stream->submit(0);
+			AGE_TEST_CHECK(stream->isInFlight(0) == false);
+			AGE_TEST_CHECK(stream->acquire(1, region) == nullptr);
+			stream->setInFlight(0);
+
+			// the next region is still in flight, acquire skips it
+			stream->release(regions[2]);
+			AGE_TEST_CHECK(stream->acquire(1, region) == memory.data() + stream->getRegionOffset(2));
+			AGE_TEST_CHECK(region == 2);
+			SubmitAndDraw(*stream, region);
+
+			stream->release(regions[1]);
+			AGE_TEST_CHECK(stream->acquire(1, region) == memory.data() + stream->getRegionOffset(1));
+			AGE_TEST_CHECK(region == 1);
+			SubmitAndDraw(*stream, region);
+
+			// the next one is the last region and it is in flight,
+			// acquire goes around the end of the ring to the one the GPU released
+			stream->release(regions[0]);
+			AGE_TEST_CHECK(stream->acquire(1, region) == memory.data());
+			AGE_TEST_CHECK(region == 0);
+			SubmitAndDraw(*stream, region);
+
+			// every region back to Free
+			for (std::size_t i = 0; i < BonesStream::RegionNumber; ++i)
+			{
+				stream->release(i);
+				AGE_TEST_CHECK(stream->isInFlight(i) == false);
+			}
+			AGE_TEST_CHECK(stream->acquire(capacity, region) == memory.data() + stream->getRegionOffset(1));
+			AGE_TEST_CHECK(region == 1);
+		}
+	}
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdio>
+
+// Minimal checks for the engine code which does not need a context
+// (no window, no GL). Each test group is a function called by main,
+// the program return the number of failed checks.
+
+namespace AGE
+{
+	namespace Tests
+	{
+		extern int g_failedChecks;
+
+		void BFCDepthPyramidTests();
+		void BFCOcclusionCullerTests();
+		void BonesStreamTests();
+		void PhysicsInterpolationTests();
+	}
+}
+
+#define AGE_TEST_CHECK(expression) \
+	do \
+	{ \
+		if (!(expression)) \
+		{ \
+			++AGE::Tests::g_failedChecks; \
+			std::printf("%s(%d) : check failed : %s\n", __FILE__, __LINE__, #expression); \
+		} \
+	} while (false)
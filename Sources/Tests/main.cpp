@@ -0,0 +1,14 @@
+#include "Tests.hpp"
+
+int AGE::Tests::g_failedChecks = 0;
+
+int main(int, char **)
+{
+	AGE::Tests::BFCDepthPyramidTests();
+	AGE::Tests::BFCOcclusionCullerTests();
+	AGE::Tests::BonesStreamTests();
+	AGE::Tests::PhysicsInterpolationTests();
+
+	std::printf("%d failed checks\n", AGE::Tests::g_failedChecks);
+	return AGE::Tests::g_failedChecks;
+}